@@ -0,0 +1,300 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::approximate_counts.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <seqan3/std/filesystem>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <robin_hood.h>
+
+#include "count_file.hpp"
+#include "hash_policy.hpp"
+
+namespace minions
+{
+
+/*!\brief Estimates the number of distinct hash values and the fraction of hash values occurring once in fixed memory.
+ *
+ * \details
+ *
+ * The hash values are mixed by a bijective function and the `sample_size` smallest mixed values are kept, i.e. a
+ * bottom-k sample, which is a uniform sample of the distinct hash values regardless of their counts. The k-th smallest
+ * value estimates the number of distinct hash values with a relative standard error of about `1 / sqrt(k - 2)`.
+ *
+ * A hash value, that is in the sample at the end, has been in the sample since its first occurrence, because the
+ * largest sampled value only decreases. Therefore the counts of the sampled hash values are exact and the fraction of
+ * sampled hash values with a count of 1 estimates the fraction of unique hash values with the standard error of a
+ * binomial proportion. Counts saturate at `max_count`, like the counts stored by `minions counts`.
+ *
+ * With fewer than `sample_size` distinct hash values, all of them are kept and the results are exact.
+ */
+class approximate_counts
+{
+public:
+    //!\brief The largest stored count.
+    static constexpr uint16_t max_count{65534u};
+    //!\brief The default number of sampled hash values.
+    static constexpr size_t default_sample_size{1ULL << 16};
+
+    //!\brief The header of a sample file.
+    struct file_header
+    {
+        //!\brief The magic bytes, that identify a sample file.
+        static constexpr std::array<char, 8> magic_bytes{'M', 'I', 'N', 'I', 'O', 'N', 'S', 'S'};
+        //!\brief The version written by write().
+        static constexpr uint32_t current_version{1};
+
+        std::array<char, 8> magic{magic_bytes};   //!< Identifies the file.
+        uint32_t version{current_version};        //!< The format version.
+        uint32_t header_size{80};                 //!< The size of the header in bytes.
+        count_file_parameters parameters{};       //!< The method parameters.
+        uint64_t sample_size{};                   //!< The maximal number of sampled hash values.
+        uint64_t record_count{};                  //!< The number of sampled hash values.
+        uint64_t total{};                         //!< The number of added hash values.
+    };
+
+    static_assert(sizeof(file_header) == 80);
+    static_assert(std::is_trivially_copyable_v<file_header>);
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    approximate_counts() : approximate_counts{default_sample_size} {} //!< Uses `default_sample_size`.
+    approximate_counts(approximate_counts const &) = default; //!< Defaulted.
+    approximate_counts(approximate_counts &&) = default; //!< Defaulted.
+    approximate_counts & operator=(approximate_counts const &) = default; //!< Defaulted.
+    approximate_counts & operator=(approximate_counts &&) = default; //!< Defaulted.
+    ~approximate_counts() = default; //!< Defaulted.
+
+    /*!\brief Construct with a given sample size.
+     * \param[in] sample_size The maximal number of sampled hash values, at least 3.
+     */
+    explicit approximate_counts(size_t const sample_size) : maximal_size{std::max<size_t>(3u, sample_size)}
+    {}
+    //!\}
+
+    /*!\brief Counts one occurrence of a hash value.
+     * \param[in] hash The hash value.
+     */
+    void add(uint64_t const hash)
+    {
+        ++total;
+        insert(mix(hash), 1u);
+    }
+
+    /*!\brief Adds the hash values of another sample, which must have the same sample size.
+     * \param[in] other The other sample.
+     *
+     * \details
+     *
+     * The result is the same as if all hash values had been added to this sample.
+     */
+    void merge(approximate_counts const & other)
+    {
+        total += other.total;
+        for (auto && [value, count] : other.sample)
+            insert(value, count);
+    }
+
+    /*!\brief Skips all hash values, whose mixed value is larger than the one of `other`.
+     * \param[in] other A sample, that this sample is merged into later.
+     *
+     * \details
+     *
+     * These hash values cannot be part of the merged sample, skipping them saves inserting them into the sample first.
+     */
+    void skip_larger(approximate_counts const & other) noexcept
+    {
+        bound = std::min(bound, other.threshold());
+    }
+
+    //!\brief Returns the maximal number of sampled hash values.
+    size_t sample_size() const noexcept
+    {
+        return maximal_size;
+    }
+
+    //!\brief Returns the number of added hash values.
+    uint64_t size() const noexcept
+    {
+        return total;
+    }
+
+    //!\brief Whether the estimates are exact, because less than sample_size() distinct hash values were added.
+    bool is_exact() const noexcept
+    {
+        return sample.size() < maximal_size;
+    }
+
+    //!\brief Returns the estimated number of distinct hash values.
+    uint64_t distinct() const noexcept
+    {
+        if (is_exact())
+            return sample.size();
+        // The k-th smallest of the values normalised to (0, 1].
+        double const kth_smallest = (static_cast<double>(largest.top()) + 1.0) / 18446744073709551616.0;
+        return std::llround((maximal_size - 1) / kth_smallest);
+    }
+
+    //!\brief Returns the relative standard error of distinct().
+    double distinct_error() const noexcept
+    {
+        return is_exact() ? 0.0 : 1.0 / std::sqrt(maximal_size - 2.0);
+    }
+
+    //!\brief Returns the estimated fraction of distinct hash values, that occur once.
+    double unique_fraction() const noexcept
+    {
+        if (sample.empty())
+            return 0.0;
+        size_t const singletons = std::ranges::count_if(sample, [] (auto const & entry) { return entry.second == 1u; });
+        return static_cast<double>(singletons) / sample.size();
+    }
+
+    //!\brief Returns the standard error of unique_fraction().
+    double unique_fraction_error() const noexcept
+    {
+        if (is_exact())
+            return 0.0;
+        double const fraction = unique_fraction();
+        return std::sqrt(fraction * (1.0 - fraction) / sample.size());
+    }
+
+    /*!\brief Stores the sample as a sample file.
+     * \param[in] path       The output file.
+     * \param[in] parameters The method parameters.
+     * \throws std::runtime_error if the file cannot be written.
+     */
+    void write(std::filesystem::path const & path, count_file_parameters const & parameters) const
+    {
+        std::vector<std::pair<uint64_t, uint16_t>> records(sample.begin(), sample.end());
+        std::ranges::sort(records);
+        std::vector<uint64_t> values(records.size());
+        std::vector<uint16_t> counts(records.size());
+        for (size_t i = 0; i < records.size(); ++i)
+            std::tie(values[i], counts[i]) = records[i];
+
+        file_header header{};
+        header.parameters = parameters;
+        header.sample_size = maximal_size;
+        header.record_count = records.size();
+        header.total = total;
+
+        std::ofstream outfile{path, std::ios::binary};
+        outfile.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        outfile.write(reinterpret_cast<char const *>(values.data()), values.size() * sizeof(uint64_t));
+        outfile.write(reinterpret_cast<char const *>(counts.data()), counts.size() * sizeof(uint16_t));
+        if (!outfile)
+            throw std::runtime_error{"Could not write the sample file " + path.string() + "."};
+    }
+
+    /*!\brief Reads a sample file.
+     * \param[in] path The sample file.
+     * \returns The sample and the method parameters.
+     * \throws std::runtime_error if the file cannot be opened.
+     * \throws std::invalid_argument if the file is not a sample file.
+     */
+    static std::pair<approximate_counts, count_file_parameters> read(std::filesystem::path const & path)
+    {
+        std::ifstream infile{path, std::ios::binary};
+        if (!infile)
+            throw std::runtime_error{"Could not open the sample file " + path.string() + "."};
+
+        file_header header{};
+        infile.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!infile || header.magic != file_header::magic_bytes)
+            throw std::invalid_argument{"The file " + path.string() + " is not a sample file."};
+        if (header.version != file_header::current_version || header.header_size != sizeof(file_header))
+            throw std::invalid_argument{"The sample file " + path.string() + " has the unsupported version " +
+                                        std::to_string(header.version) + "."};
+        if (header.record_count > header.sample_size)
+            throw std::invalid_argument{"The sample file " + path.string() + " is corrupted."};
+
+        std::vector<uint64_t> values(header.record_count);
+        std::vector<uint16_t> counts(header.record_count);
+        infile.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(uint64_t));
+        infile.read(reinterpret_cast<char *>(counts.data()), counts.size() * sizeof(uint16_t));
+        if (!infile)
+            throw std::invalid_argument{"The sample file " + path.string() + " is truncated."};
+
+        approximate_counts result{header.sample_size};
+        for (size_t i = 0; i < values.size(); ++i)
+            result.insert(values[i], counts[i]);
+        result.total = header.total;
+        return {std::move(result), header.parameters};
+    }
+
+    //!\brief Whether a file starts with the magic bytes of a sample file.
+    static bool is_sample_file(std::filesystem::path const & path)
+    {
+        std::array<char, 8> magic{};
+        std::ifstream infile{path, std::ios::binary};
+        infile.read(magic.data(), magic.size());
+        return infile && magic == file_header::magic_bytes;
+    }
+
+private:
+    //!\brief The maximal number of sampled hash values.
+    size_t maximal_size{};
+    //!\brief The number of added hash values.
+    uint64_t total{0};
+    //!\brief The counts of the sampled mixed values.
+    robin_hood::unordered_flat_map<uint64_t, uint16_t> sample{};
+    //!\brief The sampled mixed values, the largest on top.
+    std::priority_queue<uint64_t> largest{};
+    //!\brief Mixed values larger than this are skipped, see skip_larger().
+    uint64_t bound{std::numeric_limits<uint64_t>::max()};
+
+    //!\brief Returns the largest mixed value, that may still be sampled.
+    uint64_t threshold() const noexcept
+    {
+        return is_exact() ? bound : std::min(bound, largest.top());
+    }
+
+    //!\brief Mixes a hash value with a bijective function, k-mer hashes are not uniformly distributed.
+    static uint64_t mix(uint64_t const hash) noexcept
+    {
+        return murmur_hash_policy{}(hash, 0u);
+    }
+
+    //!\brief Adds occurrences of a mixed value, if it belongs to the sample.
+    void insert(uint64_t const value, uint16_t const count)
+    {
+        if (value > threshold())
+            return;
+
+        auto [it, inserted] = sample.try_emplace(value, uint16_t{0});
+        it->second = std::min<uint32_t>(max_count, uint32_t{it->second} + count);
+        if (!inserted)
+            return;
+
+        largest.push(value);
+        if (sample.size() > maximal_size)
+        {
+            sample.erase(largest.top());
+            largest.pop();
+        }
+    }
+};
+
+} // namespace minions
@@ -0,0 +1,723 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides the batch functions, which write the hashes of a whole sequence into a minions::batch_buffer.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <seqan3/alphabet/concept.hpp>
+#include <seqan3/search/kmer_index/shape.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+
+#include "batch_kernels.hpp"
+#include "canonical_strobemer.hpp"
+#include "hash_policy.hpp"
+#include "window_minimum.hpp"
+
+namespace minions
+{
+
+/*!\brief The output of the batch functions, reused between calls to avoid allocations.
+ *
+ * \details
+ *
+ * The batch functions append to hashes and, if store_positions is set, the position of every hash to positions.
+ * A position is the position of the first base of the k-mer within the sequence, for strobemers the one of the first
+ * strobe. The remaining members are scratch memory of the batch functions.
+ */
+struct batch_buffer
+{
+    //!\brief The hash values.
+    std::vector<uint64_t> hashes{};
+    //!\brief The positions of the hash values, only filled if store_positions is set.
+    std::vector<size_t> positions{};
+    //!\brief Whether positions are stored.
+    bool store_positions{false};
+
+    //!\brief The ranks of the current sequence, if it is not given as ranks.
+    std::vector<uint8_t> ranks{};
+    //!\brief The k-mer hashes of the forward strand.
+    std::vector<uint64_t> forward{};
+    //!\brief The k-mer hashes of the reverse complement strand, in the order of the forward strand.
+    std::vector<uint64_t> reverse{};
+    //!\brief The s-mer hashes of the forward strand, used by syncmers.
+    std::vector<uint64_t> forward_smers{};
+    //!\brief The s-mer hashes of the reverse complement strand, used by syncmers.
+    std::vector<uint64_t> reverse_smers{};
+
+    //!\brief Removes all hashes and positions, the capacity is kept.
+    void clear() noexcept
+    {
+        hashes.clear();
+        positions.clear();
+    }
+
+    //!\brief Appends a hash and its position.
+    void emit(uint64_t const hash, size_t const position)
+    {
+        hashes.push_back(hash);
+        if (store_positions)
+            positions.push_back(position);
+    }
+
+    //!\brief Reserves memory for additional hashes and positions.
+    void reserve_additional(size_t const count)
+    {
+        hashes.reserve(hashes.size() + count);
+        if (store_positions)
+            positions.reserve(positions.size() + count);
+    }
+};
+
+/*!\brief A sequence the batch functions accept.
+ *
+ * \details
+ *
+ * Either a contiguous range of ranks in [0, 3], e.g. a `std::span<uint8_t const>`, or a sized range over a
+ * seqan3::semialphabet of size 4, e.g. a `std::span<seqan3::dna4 const>` or a seqan3::bitpacked_sequence.
+ */
+template <typename sequence_t>
+concept batch_sequence = std::ranges::forward_range<sequence_t> && std::ranges::sized_range<sequence_t> &&
+                         ((std::ranges::contiguous_range<sequence_t> &&
+                           std::same_as<std::ranges::range_value_t<sequence_t>, uint8_t>) ||
+                          (seqan3::semialphabet<std::ranges::range_reference_t<sequence_t>> &&
+                           seqan3::alphabet_size<std::ranges::range_value_t<sequence_t>> == 4));
+
+/*!\brief The k-mer sizes, for which the batch functions hash ungapped k-mers with a kernel, that has the k-mer size as
+ *        compile-time constant. Other k-mer sizes use the generic kernel, which computes the same values.
+ */
+inline constexpr std::array<size_t, 4> specialised_kmer_sizes{15, 19, 21, 31};
+
+/*!\brief minions::minimiser_batch uses a kernel with the number of k-mers per window as compile-time constant, if it is
+ *        at most this number, i.e. for window sizes up to k + 50. Larger windows use the generic kernel.
+ */
+inline constexpr size_t specialised_window_values{51};
+
+namespace detail
+{
+
+/*!\brief Calls `kernel(std::integral_constant<size_t, candidate>{})` for the candidate equal to `value`.
+ * \tparam candidates The values, for which the kernel is instantiated.
+ * \returns Whether `value` is a candidate, i.e. whether the kernel was called.
+ */
+template <auto const & candidates, typename kernel_t>
+bool dispatch_constant(size_t const value, kernel_t && kernel)
+{
+    return [&] <size_t ... indices> (std::index_sequence<indices...>)
+    {
+        return ((value == candidates[indices] &&
+                 (kernel(std::integral_constant<size_t, candidates[indices]>{}), true)) || ...);
+    }(std::make_index_sequence<candidates.size()>{});
+}
+
+//!\brief The numbers of k-mers per window, for which minions::minimiser_batch has a specialised kernel.
+inline constexpr std::array<size_t, specialised_window_values> specialised_window_sizes = [] ()
+{
+    std::array<size_t, specialised_window_values> sizes{};
+    for (size_t i = 0; i < sizes.size(); ++i)
+        sizes[i] = i + 1;
+    return sizes;
+}();
+
+//!\brief Returns the ranks of the sequence, converting them into scratch if the sequence does not consist of ranks.
+template <batch_sequence sequence_t>
+std::span<uint8_t const> batch_ranks(sequence_t const & sequence, std::vector<uint8_t> & scratch)
+{
+    if constexpr (std::ranges::contiguous_range<sequence_t> &&
+                  std::same_as<std::ranges::range_value_t<sequence_t>, uint8_t>)
+    {
+        return {std::ranges::data(sequence), std::ranges::size(sequence)};
+    }
+    else
+    {
+        scratch.resize(std::ranges::size(sequence));
+        std::ranges::transform(sequence, scratch.begin(), [] (auto const symbol)
+        {
+            return static_cast<uint8_t>(seqan3::to_rank(symbol));
+        });
+        return scratch;
+    }
+}
+
+/*!\brief Computes the hashes of ungapped k-mers with a rolling hash, see minions::detail::batch_kmer_hashes.
+ * \tparam with_reverse Whether the hashes of the reverse complement k-mers are computed as well.
+ * \param[in]  ranks            The ranks of the sequence, at least one k-mer.
+ * \param[in]  kmer_size_value  The k-mer size, either a `size_t` or a `std::integral_constant`, in which case the
+ *                              mask, the shifts and the loop bounds are compile-time constants.
+ * \param[out] forward          The hashes of the k-mers, must already have the right size.
+ * \param[out] reverse          The hashes of the reverse complement k-mers, must already have the right size.
+ */
+template <bool with_reverse, typename kmer_size_t>
+void batch_ungapped_hashes(std::span<uint8_t const> const ranks,
+                           kmer_size_t const kmer_size_value,
+                           std::vector<uint64_t> & forward,
+                           std::vector<uint64_t> & reverse)
+{
+    size_t const kmer_size = kmer_size_value;
+    size_t const kmers = forward.size();
+    uint64_t const mask = kmer_size >= 32 ? ~0ULL : (1ULL << (2 * kmer_size)) - 1;
+    uint64_t const highest = 2 * (kmer_size - 1);
+    uint64_t forward_value{0};
+    uint64_t reverse_value{0};
+    for (size_t i = 0; i + 1 < kmer_size; ++i)
+    {
+        forward_value = (forward_value << 2) | ranks[i];
+        reverse_value = (reverse_value >> 2) | (static_cast<uint64_t>(3 - ranks[i]) << highest);
+    }
+
+    for (size_t i = 0; i < kmers; ++i)
+    {
+        uint8_t const rank = ranks[i + kmer_size - 1];
+        forward_value = ((forward_value << 2) | rank) & mask;
+        forward[i] = forward_value;
+        if constexpr (with_reverse)
+        {
+            reverse_value = (reverse_value >> 2) | (static_cast<uint64_t>(3 - rank) << highest);
+            reverse[i] = reverse_value;
+        }
+    }
+}
+
+/*!\brief Computes the k-mer hashes like seqan3::views::kmer_hash.
+ * \tparam with_reverse Whether the hashes of the reverse complement k-mers are computed as well.
+ * \param[in]  ranks   The ranks of the sequence.
+ * \param[in]  shape   The shape.
+ * \param[out] forward The hashes of the k-mers.
+ * \param[out] reverse The hashes of the reverse complement k-mers, in the order of the forward strand, i.e. the same
+ *                     values `urange | complement | reverse | kmer_hash(shape) | reverse` has.
+ * \details
+ * Ungapped shapes use a rolling hash, with a specialised kernel for minions::specialised_kmer_sizes. Gapped shapes add
+ * up the bases of every k-mer.
+ */
+template <bool with_reverse>
+void batch_kmer_hashes(std::span<uint8_t const> const ranks,
+                       seqan3::shape const & shape,
+                       std::vector<uint64_t> & forward,
+                       std::vector<uint64_t> & reverse)
+{
+    size_t const kmer_size = shape.size();
+    size_t const kmers = ranks.size() >= kmer_size ? ranks.size() - kmer_size + 1 : 0;
+    forward.resize(kmers);
+    if constexpr (with_reverse)
+        reverse.resize(kmers);
+
+    if (kmers == 0)
+        return;
+
+    if (shape.count() == kmer_size)
+    {
+        bool const specialised = dispatch_constant<specialised_kmer_sizes>(kmer_size, [&] (auto const constant_size)
+        {
+            batch_ungapped_hashes<with_reverse>(ranks, constant_size, forward, reverse);
+        });
+        if (!specialised)
+            batch_ungapped_hashes<with_reverse>(ranks, kmer_size, forward, reverse);
+        return;
+    }
+
+    // The positions of the shape that are used, the reverse complement k-mer reads the bases backwards.
+    std::array<uint8_t, 64> used{};
+    size_t used_count{0};
+    for (size_t i = 0; i < kmer_size; ++i)
+        if (shape[i])
+            used[used_count++] = i;
+
+    for (size_t i = 0; i < kmers; ++i)
+    {
+        uint64_t forward_value{0};
+        uint64_t reverse_value{0};
+        for (size_t j = 0; j < used_count; ++j)
+        {
+            forward_value = (forward_value << 2) | ranks[i + used[j]];
+            if constexpr (with_reverse)
+                reverse_value = (reverse_value << 2) | (3 - ranks[i + kmer_size - 1 - used[j]]);
+        }
+        forward[i] = forward_value;
+        if constexpr (with_reverse)
+            reverse[i] = reverse_value;
+    }
+}
+
+/*!\brief Stores the values with the hash policy and the seed applied in out, with the SIMD kernel for
+ *        minions::xor_hash_policy. The values may be out itself.
+ */
+template <hash_policy hash_policy_t>
+void batch_apply_policy(std::span<uint64_t const> const values,
+                        std::vector<uint64_t> & out,
+                        uint64_t const seed,
+                        hash_policy_t const hash_policy)
+{
+    if (values.data() != out.data())
+        out.assign(values.begin(), values.end());
+
+    if constexpr (std::same_as<hash_policy_t, xor_hash_policy>)
+        xor_seed(out.data(), out.size(), seed);
+    else
+        std::ranges::transform(out, out.begin(), [seed, hash_policy] (uint64_t const value)
+        {
+            return hash_policy(value, seed);
+        });
+}
+
+/*!\brief Stores the smaller of the forward and reverse value with the policy applied in out. The forward values may
+ *        be out itself.
+ */
+template <hash_policy hash_policy_t>
+void batch_canonical(std::span<uint64_t const> const forward,
+                     std::span<uint64_t const> const reverse,
+                     std::vector<uint64_t> & out,
+                     uint64_t const seed,
+                     hash_policy_t const hash_policy)
+{
+    out.resize(forward.size());
+    if constexpr (std::same_as<hash_policy_t, xor_hash_policy>)
+        canonical_min(forward.data(), reverse.data(), out.data(), forward.size(), seed);
+    else
+        for (size_t i = 0; i < forward.size(); ++i)
+            out[i] = std::min(hash_policy(forward[i], seed), hash_policy(reverse[i], seed));
+}
+
+/*!\brief Appends the minimisers of the values.
+ * \param[in]     values            The canonical k-mer hashes, at least as many as one window.
+ * \param[in]     values_per_window The number of values in one window.
+ * \param[in,out] buffer            The buffer the minimisers are appended to.
+ */
+inline void batch_minimisers(std::span<uint64_t const> const values, size_t const values_per_window, batch_buffer & buffer)
+{
+    // The same steps as minions::detail::minimiser_view.
+    window_minimum<uint64_t> window{values_per_window};
+    for (size_t i = 0; i < values_per_window; ++i)
+        window.push(values[i]);
+
+    uint64_t minimiser_value = window.min();
+    size_t minimiser_position = window.min_position();
+    buffer.reserve_additional(values.size() - values_per_window + 1);
+    buffer.emit(minimiser_value, minimiser_position);
+
+    for (size_t i = values_per_window; i < values.size(); ++i)
+    {
+        window.push(values[i]);
+        if (minimiser_position + values_per_window < window.pushed_values())
+        {
+            minimiser_value = window.min();
+            minimiser_position = window.min_position();
+            buffer.emit(minimiser_value, minimiser_position);
+        }
+        else if (values[i] < minimiser_value)
+        {
+            minimiser_value = values[i];
+            minimiser_position = i;
+            buffer.emit(minimiser_value, minimiser_position);
+        }
+    }
+}
+
+/*!\brief Appends the minimisers of the values, for a number of values per window known at compile time.
+ * \details
+ * The same values as the generic kernel. Instead of a monotone queue, whose branches are hard to predict, the window
+ * is rescanned without branches when the minimiser leaves it. For random values, this happens about every
+ * `values_per_window / 2` values, in the worst case for every value, which is bounded by
+ * minions::specialised_window_values.
+ */
+template <size_t values_per_window>
+void batch_minimisers(std::span<uint64_t const> const values,
+                      std::integral_constant<size_t, values_per_window>,
+                      batch_buffer & buffer)
+{
+    // The position of the rightmost minimum of the window starting at begin.
+    auto rightmost_minimum = [values] (size_t const begin)
+    {
+        size_t position = begin;
+        uint64_t minimum = values[begin];
+        for (size_t j = begin + 1; j < begin + values_per_window; ++j)
+        {
+            bool const smaller_or_equal = values[j] <= minimum;
+            minimum = smaller_or_equal ? values[j] : minimum;
+            position = smaller_or_equal ? j : position;
+        }
+        return position;
+    };
+
+    size_t minimiser_position = rightmost_minimum(0);
+    uint64_t minimiser_value = values[minimiser_position];
+    buffer.reserve_additional(values.size() - values_per_window + 1);
+    buffer.emit(minimiser_value, minimiser_position);
+
+    for (size_t i = values_per_window; i < values.size(); ++i)
+    {
+        if (minimiser_position + values_per_window <= i)
+        {
+            minimiser_position = rightmost_minimum(i + 1 - values_per_window);
+            minimiser_value = values[minimiser_position];
+            buffer.emit(minimiser_value, minimiser_position);
+        }
+        else if (values[i] < minimiser_value)
+        {
+            minimiser_value = values[i];
+            minimiser_position = i;
+            buffer.emit(minimiser_value, minimiser_position);
+        }
+    }
+}
+
+/*!\brief Appends the k-mer hashes, see minions::kmer_batch.
+ * \param[in]     forward The k-mer hashes, see minions::detail::batch_kmer_hashes.
+ * \param[in,out] buffer  The buffer the hashes are appended to.
+ */
+inline void select_kmers(std::span<uint64_t const> const forward, batch_buffer & buffer)
+{
+    buffer.hashes.insert(buffer.hashes.end(), forward.begin(), forward.end());
+    if (buffer.store_positions)
+        for (size_t i = 0; i < forward.size(); ++i)
+            buffer.positions.push_back(i);
+}
+
+/*!\brief Appends the minimisers of the k-mer hashes, see minions::minimiser_batch.
+ * \param[in]     forward     The k-mer hashes, see minions::detail::batch_kmer_hashes. May be `buffer.forward`.
+ * \param[in]     reverse     The reverse complement k-mer hashes.
+ * \param[in]     kmer_size   The size of the shape.
+ * \param[in]     window_size The window size to use, not smaller than the size of the shape.
+ * \param[in]     seed        The seed to use.
+ * \param[in,out] buffer      The buffer the minimisers are appended to.
+ * \param[in]     hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+ */
+template <hash_policy hash_policy_t>
+void select_minimisers(std::span<uint64_t const> const forward,
+                       std::span<uint64_t const> const reverse,
+                       size_t const kmer_size,
+                       seqan3::window_size const window_size,
+                       seqan3::seed const seed,
+                       batch_buffer & buffer,
+                       hash_policy_t const hash_policy)
+{
+    batch_canonical(forward, reverse, buffer.forward, seed.get(), hash_policy);
+
+    std::span<uint64_t const> const values{buffer.forward};
+    if (values.empty())
+        return;
+
+    // A range shorter than a window is one window.
+    size_t const values_per_window = std::min<size_t>(window_size.get() - kmer_size + 1, values.size());
+    bool const specialised = dispatch_constant<specialised_window_sizes>(values_per_window,
+                                                                         [&] (auto const constant_size)
+    {
+        batch_minimisers(values, constant_size, buffer);
+    });
+    if (!specialised)
+        batch_minimisers(values, values_per_window, buffer);
+}
+
+/*!\brief Appends the modmers of the k-mer hashes, see minions::modmer_batch.
+ * \param[in]     forward     The k-mer hashes, see minions::detail::batch_kmer_hashes. May be `buffer.forward`.
+ * \param[in]     reverse     The reverse complement k-mer hashes.
+ * \param[in]     mod_used    The mod value to use.
+ * \param[in]     seed        The seed to use.
+ * \param[in,out] buffer      The buffer the modmers are appended to.
+ * \param[in]     hash_policy The minions::hash_policy, whose value decides if a k-mer is a modmer.
+ */
+template <hash_policy hash_policy_t>
+void select_modmers(std::span<uint64_t const> const forward,
+                    std::span<uint64_t const> const reverse,
+                    uint32_t const mod_used,
+                    seqan3::seed const seed,
+                    batch_buffer & buffer,
+                    hash_policy_t const hash_policy)
+{
+    // The modmer is the canonical k-mer hash without seed, the seed only goes into the selection.
+    batch_canonical(forward, reverse, buffer.forward, 0, xor_hash_policy{});
+
+    for (size_t i = 0; i < buffer.forward.size(); ++i)
+        if (hash_policy(buffer.forward[i], seed.get()) % mod_used == 0)
+            buffer.emit(buffer.forward[i], i);
+}
+
+/*!\brief Appends the syncmers of the k-mer and s-mer hashes, see minions::syncmer_batch.
+ * \param[in]     forward         The k-mer hashes, see minions::detail::batch_kmer_hashes. May be `buffer.forward`.
+ * \param[in]     reverse         The reverse complement k-mer hashes. May be `buffer.reverse`.
+ * \param[in]     forward_smers   The s-mer hashes. May be `buffer.forward_smers`.
+ * \param[in]     reverse_smers   The reverse complement s-mer hashes. May be `buffer.reverse_smers`.
+ * \param[in]     positions       The positions of the smallest s-mer, that make a k-mer a syncmer.
+ * \param[in]     seed            The seed to use.
+ * \param[in,out] buffer          The buffer the syncmers are appended to.
+ * \param[in]     hash_policy     The minions::hash_policy that transforms every k-mer and s-mer hash with the seed.
+ * \throws std::invalid_argument if there are no k-mers.
+ */
+template <hash_policy hash_policy_t>
+void select_syncmers(std::span<uint64_t const> const forward,
+                     std::span<uint64_t const> const reverse,
+                     std::span<uint64_t const> const forward_smers,
+                     std::span<uint64_t const> const reverse_smers,
+                     std::vector<int> const & positions,
+                     seqan3::seed const seed,
+                     batch_buffer & buffer,
+                     hash_policy_t const hash_policy)
+{
+    batch_apply_policy(forward, buffer.forward, seed.get(), hash_policy);
+    batch_apply_policy(reverse, buffer.reverse, seed.get(), hash_policy);
+    batch_apply_policy(forward_smers, buffer.forward_smers, seed.get(), hash_policy);
+    batch_apply_policy(reverse_smers, buffer.reverse_smers, seed.get(), hash_policy);
+
+    if (buffer.forward.empty())
+        throw std::invalid_argument{"The given sequence is too short to satisfy the given window_size.\n"
+                                    "Please choose a smaller window_size."};
+    // Every k-mer consists of as many s-mers as there are s-mers more than k-mers, plus one.
+    size_t const window_size = buffer.forward_smers.size() - buffer.forward.size() + 1;
+
+    uint64_t position_mask{0};
+    for (int position : positions)
+        if (position >= 0 && position < 64)
+            position_mask |= 1ULL << position;
+    auto is_syncmer = [position_mask] (size_t const offset) { return (position_mask >> offset) & 1ULL; };
+
+    std::span<uint64_t const> const smers{buffer.forward_smers};
+    std::span<uint64_t const> const reverse_smer_values{buffer.reverse_smers};
+
+    // The same steps as seqan3::detail::syncmer_view. The offset of the forward strand is the position of the first
+    // smallest s-mer in the window, the one of the reverse strand is counted from the end of the window.
+    auto first_forward = [&] (size_t const begin)
+    {
+        std::span<uint64_t const> const window = smers.subspan(begin, window_size);
+        return static_cast<size_t>(std::ranges::min_element(window) - window.begin());
+    };
+    auto first_reverse = [&] (size_t const begin)
+    {
+        size_t offset{0};
+        for (size_t j = 1; j < window_size; ++j)
+            if (reverse_smer_values[begin + window_size - 1 - j] < reverse_smer_values[begin + window_size - 1 - offset])
+                offset = j;
+        return offset;
+    };
+
+    size_t offset = first_forward(0);
+    size_t reverse_offset = first_reverse(0);
+    buffer.reserve_additional(buffer.forward.size());
+
+    if (buffer.forward[0] < buffer.reverse[0])
+    {
+        if (is_syncmer(offset))
+            buffer.emit(buffer.forward[0], 0);
+    }
+    else if (is_syncmer(reverse_offset))
+    {
+        buffer.emit(buffer.reverse[0], 0);
+    }
+
+    for (size_t i = 1; i < buffer.forward.size(); ++i)
+    {
+        uint64_t const new_value = smers[i + window_size - 1];
+        if (offset == 0)
+            offset = first_forward(i);
+        else if (new_value < smers[i + --offset])
+            offset = window_size - 1;
+
+        uint64_t const new_reverse_value = reverse_smer_values[i + window_size - 1];
+        if (++reverse_offset >= window_size)
+            reverse_offset = first_reverse(i);
+        else if (new_reverse_value <= reverse_smer_values[i + window_size - 1 - reverse_offset])
+            reverse_offset = 0;
+
+        // Unlike the first window, equal hashes use the forward strand.
+        if (buffer.forward[i] > buffer.reverse[i])
+        {
+            if (is_syncmer(reverse_offset))
+                buffer.emit(buffer.reverse[i], i);
+        }
+        else if (is_syncmer(offset))
+        {
+            buffer.emit(buffer.forward[i], i);
+        }
+    }
+}
+
+/*!\brief Appends the strobemers of the k-mer hashes, see minions::strobemer_batch.
+ * \tparam method The minions::strobemer_method.
+ * \tparam order  The number of strobes, 2 or 3.
+ * \param[in]     forward     The k-mer hashes, see minions::detail::batch_kmer_hashes. May be `buffer.forward`.
+ * \param[in]     reverse     The reverse complement k-mer hashes. May be `buffer.reverse`.
+ * \param[in]     shape       The seqan3::shape the hashes were computed with.
+ * \param[in]     window_min  The minimal offset for the position of the next strobes.
+ * \param[in]     window_len  The maximal offset for the position of the next strobes, not smaller than window_min.
+ * \param[in]     seed        The seed to use.
+ * \param[in,out] buffer      The buffer the strobemers are appended to.
+ * \param[in]     hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+ * \throws std::invalid_argument if the window is not valid for the method or there are not more k-mers than one window.
+ */
+template <strobemer_method method, uint16_t order, hash_policy hash_policy_t>
+void select_strobemers(std::span<uint64_t const> const forward,
+                       std::span<uint64_t const> const reverse,
+                       seqan3::shape const & shape,
+                       uint32_t const window_min,
+                       uint32_t const window_len,
+                       seqan3::seed const seed,
+                       batch_buffer & buffer,
+                       hash_policy_t const hash_policy)
+{
+    batch_apply_policy(forward, buffer.forward, seed.get(), hash_policy);
+    batch_apply_policy(reverse, buffer.reverse, seed.get(), hash_policy);
+
+    size_t const window_size = window_len - shape.size() + 1;
+    if (buffer.forward.size() <= window_size)
+        throw std::invalid_argument{"The given range is too short to satisfy the given parameters.\n"
+                                    "Please choose a smaller window size or pick a longer underlying range."};
+
+    canonical_strobemer_window<method, order> window{window_min + shape.size() - 1u, window_size, shape.count()};
+    if (buffer.forward.size() >= window.span())
+        buffer.reserve_additional(buffer.forward.size() - window.span() + 1);
+
+    for (size_t i = 0; i < buffer.forward.size(); ++i)
+    {
+        window.push(buffer.forward[i], buffer.reverse[i]);
+        if (window.full())
+            buffer.emit(window.value(), i + 1 - window.span());
+    }
+}
+
+} // namespace detail
+
+/*!\brief Appends the k-mer hashes of the sequence, the same values as seqan3::views::kmer_hash.
+ * \param[in]     sequence The sequence, see minions::batch_sequence.
+ * \param[in]     shape    The seqan3::shape to use for hashing.
+ * \param[in,out] buffer   The buffer the hashes are appended to.
+ */
+template <batch_sequence sequence_t>
+void kmer_batch(sequence_t const & sequence, seqan3::shape const & shape, batch_buffer & buffer)
+{
+    std::span<uint8_t const> const ranks = detail::batch_ranks(sequence, buffer.ranks);
+    detail::batch_kmer_hashes<false>(ranks, shape, buffer.forward, buffer.reverse);
+    detail::select_kmers(buffer.forward, buffer);
+}
+
+/*!\brief Appends the minimisers of the sequence, the same values as minions::views::minimiser_hash.
+ * \param[in]     sequence    The sequence, see minions::batch_sequence.
+ * \param[in]     shape       The seqan3::shape to use for hashing.
+ * \param[in]     window_size The window size to use.
+ * \param[in]     seed        The seed to use.
+ * \param[in,out] buffer      The buffer the minimisers are appended to.
+ * \param[in]     hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+ * \throws std::invalid_argument if the size of the shape is greater than the `window_size`.
+ * \details
+ * Windows of at most minions::specialised_window_values k-mers are handled by a kernel with the window size as
+ * compile-time constant, which rescans the window instead of keeping a monotone queue.
+ */
+template <batch_sequence sequence_t, hash_policy hash_policy_t = xor_hash_policy>
+void minimiser_batch(sequence_t const & sequence,
+                     seqan3::shape const & shape,
+                     seqan3::window_size const window_size,
+                     seqan3::seed const seed,
+                     batch_buffer & buffer,
+                     hash_policy_t const hash_policy = hash_policy_t{})
+{
+    if (shape.size() > window_size.get())
+        throw std::invalid_argument{"The size of the shape cannot be greater than the window size."};
+
+    std::span<uint8_t const> const ranks = detail::batch_ranks(sequence, buffer.ranks);
+    detail::batch_kmer_hashes<true>(ranks, shape, buffer.forward, buffer.reverse);
+    detail::select_minimisers(buffer.forward, buffer.reverse, shape.size(), window_size, seed, buffer, hash_policy);
+}
+
+/*!\brief Appends the modmers of the sequence, the same values as seqan3::views::modmer_hash.
+ * \param[in]     sequence    The sequence, see minions::batch_sequence.
+ * \param[in]     shape       The seqan3::shape to use for hashing.
+ * \param[in]     mod_used    The mod value to use.
+ * \param[in]     seed        The seed to use.
+ * \param[in,out] buffer      The buffer the modmers are appended to.
+ * \param[in]     hash_policy The minions::hash_policy, whose value decides if a k-mer is a modmer.
+ */
+template <batch_sequence sequence_t, hash_policy hash_policy_t = fnv_hash_policy>
+void modmer_batch(sequence_t const & sequence,
+                  seqan3::shape const & shape,
+                  uint32_t const mod_used,
+                  seqan3::seed const seed,
+                  batch_buffer & buffer,
+                  hash_policy_t const hash_policy = hash_policy_t{})
+{
+    std::span<uint8_t const> const ranks = detail::batch_ranks(sequence, buffer.ranks);
+    detail::batch_kmer_hashes<true>(ranks, shape, buffer.forward, buffer.reverse);
+    detail::select_modmers(buffer.forward, buffer.reverse, mod_used, seed, buffer, hash_policy);
+}
+
+/*!\brief Appends the syncmers of the sequence, the same values as seqan3::views::syncmer_hash.
+ * \param[in]     sequence    The sequence, see minions::batch_sequence.
+ * \param[in]     smers       The s-mer size.
+ * \param[in]     kmers       The k-mer size.
+ * \param[in]     positions   The positions of the smallest s-mer, that make a k-mer a syncmer.
+ * \param[in]     seed        The seed to use.
+ * \param[in,out] buffer      The buffer the syncmers are appended to.
+ * \param[in]     hash_policy The minions::hash_policy that transforms every k-mer and s-mer hash with the seed.
+ * \throws std::invalid_argument if the s-mer size is not in [1, kmers) or the sequence is shorter than a k-mer.
+ */
+template <batch_sequence sequence_t, hash_policy hash_policy_t = xor_hash_policy>
+void syncmer_batch(sequence_t const & sequence,
+                   size_t const smers,
+                   size_t const kmers,
+                   std::vector<int> const & positions,
+                   seqan3::seed const seed,
+                   batch_buffer & buffer,
+                   hash_policy_t const hash_policy = hash_policy_t{})
+{
+    if (smers < 1 || kmers <= smers)
+        throw std::invalid_argument{"The chosen kmers and smers are not valid."
+                                    "Please choose values greater than 1 and a smer size smaller than the kmer size."};
+
+    std::span<uint8_t const> const ranks = detail::batch_ranks(sequence, buffer.ranks);
+    seqan3::shape const kmer_shape{seqan3::ungapped{static_cast<uint8_t>(kmers)}};
+    seqan3::shape const smer_shape{seqan3::ungapped{static_cast<uint8_t>(smers)}};
+    detail::batch_kmer_hashes<true>(ranks, kmer_shape, buffer.forward, buffer.reverse);
+    detail::batch_kmer_hashes<true>(ranks, smer_shape, buffer.forward_smers, buffer.reverse_smers);
+    detail::select_syncmers(buffer.forward, buffer.reverse, buffer.forward_smers, buffer.reverse_smers,
+                            positions, seed, buffer, hash_policy);
+}
+
+/*!\brief Appends the strobemers of the sequence, the same values as the strobemer hash views, e.g.
+ *        seqan3::views::randstrobe2_hash for minions::strobemer_method::randstrobe and order 2.
+ * \tparam method The minions::strobemer_method.
+ * \tparam order  The number of strobes, 2 or 3.
+ * \param[in]     sequence    The sequence, see minions::batch_sequence.
+ * \param[in]     shape       The seqan3::shape to use for hashing.
+ * \param[in]     window_min  The minimal offset for the position of the next strobes.
+ * \param[in]     window_len  The maximal offset for the position of the next strobes.
+ * \param[in]     seed        The seed to use.
+ * \param[in,out] buffer      The buffer the strobemers are appended to.
+ * \param[in]     hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+ * \throws std::invalid_argument if window_len is smaller than window_min, the window is not valid for the method or
+ *         the sequence does not contain more k-mers than one window.
+ */
+template <strobemer_method method,
+          uint16_t order,
+          batch_sequence sequence_t,
+          hash_policy hash_policy_t = xor_hash_policy>
+void strobemer_batch(sequence_t const & sequence,
+                     seqan3::shape const & shape,
+                     uint32_t const window_min,
+                     uint32_t const window_len,
+                     seqan3::seed const seed,
+                     batch_buffer & buffer,
+                     hash_policy_t const hash_policy = hash_policy_t{})
+{
+    if (window_len < window_min)
+        throw std::invalid_argument{"The chosen parameters are not valid. "
+                                    "Please choose a window_len greater than window_min."};
+
+    std::span<uint8_t const> const ranks = detail::batch_ranks(sequence, buffer.ranks);
+    detail::batch_kmer_hashes<true>(ranks, shape, buffer.forward, buffer.reverse);
+    detail::select_strobemers<method, order>(buffer.forward, buffer.reverse, shape, window_min, window_len, seed,
+                                             buffer, hash_policy);
+}
+
+} // namespace minions
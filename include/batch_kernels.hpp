@@ -0,0 +1,192 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides the SIMD kernels of the batch functions.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MINIONS_X86_KERNELS 1
+#include <immintrin.h>
+#else
+#define MINIONS_X86_KERNELS 0
+#endif
+
+namespace minions::detail
+{
+
+//!\brief The instruction sets the batch kernels are available for.
+enum class simd_level : uint8_t
+{
+    scalar, //!< Plain C++.
+    sse4_2, //!< Two 64 bit values per instruction, needs SSE4.2 for the 64 bit comparison.
+    avx2    //!< Four 64 bit values per instruction.
+};
+
+//!\brief Returns the best instruction set the CPU supports. Checked once, later calls are cheap.
+inline simd_level supported_simd_level() noexcept
+{
+#if MINIONS_X86_KERNELS
+    static simd_level const level = __builtin_cpu_supports("avx2")   ? simd_level::avx2 :
+                                    __builtin_cpu_supports("sse4.2") ? simd_level::sse4_2 :
+                                                                       simd_level::scalar;
+    return level;
+#else
+    return simd_level::scalar;
+#endif
+}
+
+/*!\name Scalar kernels
+ * \{
+ */
+//!\brief `values[i] ^= seed` for all i < size.
+inline void xor_seed_scalar(uint64_t * const values, size_t const size, uint64_t const seed) noexcept
+{
+    for (size_t i = 0; i < size; ++i)
+        values[i] ^= seed;
+}
+
+//!\brief `out[i] = std::min(forward[i] ^ seed, reverse[i] ^ seed)` for all i < size. out may be forward or reverse.
+inline void canonical_min_scalar(uint64_t const * const forward,
+                                 uint64_t const * const reverse,
+                                 uint64_t * const out,
+                                 size_t const size,
+                                 uint64_t const seed) noexcept
+{
+    for (size_t i = 0; i < size; ++i)
+        out[i] = std::min(forward[i] ^ seed, reverse[i] ^ seed);
+}
+//!\}
+
+#if MINIONS_X86_KERNELS
+/*!\name x86 kernels
+ * \brief Unaligned loads and stores, the remainder is handled by the scalar kernel.
+ * \details
+ * There is no unsigned 64 bit comparison before AVX-512, so the sign bit of both operands is flipped before the
+ * signed comparison.
+ * \{
+ */
+__attribute__((target("sse4.2")))
+inline void xor_seed_sse4_2(uint64_t * const values, size_t const size, uint64_t const seed) noexcept
+{
+    __m128i const seeds = _mm_set1_epi64x(static_cast<int64_t>(seed));
+    size_t i = 0;
+    for (; i + 2 <= size; i += 2)
+    {
+        __m128i * const address = reinterpret_cast<__m128i *>(values + i);
+        _mm_storeu_si128(address, _mm_xor_si128(_mm_loadu_si128(address), seeds));
+    }
+    xor_seed_scalar(values + i, size - i, seed);
+}
+
+__attribute__((target("sse4.2")))
+inline void canonical_min_sse4_2(uint64_t const * const forward,
+                                 uint64_t const * const reverse,
+                                 uint64_t * const out,
+                                 size_t const size,
+                                 uint64_t const seed) noexcept
+{
+    __m128i const seeds = _mm_set1_epi64x(static_cast<int64_t>(seed));
+    __m128i const sign = _mm_set1_epi64x(static_cast<int64_t>(1ULL << 63));
+    size_t i = 0;
+    for (; i + 2 <= size; i += 2)
+    {
+        __m128i const f = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(forward + i)), seeds);
+        __m128i const r = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(reverse + i)), seeds);
+        __m128i const forward_greater = _mm_cmpgt_epi64(_mm_xor_si128(f, sign), _mm_xor_si128(r, sign));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_blendv_epi8(f, r, forward_greater));
+    }
+    canonical_min_scalar(forward + i, reverse + i, out + i, size - i, seed);
+}
+
+__attribute__((target("avx2")))
+inline void xor_seed_avx2(uint64_t * const values, size_t const size, uint64_t const seed) noexcept
+{
+    __m256i const seeds = _mm256_set1_epi64x(static_cast<int64_t>(seed));
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        __m256i * const address = reinterpret_cast<__m256i *>(values + i);
+        _mm256_storeu_si256(address, _mm256_xor_si256(_mm256_loadu_si256(address), seeds));
+    }
+    xor_seed_scalar(values + i, size - i, seed);
+}
+
+__attribute__((target("avx2")))
+inline void canonical_min_avx2(uint64_t const * const forward,
+                               uint64_t const * const reverse,
+                               uint64_t * const out,
+                               size_t const size,
+                               uint64_t const seed) noexcept
+{
+    __m256i const seeds = _mm256_set1_epi64x(static_cast<int64_t>(seed));
+    __m256i const sign = _mm256_set1_epi64x(static_cast<int64_t>(1ULL << 63));
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        __m256i const f = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(forward + i)), seeds);
+        __m256i const r = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(reverse + i)), seeds);
+        __m256i const forward_greater = _mm256_cmpgt_epi64(_mm256_xor_si256(f, sign), _mm256_xor_si256(r, sign));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_blendv_epi8(f, r, forward_greater));
+    }
+    canonical_min_scalar(forward + i, reverse + i, out + i, size - i, seed);
+}
+//!\}
+#endif
+
+/*!\brief `values[i] ^= seed` for all i < size.
+ * \param[in,out] values The values.
+ * \param[in]     size   The number of values.
+ * \param[in]     seed   The seed.
+ * \param[in]     level  The instruction set to use, must be supported by the CPU.
+ */
+inline void xor_seed(uint64_t * const values,
+                     size_t const size,
+                     uint64_t const seed,
+                     simd_level const level = supported_simd_level()) noexcept
+{
+#if MINIONS_X86_KERNELS
+    if (level == simd_level::avx2)
+        return xor_seed_avx2(values, size, seed);
+    if (level == simd_level::sse4_2)
+        return xor_seed_sse4_2(values, size, seed);
+#endif
+    xor_seed_scalar(values, size, seed);
+}
+
+/*!\brief `out[i] = std::min(forward[i] ^ seed, reverse[i] ^ seed)` for all i < size.
+ * \param[in]  forward The hashes of the forward strand.
+ * \param[in]  reverse The hashes of the reverse complement strand.
+ * \param[out] out     The canonical hashes, may be forward or reverse.
+ * \param[in]  size    The number of values.
+ * \param[in]  seed    The seed.
+ * \param[in]  level   The instruction set to use, must be supported by the CPU.
+ */
+inline void canonical_min(uint64_t const * const forward,
+                          uint64_t const * const reverse,
+                          uint64_t * const out,
+                          size_t const size,
+                          uint64_t const seed,
+                          simd_level const level = supported_simd_level()) noexcept
+{
+#if MINIONS_X86_KERNELS
+    if (level == simd_level::avx2)
+        return canonical_min_avx2(forward, reverse, out, size, seed);
+    if (level == simd_level::sse4_2)
+        return canonical_min_sse4_2(forward, reverse, out, size, seed);
+#endif
+    canonical_min_scalar(forward, reverse, out, size, seed);
+}
+
+} // namespace minions::detail
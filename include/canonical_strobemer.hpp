@@ -0,0 +1,685 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::canonical_strobemer_window and seqan3::detail::canonical_strobemer_view.
+ */
+
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <seqan3/core/range/type_traits.hpp>
+#include <seqan3/utility/range/concept.hpp>
+
+#include "shared.hpp"
+#include "window_minimum.hpp"
+
+namespace minions
+{
+
+//!\brief The strobemer methods, that can be computed by minions::canonical_strobemer_window.
+enum class strobemer_method
+{
+    randstrobe,   //!< The second (and third) strobe is linked to the first one, see seqan3::detail::randstrobe_view.
+    minstrobe,    //!< The second (and third) strobe is the minimum of its window, see seqan3::detail::minstrobe_view.
+    hybridstrobe  //!< The strobe is the minimum of a part of its window, see seqan3::detail::hybridstrobe_view.
+};
+
+/*!\brief Computes canonical strobemers from the k-mer hashes of both strands in one pass.
+ * \tparam method The strobemer method.
+ * \tparam order  The order of strobemers, at the moment the order 2 and 3 are supported. Default is 2.
+ *
+ * \details
+ *
+ * The k-mer hashes of the forward strand and the hashes of the reverse complement of the same k-mers are pushed
+ * position by position. Once span() positions are pushed, value() returns the smaller one of the strobemer starting at
+ * the oldest position on the forward strand and the strobemer ending at the newest position on the reverse strand,
+ * i.e. the same value the strobemer views compute when the reverse complement sequence is processed separately and
+ * the result is reversed.
+ *
+ * Only the last span() positions are kept in a ring buffer, whose capacity is fixed on construction, so pushing never
+ * allocates. The windows of minstrobes are maintained by minions::window_minimum.
+ */
+template <strobemer_method method, std::uint16_t order = 2>
+class canonical_strobemer_window
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    canonical_strobemer_window() = default; //!< Defaulted.
+    canonical_strobemer_window(canonical_strobemer_window const &) = default; //!< Defaulted.
+    canonical_strobemer_window(canonical_strobemer_window &&) = default; //!< Defaulted.
+    canonical_strobemer_window & operator=(canonical_strobemer_window const &) = default; //!< Defaulted.
+    canonical_strobemer_window & operator=(canonical_strobemer_window &&) = default; //!< Defaulted.
+    ~canonical_strobemer_window() = default; //!< Defaulted.
+
+    /*!\brief Construct an empty window.
+    * \param[in] window_dist The lower offset for the position of the next window from the previous one.
+    * \param[in] window_size The number of elements in a window.
+    * \param[in] multi       The multiplicator.
+    * \throws std::invalid_argument if window_size is 0 or, for hybridstrobes, not divisible into three parts.
+    */
+    canonical_strobemer_window(size_t const window_dist, size_t const window_size, uint64_t const multi) :
+        window_dist{window_dist},
+        window_length{window_size}
+    {
+        if (window_length == 0u)
+            throw std::invalid_argument{"The given window size is too small.\n"
+                                        "Please choose a bigger window size greater than 0."};
+
+        if constexpr (method == strobemer_method::hybridstrobe)
+        {
+            // Throws, if the second group is not as big as the first group
+            if (std::ceil((window_length - std::ceil(window_length/3.0))/2.0) != std::ceil(window_length/3.0))
+                throw std::invalid_argument{"The given window size is too small.\n"
+                                            "Please choose a bigger window size."};
+            elem_r = (window_length + 2) / 3;
+        }
+
+        if constexpr (order_3)
+        {
+            third_offset = 2 * window_dist + window_length - 1;
+            strobemer_span = third_offset + window_length;
+            multiplicator = my_pow(4, multi*2);
+            multiplicator3 = my_pow(4, multi);
+        }
+        else
+        {
+            strobemer_span = window_dist + window_length;
+            multiplicator = my_pow(4, multi);
+        }
+
+        buffer.resize(std::bit_ceil(strobemer_span));
+        mask = buffer.size() - 1;
+
+        if constexpr (method == strobemer_method::minstrobe)
+        {
+            forward_second = window_minimum<uint64_t>{window_length};
+            reverse_second = window_minimum<uint64_t>{window_length};
+            if constexpr (order_3)
+            {
+                forward_third = window_minimum<uint64_t>{window_length};
+                reverse_third = window_minimum<uint64_t>{window_length};
+            }
+        }
+    }
+    //!\}
+
+    /*!\brief Adds the hashes of the k-mer at the next position.
+     * \param[in] forward_value The hash of the k-mer.
+     * \param[in] reverse_value The hash of the reverse complement of the k-mer.
+     */
+    void push(uint64_t const forward_value, uint64_t const reverse_value) noexcept
+    {
+        buffer[pushed & mask] = entry{forward_value, reverse_value};
+        ++pushed;
+
+        if constexpr (method == strobemer_method::minstrobe)
+        {
+            // Each window is fed with a delay, such that its last value is the last value of the strobe's window.
+            if constexpr (order_3)
+            {
+                push_delayed(forward_second, strobemer_span - window_dist - window_length, &entry::forward);
+                forward_third.push(forward_value);
+                push_delayed(reverse_third, third_offset, &entry::reverse);
+            }
+            else
+            {
+                forward_second.push(forward_value);
+            }
+            push_delayed(reverse_second, window_dist, &entry::reverse);
+        }
+    }
+
+    //!\brief Whether enough positions are pushed to compute a strobemer.
+    bool full() const noexcept
+    {
+        return pushed >= strobemer_span;
+    }
+
+    //!\brief Returns the number of elements in a window.
+    size_t window_size() const noexcept
+    {
+        return window_length;
+    }
+
+    //!\brief Returns the number of positions one strobemer covers.
+    size_t span() const noexcept
+    {
+        return strobemer_span;
+    }
+
+    //!\brief Returns the number of pushed positions, i.e. the position of the next one.
+    size_t pushed_values() const noexcept
+    {
+        return pushed;
+    }
+
+    //!\brief Returns the canonical strobemer of the last span() positions. The window must be full().
+    uint64_t value() const noexcept
+    {
+        size_t const first = pushed - strobemer_span;
+        size_t const last = pushed - 1;
+
+        uint64_t const forward = strobemer([&] (size_t const offset)
+                                           {
+                                               return buffer[(first + offset) & mask].forward;
+                                           }, forward_second, forward_third);
+        uint64_t const reverse = strobemer([&] (size_t const offset)
+                                           {
+                                               return buffer[(last - offset) & mask].reverse;
+                                           }, reverse_second, reverse_third);
+
+        return std::min(forward, reverse);
+    }
+
+    //!\brief Empties the window, the capacity is kept.
+    void clear() noexcept
+    {
+        pushed = 0;
+        forward_second.clear();
+        forward_third.clear();
+        reverse_second.clear();
+        reverse_third.clear();
+    }
+
+private:
+    //!\brief Whether the given order is of range 3.
+    static constexpr bool order_3 = (order == 3);
+
+    //!\brief The hashes of one position.
+    struct entry
+    {
+        //!\brief The hash of the k-mer.
+        uint64_t forward{};
+        //!\brief The hash of the reverse complement of the k-mer.
+        uint64_t reverse{};
+    };
+
+    //!\brief The distance between the first strobe and the second.
+    size_t window_dist{};
+    //!\brief The number of elements in a window.
+    size_t window_length{};
+    //!\brief The offset of the third window to the first strobe, if order is 3.
+    size_t third_offset{};
+    //!\brief The number of positions one strobemer covers.
+    size_t strobemer_span{};
+    //!\brief The number of elements in one part of a hybridstrobe window.
+    size_t elem_r{};
+    //!\brief The bitmask.
+    size_t bitmask{0x1C5C4AE};
+    //!\brief The multiplicator.
+    uint64_t multiplicator{};
+    //!\brief The multiplicator for order 3.
+    uint64_t multiplicator3{};
+
+    //!\brief The hashes of the last span() positions.
+    std::vector<entry> buffer{};
+    //!\brief Maps a position to an index of the ring buffer, the capacity is a power of two.
+    size_t mask{};
+    //!\brief The number of pushed positions.
+    size_t pushed{};
+
+    //!\brief The window of the second strobe on the forward strand, only used for minstrobes.
+    window_minimum<uint64_t> forward_second{};
+    //!\brief The window of the third strobe on the forward strand, only used for minstrobes of order 3.
+    window_minimum<uint64_t> forward_third{};
+    //!\brief The window of the second strobe on the reverse strand, only used for minstrobes.
+    window_minimum<uint64_t> reverse_second{};
+    //!\brief The window of the third strobe on the reverse strand, only used for minstrobes of order 3.
+    window_minimum<uint64_t> reverse_third{};
+
+    //!\brief Pushes the value `delay` positions before the last one to the window, if it exists.
+    void push_delayed(window_minimum<uint64_t> & window, size_t const delay, uint64_t entry::* strand) noexcept
+    {
+        if (pushed > delay)
+            window.push(buffer[(pushed - 1 - delay) & mask].*strand);
+    }
+
+    /*!\brief Computes the strobemer of one strand.
+     * \param[in] strobe  Returns the hash at the given offset to the first strobe.
+     * \param[in] second  The window of the second strobe, only used for minstrobes.
+     * \param[in] third   The window of the third strobe, only used for minstrobes of order 3.
+     */
+    template <typename strobe_t>
+    uint64_t strobemer(strobe_t && strobe,
+                       [[maybe_unused]] window_minimum<uint64_t> const & second,
+                       [[maybe_unused]] window_minimum<uint64_t> const & third) const noexcept
+    {
+        uint64_t const first_strobe = strobe(0);
+        uint64_t second_strobe{};
+        uint64_t third_strobe{};
+
+        if constexpr (method == strobemer_method::randstrobe)
+        {
+            second_strobe = strobe(window_dist);
+            uint64_t minimum_hash = (first_strobe + second_strobe) & bitmask;
+            for (size_t i = 1u; i < window_length; ++i)
+            {
+                uint64_t const candidate = strobe(window_dist + i);
+                uint64_t const new_value = (first_strobe + candidate) & bitmask;
+                if (new_value <= minimum_hash)
+                {
+                    minimum_hash = new_value;
+                    second_strobe = candidate;
+                }
+            }
+
+            if constexpr (order_3)
+            {
+                third_strobe = strobe(third_offset);
+                minimum_hash = (first_strobe + second_strobe + third_strobe) & bitmask;
+                for (size_t i = 1u; i < window_length; ++i)
+                {
+                    uint64_t const candidate = strobe(third_offset + i);
+                    uint64_t const new_value = (first_strobe + second_strobe + candidate) & bitmask;
+                    if (new_value <= minimum_hash)
+                    {
+                        minimum_hash = new_value;
+                        third_strobe = candidate;
+                    }
+                }
+            }
+        }
+        else if constexpr (method == strobemer_method::minstrobe)
+        {
+            second_strobe = second.min();
+            if constexpr (order_3)
+                third_strobe = third.min();
+        }
+        else
+        {
+            // For a window size of 2 the third part is empty, then the last element of the window is used.
+            size_t const part_begin = std::min<size_t>((first_strobe % 3) * elem_r, window_length - 1);
+            size_t const part_end = std::min(part_begin + elem_r, window_length);
+
+            second_strobe = strobe(window_dist + part_begin);
+            for (size_t i = part_begin + 1; i < part_end; ++i)
+                second_strobe = std::min(second_strobe, strobe(window_dist + i));
+
+            if constexpr (order_3)
+            {
+                third_strobe = strobe(third_offset + part_begin);
+                for (size_t i = part_begin + 1; i < part_end; ++i)
+                    third_strobe = std::min(third_strobe, strobe(third_offset + i));
+            }
+        }
+
+        if constexpr (order_3)
+            return first_strobe*multiplicator + second_strobe*multiplicator3 + third_strobe;
+        else
+            return first_strobe*multiplicator + second_strobe;
+    }
+};
+
+} // namespace minions
+
+namespace seqan3::detail
+{
+// ---------------------------------------------------------------------------------------------------------------------
+// canonical_strobemer_view class
+// ---------------------------------------------------------------------------------------------------------------------
+
+/*!\brief The type returned by the strobemer hash views, e.g. seqan3::views::randstrobe2_hash.
+ * \tparam urng1_t The type of the k-mer hashes of the forward strand, must model std::ranges::forward_range.
+ * \tparam urng2_t The type of the hashes of the reverse complement k-mers in the order of the forward strand, must
+ *                 model std::ranges::forward_range.
+ * \tparam method  The strobemer method.
+ * \tparam order   The order of strobemers, at the moment the order 2 and 3 are supported. Default is 2.
+ * \implements std::ranges::view
+ * \ingroup search_views
+ *
+ * \details
+ *
+ * Both ranges are read once and in lockstep, the canonical strobemers are computed on the fly by a
+ * minions::canonical_strobemer_window. Hence, the memory does not depend on the length of the sequence, but only on
+ * the window parameters.
+ *
+ * \note Most members of this class are generated by std::ranges::view_interface which is not yet documented here.
+ */
+template <std::ranges::view urng1_t, std::ranges::view urng2_t, minions::strobemer_method method, std::uint16_t order = 2>
+class canonical_strobemer_view :
+    public std::ranges::view_interface<canonical_strobemer_view<urng1_t, urng2_t, method, order>>
+{
+private:
+    static_assert(std::ranges::forward_range<urng1_t>, "The canonical_strobemer_view only works on forward_ranges.");
+    static_assert(std::ranges::forward_range<urng2_t>, "The canonical_strobemer_view only works on forward_ranges.");
+    static_assert(std::convertible_to<std::ranges::range_reference_t<urng1_t>, uint64_t> &&
+                  std::convertible_to<std::ranges::range_reference_t<urng2_t>, uint64_t>,
+                  "The reference types of the underlying ranges must be convertible to uint64_t.");
+
+    //!\brief Whether the given ranges are const_iterable.
+    static constexpr bool const_iterable = seqan3::const_iterable_range<urng1_t> &&
+                                           seqan3::const_iterable_range<urng2_t>;
+
+    //!\brief The k-mer hashes of the forward strand.
+    urng1_t urange1{};
+    //!\brief The hashes of the reverse complement k-mers.
+    urng2_t urange2{};
+
+    //!\brief The distance of the second strobe to the first one.
+    size_t window_dist{};
+
+    //!\brief The number of elements in a window.
+    size_t window_size{};
+
+    //!\brief The multiplicator.
+    uint64_t multi{};
+
+    template <bool const_range>
+    class basic_iterator;
+
+    //!\brief The sentinel type of the canonical_strobemer_view.
+    using sentinel = std::default_sentinel_t;
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+     /// \cond Workaround_Doxygen
+    canonical_strobemer_view() requires std::default_initializable<urng1_t> &&
+                                        std::default_initializable<urng2_t> = default; //!< Defaulted.
+    /// \endcond
+    canonical_strobemer_view(canonical_strobemer_view const & rhs) = default; //!< Defaulted.
+    canonical_strobemer_view(canonical_strobemer_view && rhs) = default; //!< Defaulted.
+    canonical_strobemer_view & operator=(canonical_strobemer_view const & rhs) = default; //!< Defaulted.
+    canonical_strobemer_view & operator=(canonical_strobemer_view && rhs) = default; //!< Defaulted.
+    ~canonical_strobemer_view() = default; //!< Defaulted.
+
+    /*!\brief Construct from two views and the window parameters.
+    * \param[in] urange1     The k-mer hashes of the forward strand.
+    * \param[in] urange2     The hashes of the reverse complement k-mers, in the same order as urange1.
+    * \param[in] window_dist The lower offset for the position of the next window from the previous one.
+    * \param[in] window_size The number of elements in a window.
+    * \param[in] multi       The multiplicator.
+    */
+    canonical_strobemer_view(urng1_t urange1,
+                             urng2_t urange2,
+                             size_t const window_dist,
+                             size_t const window_size,
+                             uint64_t const multi) :
+        urange1{std::move(urange1)},
+        urange2{std::move(urange2)},
+        window_dist{window_dist},
+        window_size{window_size},
+        multi{multi}
+    {}
+    //!\}
+
+    /*!\name Iterators
+     * \{
+     */
+    /*!\brief Returns an iterator to the first element of the range.
+     * \returns Iterator to the first element.
+     *
+     * \details
+     *
+     * ### Complexity
+     *
+     * Linear in the number of positions one strobemer covers.
+     *
+     * ### Exceptions
+     *
+     * Throws std::invalid_argument if the range is too short or the window size is not valid.
+     */
+    basic_iterator<false> begin()
+    {
+        return {std::ranges::begin(urange1),
+                std::ranges::end(urange1),
+                std::ranges::begin(urange2),
+                window_dist,
+                window_size,
+                multi};
+    }
+
+    //!\copydoc begin()
+    basic_iterator<true> begin() const
+    //!\cond
+        requires const_iterable
+    //!\endcond
+    {
+        return {std::ranges::cbegin(urange1),
+                std::ranges::cend(urange1),
+                std::ranges::cbegin(urange2),
+                window_dist,
+                window_size,
+                multi};
+    }
+
+    /*!\brief Returns an iterator to the element following the last element of the range.
+     * \returns Iterator to the end.
+     *
+     * ### Complexity
+     *
+     * Constant.
+     *
+     * ### Exceptions
+     *
+     * No-throw guarantee.
+     */
+    sentinel end() const
+    {
+        return {};
+    }
+    //!\}
+};
+
+//!\brief Iterator for calculating canonical strobemers.
+template <std::ranges::view urng1_t, std::ranges::view urng2_t, minions::strobemer_method method, std::uint16_t order>
+template <bool const_range>
+class canonical_strobemer_view<urng1_t, urng2_t, method, order>::basic_iterator
+{
+private:
+    //!\brief The sentinel type of the first underlying range.
+    using urng1_sentinel_t = maybe_const_sentinel_t<const_range, urng1_t>;
+    //!\brief The iterator type of the first underlying range.
+    using urng1_iterator_t = maybe_const_iterator_t<const_range, urng1_t>;
+    //!\brief The iterator type of the second underlying range.
+    using urng2_iterator_t = maybe_const_iterator_t<const_range, urng2_t>;
+
+    template <bool>
+    friend class basic_iterator;
+
+public:
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief Type for distances between iterators.
+    using difference_type = std::iter_difference_t<urng1_iterator_t>;
+    //!\brief Value type of the iterator.
+    using value_type = uint64_t;
+    //!\brief The pointer type.
+    using pointer = void;
+    //!\brief Reference to `value_type`.
+    using reference = value_type;
+    //!\brief Tag this class as a forward iterator.
+    using iterator_category = std::forward_iterator_tag;
+    //!\brief Tag this class as a forward iterator.
+    using iterator_concept = iterator_category;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    basic_iterator() = default; //!< Defaulted.
+    basic_iterator(basic_iterator const &) = default; //!< Defaulted.
+    basic_iterator(basic_iterator &&) = default; //!< Defaulted.
+    basic_iterator & operator=(basic_iterator const &) = default; //!< Defaulted.
+    basic_iterator & operator=(basic_iterator &&) = default; //!< Defaulted.
+    ~basic_iterator() = default; //!< Defaulted.
+
+    //!\brief Allow iterator on a const range to be constructible from an iterator over a non-const range.
+    basic_iterator(basic_iterator<!const_range> const & it)
+    //!\cond
+        requires const_range
+    //!\endcond
+        : strobemer_value{it.strobemer_value},
+          urng1_iterator{it.urng1_iterator},
+          urng1_sentinel{it.urng1_sentinel},
+          urng2_iterator{it.urng2_iterator},
+          window{it.window},
+          at_end{it.at_end}
+    {}
+
+    /*!\brief Construct from begin and end iterators of the forward hashes, the begin iterator of the reverse hashes
+    *         and the window parameters.
+    * \param[in] urng1_iterator Iterator pointing to the first position of the forward hashes.
+    * \param[in] urng1_sentinel Iterator pointing to the last position of the forward hashes.
+    * \param[in] urng2_iterator Iterator pointing to the first position of the reverse hashes.
+    * \param[in] window_dist    The lower offset for the position of the next window from the previous one.
+    * \param[in] window_size    The number of elements in a window.
+    * \param[in] multi          The multiplicator.
+    * \throws std::invalid_argument if the range does not contain more values than one window or the window size is
+    *         not valid.
+    */
+    basic_iterator(urng1_iterator_t urng1_iterator,
+                   urng1_sentinel_t urng1_sentinel,
+                   urng2_iterator_t urng2_iterator,
+                   size_t const window_dist,
+                   size_t const window_size,
+                   uint64_t const multi) :
+        urng1_iterator{std::move(urng1_iterator)},
+        urng1_sentinel{std::move(urng1_sentinel)},
+        urng2_iterator{std::move(urng2_iterator)}
+    {
+        // Checked before the window is constructed, because its memory depends on the window size.
+        size_t values{0};
+        for (auto it = this->urng1_iterator; it != this->urng1_sentinel && values <= window_size; ++it)
+            ++values;
+
+        if (values <= window_size)
+            throw std::invalid_argument{"The given range is too short to satisfy the given parameters.\n"
+                                        "Please choose a smaller window size or pick a longer underlying range."};
+
+        window = minions::canonical_strobemer_window<method, order>{window_dist, window_size, multi};
+
+        while (!window.full() && this->urng1_iterator != this->urng1_sentinel)
+            advance();
+
+        if (window.full())
+            strobemer_value = window.value();
+        else
+            at_end = true;
+    }
+    //!\}
+
+    //!\anchor basic_iterator_comparison_canonical_strobemer
+    //!\name Comparison operators
+    //!\{
+
+    //!\brief Compare to another basic_iterator.
+    friend bool operator==(basic_iterator const & lhs, basic_iterator const & rhs)
+    {
+        return (lhs.urng1_iterator == rhs.urng1_iterator) && (lhs.at_end == rhs.at_end);
+    }
+
+    //!\brief Compare to another basic_iterator.
+    friend bool operator!=(basic_iterator const & lhs, basic_iterator const & rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    //!\brief Compare to the sentinel of the canonical_strobemer_view.
+    friend bool operator==(basic_iterator const & lhs, sentinel const &)
+    {
+        return lhs.at_end;
+    }
+
+    //!\brief Compare to the sentinel of the canonical_strobemer_view.
+    friend bool operator==(sentinel const & lhs, basic_iterator const & rhs)
+    {
+        return rhs == lhs;
+    }
+
+    //!\brief Compare to the sentinel of the canonical_strobemer_view.
+    friend bool operator!=(sentinel const & lhs, basic_iterator const & rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    //!\brief Compare to the sentinel of the canonical_strobemer_view.
+    friend bool operator!=(basic_iterator const & lhs, sentinel const & rhs)
+    {
+        return !(lhs == rhs);
+    }
+    //!\}
+
+    //!\brief Pre-increment.
+    basic_iterator & operator++() noexcept
+    {
+        next_strobemer();
+        return *this;
+    }
+
+    //!\brief Post-increment.
+    basic_iterator operator++(int) noexcept
+    {
+        basic_iterator tmp{*this};
+        next_strobemer();
+        return tmp;
+    }
+
+    //!\brief Return the canonical strobemer.
+    value_type operator*() const noexcept
+    {
+        return strobemer_value;
+    }
+
+    //!\brief Return the position of the canonical strobemer, i.e. of its first strobe.
+    size_t position() const noexcept
+    {
+        return window.pushed_values() - window.span();
+    }
+
+private:
+    //!\brief The canonical strobemer value.
+    value_type strobemer_value{};
+
+    //!\brief Iterator to the next forward hash, that was not pushed to the window.
+    urng1_iterator_t urng1_iterator{};
+
+    //!\brief Iterator to last element of the forward hashes.
+    urng1_sentinel_t urng1_sentinel{};
+
+    //!\brief Iterator to the next reverse hash, that was not pushed to the window.
+    urng2_iterator_t urng2_iterator{};
+
+    //!\brief The last positions of both strands.
+    minions::canonical_strobemer_window<method, order> window{};
+
+    //!\brief Whether the iterator reached the end of the range.
+    bool at_end{false};
+
+    //!\brief Pushes the hashes of both strands at the current position.
+    void advance() noexcept
+    {
+        window.push(*urng1_iterator, *urng2_iterator);
+        ++urng1_iterator;
+        ++urng2_iterator;
+    }
+
+    //!\brief Calculates the next canonical strobemer value.
+    void next_strobemer() noexcept
+    {
+        if (urng1_iterator == urng1_sentinel)
+        {
+            at_end = true;
+            return;
+        }
+
+        advance();
+        strobemer_value = window.value();
+    }
+};
+
+} // namespace seqan3::detail
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <concepts>
 #include <iostream>
 #include <numeric>
 #include <seqan3/std/filesystem>
@@ -54,6 +55,10 @@ struct range_arguments : minimiser_arguments, strobemer_arguments, syncmer_argum
 
    methods name;
    uint8_t k_size;
+   size_t threads{1};
+   uint64_t max_memory{0}; // The memory in MiB for counting, 0 to count in memory without a limit.
+   bool approximate{false}; // Set to true, if only samples of the hash values should be counted.
+   bool estimate{false}; // Set to true, if the number of distinct hash values should only be estimated.
 };
 
 struct accuracy_arguments : range_arguments
@@ -64,6 +69,15 @@ struct accuracy_arguments : range_arguments
    std::filesystem::path search_file{};
    std::filesystem::path solution_file{};
    float threshold{0.5};
+   bool skip_ibf_output{false}; // Set to true, if an ibf built from the input files should not be stored.
+   size_t chunk_size{256}; // The number of search sequences, that a thread searches at once.
+};
+
+struct speed_arguments : range_arguments
+{
+   size_t warmup{1};      // The number of untimed passes over all sequences.
+   size_t repetitions{5}; // The number of timed passes over all sequences.
+   bool perf_counters{false}; // Set to true, if hardware events should be counted.
 };
 
 //!\brief Use dna4 instead of default dna5
@@ -103,7 +117,11 @@ void store_ibf(IBFType const & ibf,
 {
     std::ofstream os{opath, std::ios::binary};
     cereal::BinaryOutputArchive oarchive{os};
-    oarchive(seqan3::interleaved_bloom_filter(ibf));
+    // Only compressed ibfs are converted, an uncompressed one would be copied.
+    if constexpr (std::same_as<IBFType, seqan3::interleaved_bloom_filter<seqan3::data_layout::uncompressed>>)
+        oarchive(ibf);
+    else
+        oarchive(seqan3::interleaved_bloom_filter(ibf));
 }
 
 /*! \brief Function that creates the string name of the used view.
@@ -124,6 +142,15 @@ void do_accuracy(accuracy_arguments & args);
  */
 void do_counts(std::vector<std::filesystem::path> sequence_files, range_arguments & args, bool underlying_strobemer = false);
 
+/*! \brief Function, comparing the number of submers of several methods in one pass over the sequence files.
+ *  \param sequence_files A vector of sequence files.
+ *  \param specs The arguments about every method, all of them must use the same output path. Every record is read
+ *               once and the k-mers of every shape are hashed once for all methods. The output files are the ones of
+ *               do_counts for every method.
+ *  \param threads The number of threads to use.
+ */
+void do_counts(std::vector<std::filesystem::path> sequence_files, std::vector<range_arguments> & specs, size_t threads);
+
 /*! \brief Function, comparing the methods in regard of their distance.
  *  \param sequence_file A sequence file.
  *  \param args The arguments about the view to be used.
@@ -143,10 +170,21 @@ void do_match(std::filesystem::path sequence_file1, std::filesystem::path sequen
  *  \param sequence_files A vector of sequence files.
  *  \param args The arguments about the view to be used.
  */
-void do_speed(std::vector<std::filesystem::path> sequence_files, range_arguments & args);
+void do_speed(std::vector<std::filesystem::path> sequence_files, speed_arguments & args);
+
+/*! \brief Function, comparing the speed of several configurations.
+ *  \param sequence_files A vector of sequence files, which are read only once for all configurations.
+ *  \param configurations The arguments about every view to be used, they are measured one after another.
+ */
+void do_speed(std::vector<std::filesystem::path> sequence_files, std::vector<speed_arguments> & configurations);
 
 /*! \brief Function that calculates the uniqueness of submers in given files.
- *  \param input_files A vector of input files. An input file is a count file obtained by counts.
+ *  \param input_files A vector of input files. An input file is a count file or a sample file obtained by counts.
  *  \param oname The name of the output file.
+ *  \param threads The number of threads to use, the files are read in parallel.
+ *  \param cross_file If the submers, that no other file has, should be reported as well. Only count files of the same
+ *                    method are accepted then.
+ *  \throws std::invalid_argument if an input file is not a count file or, with cross_file, a sample file, if the count
+ *                                 files were counted with different methods or their hash values are not sorted.
  */
-void unique(std::vector<std::filesystem::path> input_files, std::filesystem::path oname);
+void unique(std::vector<std::filesystem::path> input_files, std::filesystem::path oname, size_t threads, bool cross_file);
@@ -0,0 +1,365 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::write_count_file and minions::count_file_reader.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <seqan3/std/filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "flat_count_table.hpp"
+#include "parallel.hpp"
+
+namespace minions
+{
+
+/*!\brief The parameters of the method, that produced the hash values of a count file.
+ *
+ * \details
+ *
+ * Two count files can only be combined, if their parameters are equal. Parameters, that the method does not use, are
+ * stored as given on the command line.
+ */
+struct count_file_parameters
+{
+    //!\brief The flags.
+    enum flag : uint8_t
+    {
+        randstrobe = 1,          //!< Randstrobes were used.
+        hybridstrobe = 2,        //!< Hybridstrobes were used.
+        minstrobe = 4,           //!< Minstrobes were used.
+        underlying_strobemer = 8 //!< The method was applied to strobemers instead of k-mers.
+    };
+
+    uint8_t method{};             //!< The method, i.e. the value of `methods`.
+    uint8_t kmer_size{};          //!< The k-mer size.
+    uint8_t order{};              //!< The order of the strobemers.
+    uint8_t flags{};              //!< A combination of minions::count_file_parameters::flag.
+    uint32_t window_size{};       //!< The window size, the modulo for modmers, the s-mer size for syncmers.
+    uint32_t window_min{};        //!< The minimal offset of the strobes.
+    uint32_t window_max{};        //!< The maximal offset of the strobes.
+    uint64_t seed{};              //!< The seed.
+    uint64_t shape{};             //!< The shape as bit pattern.
+    uint64_t syncmer_positions{}; //!< The syncmer positions as bit mask.
+
+    //!\brief Compares all parameters.
+    bool operator==(count_file_parameters const &) const = default;
+};
+
+/*!\brief The header of a count file.
+ *
+ * \details
+ *
+ * A count file consists of this header, followed by `record_count` hash values in ascending order and their
+ * `record_count` counts. All values are stored in the byte order of the machine. The hash values start at an offset of
+ * 64 bytes, so a memory mapping of the file can be read as arrays without copying.
+ */
+struct count_file_header
+{
+    //!\brief The magic bytes, that identify a count file.
+    static constexpr std::array<char, 8> magic_bytes{'M', 'I', 'N', 'I', 'O', 'N', 'S', 'C'};
+    //!\brief The version written by minions::write_count_file.
+    static constexpr uint32_t current_version{1};
+
+    std::array<char, 8> magic{magic_bytes};   //!< Identifies the file.
+    uint32_t version{current_version};        //!< The format version.
+    uint32_t header_size{64};                 //!< The size of the header in bytes.
+    count_file_parameters parameters{};       //!< The method parameters.
+    uint64_t record_count{};                  //!< The number of hash values.
+};
+
+static_assert(sizeof(count_file_parameters) == 40);
+static_assert(sizeof(count_file_header) == 64);
+static_assert(std::is_trivially_copyable_v<count_file_header>);
+
+/*!\brief Writes the header of a count file.
+ * \param[in,out] outfile      The output stream, the caller appends the hash values and counts.
+ * \param[in]     parameters   The method parameters.
+ * \param[in]     record_count The number of hash values, that follow the header.
+ */
+inline void write_count_file_header(std::ostream & outfile,
+                                    count_file_parameters const & parameters,
+                                    uint64_t const record_count)
+{
+    count_file_header header{};
+    header.parameters = parameters;
+    header.record_count = record_count;
+    outfile.write(reinterpret_cast<char const *>(&header), sizeof(header));
+}
+
+/*!\brief Stores hash values and their counts as a count file.
+ * \param[in] path       The output file.
+ * \param[in] parameters The method parameters.
+ * \param[in] hashes     The hash values in ascending order.
+ * \param[in] counts     The counts, `counts[i]` belongs to `hashes[i]`.
+ * \throws std::runtime_error if the file cannot be written.
+ */
+inline void write_count_file(std::filesystem::path const & path,
+                             count_file_parameters const & parameters,
+                             std::span<uint64_t const> const hashes,
+                             std::span<uint16_t const> const counts)
+{
+    std::ofstream outfile{path, std::ios::binary};
+    write_count_file_header(outfile, parameters, hashes.size());
+    outfile.write(reinterpret_cast<char const *>(hashes.data()), hashes.size() * sizeof(uint64_t));
+    outfile.write(reinterpret_cast<char const *>(counts.data()), counts.size() * sizeof(uint16_t));
+    if (!outfile)
+        throw std::runtime_error{"Could not write the count file " + path.string() + "."};
+}
+
+/*!\brief Stores a table of hash values and counts as a count file, sorted by hash value.
+ * \param[in] path       The output file.
+ * \param[in] parameters The method parameters.
+ * \param[in] table      A map from `uint64_t` hash values to `uint16_t` counts.
+ * \throws std::runtime_error if the file cannot be written.
+ */
+template <typename map_t>
+void write_count_file(std::filesystem::path const & path, count_file_parameters const & parameters, map_t const & table)
+{
+    std::vector<std::pair<uint64_t, uint16_t>> records(table.begin(), table.end());
+    std::ranges::sort(records, {}, &std::pair<uint64_t, uint16_t>::first);
+
+    std::vector<uint64_t> hashes(records.size());
+    std::vector<uint16_t> counts(records.size());
+    for (size_t i = 0; i < records.size(); ++i)
+        std::tie(hashes[i], counts[i]) = records[i];
+
+    write_count_file(path, parameters, hashes, counts);
+}
+
+/*!\brief Stores a minions::flat_count_table as a count file, sorted by hash value.
+ * \param[in] path       The output file.
+ * \param[in] parameters The method parameters.
+ * \param[in] table      The table.
+ * \throws std::runtime_error if the file cannot be written.
+ */
+inline void write_count_file(std::filesystem::path const & path,
+                             count_file_parameters const & parameters,
+                             flat_count_table const & table)
+{
+    std::vector<uint64_t> const hashes = table.sorted_hashes();
+    std::vector<uint16_t> counts(hashes.size());
+    for (size_t i = 0; i < hashes.size(); ++i)
+        counts[i] = table.count(hashes[i]);
+
+    write_count_file(path, parameters, hashes, counts);
+}
+
+/*!\brief Reads a count file by mapping it into memory.
+ *
+ * \details
+ *
+ * Files of the current format are not copied, hashes() and counts() point into the memory mapping. Files of the legacy
+ * format, i.e. unsorted pairs of an `uint64_t` hash value and an `uint16_t` count without header, are decoded into
+ * vectors. Their parameters are unknown, see is_legacy().
+ */
+class count_file_reader
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    count_file_reader() = default; //!< Defaulted.
+    count_file_reader(count_file_reader const &) = delete; //!< Deleted, owns the memory mapping.
+    count_file_reader & operator=(count_file_reader const &) = delete; //!< Deleted, owns the memory mapping.
+
+    //!\brief Move constructor.
+    count_file_reader(count_file_reader && other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    //!\brief Move assignment.
+    count_file_reader & operator=(count_file_reader && other) noexcept
+    {
+        std::swap(mapping, other.mapping);
+        std::swap(mapping_size, other.mapping_size);
+        std::swap(header, other.header);
+        std::swap(legacy, other.legacy);
+        std::swap(legacy_hashes, other.legacy_hashes);
+        std::swap(legacy_counts, other.legacy_counts);
+        std::swap(hash_span, other.hash_span);
+        std::swap(count_span, other.count_span);
+        return *this;
+    }
+
+    //!\brief Unmaps the file.
+    ~count_file_reader()
+    {
+        if (mapping != nullptr)
+            munmap(mapping, mapping_size);
+    }
+
+    /*!\brief Maps a count file into memory.
+     * \param[in] path The count file.
+     * \throws std::runtime_error if the file cannot be opened or mapped.
+     * \throws std::invalid_argument if the file is neither a count file nor a legacy count file.
+     */
+    explicit count_file_reader(std::filesystem::path const & path)
+    {
+        int const file_descriptor = open(path.c_str(), O_RDONLY);
+        if (file_descriptor == -1)
+            throw std::runtime_error{"Could not open the count file " + path.string() + "."};
+
+        struct stat file_status{};
+        if (fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0)
+        {
+            mapping_size = file_status.st_size;
+            mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if (mapping == MAP_FAILED)
+                mapping = nullptr;
+        }
+        close(file_descriptor);
+
+        if (mapping_size > 0 && mapping == nullptr)
+            throw std::runtime_error{"Could not map the count file " + path.string() + "."};
+
+        char const * const data = static_cast<char const *>(mapping);
+        try
+        {
+            if (mapping_size >= sizeof(count_file_header) &&
+                std::equal(count_file_header::magic_bytes.begin(), count_file_header::magic_bytes.end(), data))
+                read_current(path, data);
+            else
+                read_legacy(path, data);
+        }
+        catch (...)
+        {
+            // The destructor is not called, if the constructor throws.
+            if (mapping != nullptr)
+                munmap(mapping, mapping_size);
+            throw;
+        }
+    }
+    //!\}
+
+    //!\brief Whether the file is of the legacy format, which does not store parameters.
+    bool is_legacy() const noexcept
+    {
+        return legacy;
+    }
+
+    //!\brief The method parameters, value initialised for legacy files.
+    count_file_parameters const & parameters() const noexcept
+    {
+        return header.parameters;
+    }
+
+    //!\brief The number of hash values.
+    size_t size() const noexcept
+    {
+        return hash_span.size();
+    }
+
+    //!\brief The hash values, sorted unless the file is of the legacy format.
+    std::span<uint64_t const> hashes() const noexcept
+    {
+        return hash_span;
+    }
+
+    //!\brief The counts, `counts()[i]` belongs to `hashes()[i]`.
+    std::span<uint16_t const> counts() const noexcept
+    {
+        return count_span;
+    }
+
+    /*!\brief Sorts the hash values of a legacy file, files of the current format are already sorted.
+     * \param[in] threads The number of threads used for sorting.
+     */
+    void sort(size_t const threads = 1)
+    {
+        if (!legacy || std::ranges::is_sorted(legacy_hashes))
+            return;
+
+        std::vector<std::pair<uint64_t, uint16_t>> records(legacy_hashes.size());
+        for (size_t i = 0; i < records.size(); ++i)
+            records[i] = {legacy_hashes[i], legacy_counts[i]};
+        parallel_sort(std::span{records}, threads);
+        for (size_t i = 0; i < records.size(); ++i)
+            std::tie(legacy_hashes[i], legacy_counts[i]) = records[i];
+    }
+
+private:
+    //!\brief The size of a legacy record.
+    static constexpr size_t legacy_record_size{sizeof(uint64_t) + sizeof(uint16_t)};
+
+    //!\brief The memory mapping, nullptr for empty files.
+    void * mapping{nullptr};
+    //!\brief The size of the memory mapping.
+    size_t mapping_size{0};
+    //!\brief The header, only the parameters are meaningful for legacy files.
+    count_file_header header{};
+    //!\brief Whether the file is of the legacy format.
+    bool legacy{false};
+    //!\brief The decoded hash values of a legacy file.
+    std::vector<uint64_t> legacy_hashes{};
+    //!\brief The decoded counts of a legacy file.
+    std::vector<uint16_t> legacy_counts{};
+    //!\brief The hash values.
+    std::span<uint64_t const> hash_span{};
+    //!\brief The counts.
+    std::span<uint16_t const> count_span{};
+
+    //!\brief Checks the header and points the spans into the mapping.
+    void read_current(std::filesystem::path const & path, char const * const data)
+    {
+        std::memcpy(&header, data, sizeof(header));
+        if (header.version != count_file_header::current_version || header.header_size != sizeof(count_file_header))
+            throw std::invalid_argument{"The count file " + path.string() + " has the unsupported version " +
+                                        std::to_string(header.version) + "."};
+        if (mapping_size != header.header_size + header.record_count * legacy_record_size)
+            throw std::invalid_argument{"The count file " + path.string() + " is truncated."};
+
+        uint64_t const * const hashes = reinterpret_cast<uint64_t const *>(data + header.header_size);
+        hash_span = {hashes, header.record_count};
+        count_span = {reinterpret_cast<uint16_t const *>(hashes + header.record_count), header.record_count};
+    }
+
+    //!\brief Decodes the records of a legacy file.
+    void read_legacy(std::filesystem::path const & path, char const * const data)
+    {
+        if (mapping_size % legacy_record_size != 0)
+            throw std::invalid_argument{"The file " + path.string() + " is not a count file."};
+
+        legacy = true;
+        size_t const record_count = mapping_size / legacy_record_size;
+        legacy_hashes.resize(record_count);
+        legacy_counts.resize(record_count);
+        for (size_t i = 0; i < record_count; ++i)
+        {
+            std::memcpy(&legacy_hashes[i], data + i * legacy_record_size, sizeof(uint64_t));
+            std::memcpy(&legacy_counts[i], data + i * legacy_record_size + sizeof(uint64_t), sizeof(uint16_t));
+        }
+        hash_span = legacy_hashes;
+        count_span = legacy_counts;
+
+        if (mapping != nullptr)
+            munmap(mapping, mapping_size);
+        mapping = nullptr;
+    }
+};
+
+} // namespace minions
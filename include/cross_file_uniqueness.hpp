@@ -0,0 +1,177 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::cross_file_uniqueness.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "count_file.hpp"
+#include "parallel.hpp"
+
+namespace minions
+{
+
+//!\brief The number of distinct hash values, of those with a count of 1 and of those, that occur in one file only.
+struct uniqueness_counts
+{
+    uint64_t distinct{};   //!< The number of distinct hash values.
+    uint64_t singletons{}; //!< The number of hash values with a count of 1.
+    uint64_t exclusive{};  //!< The number of hash values, that occur in one file only.
+
+    //!\brief Adds the numbers of another range of hash values.
+    uniqueness_counts & operator+=(uniqueness_counts const & other) noexcept
+    {
+        distinct += other.distinct;
+        singletons += other.singletons;
+        exclusive += other.exclusive;
+        return *this;
+    }
+
+    //!\brief Compares all numbers.
+    bool operator==(uniqueness_counts const &) const = default;
+};
+
+//!\brief The result of minions::cross_file_uniqueness.
+struct cross_file_uniqueness_result
+{
+    /*!\brief The numbers of every file.
+     *
+     * \details
+     *
+     * `singletons` counts the hash values with a count of 1 in the file, `exclusive` those, that no other file has.
+     */
+    std::vector<uniqueness_counts> files{};
+
+    /*!\brief The numbers of all files together.
+     *
+     * \details
+     *
+     * `distinct` counts the hash values of all files, `singletons` those with a count of 1 summed over all files and
+     * `exclusive` those, that occur in one file only.
+     */
+    uniqueness_counts all{};
+};
+
+/*!\brief Determines the hash values, that are unique within a file and across files, in one pass.
+ * \param[in] files   The count files, their hash values must be sorted, see minions::count_file_reader::sort().
+ * \param[in] threads The number of threads to use.
+ * \returns The numbers of every file and of all files together.
+ * \throws std::invalid_argument if the hash values of a file are not strictly ascending.
+ *
+ * \details
+ *
+ * The hash values of all files are merged in ascending order, so every hash value is seen once with the counts of all
+ * files, that have it. The range of hash values is split at quantiles of the files into more parts than threads and the
+ * parts are merged in parallel, which gives the same result for any number of threads.
+ */
+inline cross_file_uniqueness_result cross_file_uniqueness(std::vector<count_file_reader> const & files,
+                                                          size_t const threads = 1)
+{
+    parallel_for(files.size(), threads, [&] (size_t const f)
+    {
+        if (std::ranges::adjacent_find(files[f].hashes(), std::ranges::greater_equal{}) != files[f].hashes().end())
+            throw std::invalid_argument{"The hash values of count file " + std::to_string(f + 1) +
+                                        " are not sorted."};
+    });
+
+    // Every file contributes evenly spaced hash values, the splitters are evenly spaced among all of them.
+    size_t const parts = std::max<size_t>(threads, 1u) * 4u;
+    std::vector<uint64_t> samples{};
+    for (count_file_reader const & file : files)
+        for (size_t p = 1; p < parts && !file.hashes().empty(); ++p)
+            samples.push_back(file.hashes()[p * file.size() / parts]);
+    std::ranges::sort(samples);
+
+    std::vector<uint64_t> splitters{};
+    for (size_t p = 1; p < parts && !samples.empty(); ++p)
+        splitters.push_back(samples[p * samples.size() / parts]);
+    auto const duplicates = std::ranges::unique(splitters);
+    splitters.erase(duplicates.begin(), duplicates.end());
+
+    cross_file_uniqueness_result result{};
+    result.files.resize(files.size());
+    std::mutex result_mutex{};
+
+    parallel_for(splitters.size() + 1, threads, [&] (size_t const part)
+    {
+        // Part p covers the hash values from splitter p - 1 up to splitter p, the position of a splitter in a file is
+        // that of its first hash value not less than the splitter.
+        auto begin_of = [&] (std::span<uint64_t const> const hashes, size_t const splitter)
+        {
+            if (splitter == 0)
+                return size_t{0};
+            if (splitter > splitters.size())
+                return hashes.size();
+            return static_cast<size_t>(std::ranges::lower_bound(hashes, splitters[splitter - 1]) - hashes.begin());
+        };
+
+        using entry = std::pair<uint64_t, size_t>;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue{};
+        std::vector<size_t> positions(files.size());
+        std::vector<size_t> ends(files.size());
+        for (size_t f = 0; f < files.size(); ++f)
+        {
+            positions[f] = begin_of(files[f].hashes(), part);
+            ends[f] = begin_of(files[f].hashes(), part + 1);
+            if (positions[f] < ends[f])
+                queue.emplace(files[f].hashes()[positions[f]], f);
+        }
+
+        std::vector<uniqueness_counts> local_files(files.size());
+        uniqueness_counts local_all{};
+        while (!queue.empty())
+        {
+            uint64_t const hash = queue.top().first;
+            size_t const first_file = queue.top().second;
+            size_t number_of_files{0};
+            uint64_t total{0};
+
+            while (!queue.empty() && queue.top().first == hash)
+            {
+                size_t const f = queue.top().second;
+                queue.pop();
+                uint16_t const count = files[f].counts()[positions[f]];
+                ++number_of_files;
+                total += count;
+                ++local_files[f].distinct;
+                local_files[f].singletons += count == 1u;
+                if (++positions[f] < ends[f])
+                    queue.emplace(files[f].hashes()[positions[f]], f);
+            }
+
+            ++local_all.distinct;
+            if (number_of_files == 1u)
+            {
+                ++local_files[first_file].exclusive;
+                ++local_all.exclusive;
+            }
+            local_all.singletons += total == 1u;
+        }
+
+        std::lock_guard<std::mutex> lock{result_mutex};
+        for (size_t f = 0; f < files.size(); ++f)
+            result.files[f] += local_files[f];
+        result.all += local_all;
+    });
+
+    return result;
+}
+
+} // namespace minions
@@ -0,0 +1,196 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::flat_count_table.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "hash_policy.hpp"
+
+namespace minions
+{
+
+/*!\brief A count table for hash values, that stores the hash values and counts in two flat arrays.
+ *
+ * \details
+ *
+ * The table uses open addressing with linear probing on a power of two number of slots. A slot takes 10 bytes and the
+ * table holds at most three entries per four slots, so an entry takes between 13 and 27 bytes, in contrast to the
+ * separately allocated nodes of a node based map. A slot with a count of 0 is empty, therefore every hash value,
+ * including 0, can be stored. Counts saturate at `max_count`, like the counts stored by `minions counts`.
+ */
+class flat_count_table
+{
+public:
+    //!\brief The largest stored count.
+    static constexpr uint16_t max_count{65534u};
+    //!\brief The memory of one slot in bytes.
+    static constexpr size_t bytes_per_slot{sizeof(uint64_t) + sizeof(uint16_t)};
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    flat_count_table() = default; //!< Defaulted.
+    flat_count_table(flat_count_table const &) = default; //!< Defaulted.
+    flat_count_table(flat_count_table &&) = default; //!< Defaulted.
+    flat_count_table & operator=(flat_count_table const &) = default; //!< Defaulted.
+    flat_count_table & operator=(flat_count_table &&) = default; //!< Defaulted.
+    ~flat_count_table() = default; //!< Defaulted.
+
+    /*!\brief Construct a table, that holds `expected_size` entries without growing.
+     * \param[in] expected_size The expected number of distinct hash values.
+     */
+    explicit flat_count_table(size_t const expected_size)
+    {
+        reserve(expected_size);
+    }
+    //!\}
+
+    //!\brief Returns the number of slots needed for `size` entries.
+    static constexpr size_t slots_for(size_t const size) noexcept
+    {
+        return std::bit_ceil(std::max<size_t>(16u, (size * 4 + 2) / 3));
+    }
+
+    //!\brief Returns the number of entries, that fit into `slots` slots.
+    static constexpr size_t max_size_for(size_t const slots) noexcept
+    {
+        return slots / 4 * 3;
+    }
+
+    //!\brief Grows the table, so it holds `size` entries without growing again.
+    void reserve(size_t const size)
+    {
+        if (slots_for(size) > capacity())
+            rehash(slots_for(size));
+    }
+
+    /*!\brief Adds occurrences of a hash value.
+     * \param[in] hash  The hash value.
+     * \param[in] count The number of occurrences.
+     */
+    void add(uint64_t const hash, uint16_t const count = 1)
+    {
+        if (count == 0)
+            return;
+
+        // The table only grows for a new hash value, a full table still counts the hash values it has.
+        size_t slot = capacity() == 0 ? 0 : find(hash);
+        if (capacity() == 0 || counts[slot] == 0)
+        {
+            if (number_of_entries + 1 > max_size_for(capacity()))
+            {
+                rehash(std::max<size_t>(16u, capacity() * 2));
+                slot = find(hash);
+            }
+            hashes[slot] = hash;
+            ++number_of_entries;
+        }
+        counts[slot] = std::min<uint32_t>(max_count, uint32_t{counts[slot]} + count);
+    }
+
+    //!\brief Returns the count of a hash value, 0 if it was not added.
+    uint16_t count(uint64_t const hash) const noexcept
+    {
+        return capacity() == 0 ? 0 : counts[find(hash)];
+    }
+
+    //!\brief Whether a hash value was added.
+    bool contains(uint64_t const hash) const noexcept
+    {
+        return count(hash) != 0;
+    }
+
+    //!\brief Returns the number of distinct hash values.
+    size_t size() const noexcept
+    {
+        return number_of_entries;
+    }
+
+    //!\brief Returns the number of slots.
+    size_t capacity() const noexcept
+    {
+        return counts.size();
+    }
+
+    //!\brief Removes all entries and frees the memory.
+    void clear()
+    {
+        *this = flat_count_table{};
+    }
+
+    /*!\brief Calls `callback(hash, count)` for every entry, in no particular order.
+     * \param[in] callback The callback.
+     */
+    template <typename callback_t>
+    void for_each(callback_t && callback) const
+    {
+        for (size_t slot = 0; slot < capacity(); ++slot)
+            if (counts[slot] != 0)
+                callback(hashes[slot], counts[slot]);
+    }
+
+    //!\brief Returns all hash values in ascending order.
+    std::vector<uint64_t> sorted_hashes() const
+    {
+        std::vector<uint64_t> result{};
+        result.reserve(size());
+        for_each([&] (uint64_t const hash, uint16_t) { result.push_back(hash); });
+        std::ranges::sort(result);
+        return result;
+    }
+
+private:
+    //!\brief The hash values, only meaningful for slots with a count other than 0.
+    std::vector<uint64_t> hashes{};
+    //!\brief The counts, 0 for empty slots.
+    std::vector<uint16_t> counts{};
+    //!\brief The number of entries.
+    size_t number_of_entries{0};
+
+    //!\brief Returns the home slot of a hash value, k-mer hashes need to be mixed to use all bits.
+    size_t home_slot(uint64_t const hash) const noexcept
+    {
+        return murmur_hash_policy{}(hash, 0u) & (capacity() - 1);
+    }
+
+    //!\brief Returns the slot of a hash value, or the empty slot where it would be inserted.
+    size_t find(uint64_t const hash) const noexcept
+    {
+        size_t slot = home_slot(hash);
+        while (counts[slot] != 0 && hashes[slot] != hash)
+            slot = (slot + 1) & (capacity() - 1);
+        return slot;
+    }
+
+    //!\brief Moves all entries into a table of `slots` slots.
+    void rehash(size_t const slots)
+    {
+        std::vector<uint64_t> old_hashes = std::exchange(hashes, std::vector<uint64_t>(slots));
+        std::vector<uint16_t> old_counts = std::exchange(counts, std::vector<uint16_t>(slots));
+        for (size_t slot = 0; slot < old_counts.size(); ++slot)
+        {
+            if (old_counts[slot] != 0)
+            {
+                size_t const new_slot = find(old_hashes[slot]);
+                hashes[new_slot] = old_hashes[slot];
+                counts[new_slot] = old_counts[slot];
+            }
+        }
+    }
+};
+
+} // namespace minions
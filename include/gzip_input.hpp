@@ -0,0 +1,333 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::gzip_input.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <optional>
+#include <seqan3/std/filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <zlib.h>
+
+#include "mapped_file.hpp"
+#include "parallel.hpp"
+
+namespace minions
+{
+
+namespace detail
+{
+
+//!\brief Reads a little endian number of `size` bytes.
+inline uint32_t read_little_endian(char const * const data, size_t const size) noexcept
+{
+    uint32_t value{0};
+    for (size_t i = 0; i < size; ++i)
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << (8 * i);
+    return value;
+}
+
+/*!\brief Returns the size of the BGZF block at the start of the data.
+ * \param[in] data The compressed data.
+ * \returns The size of the block including header and footer, 0 if the data does not start with a gzip header with the
+ *          `BC` extra field of the BGZF format, see the SAM specification.
+ */
+inline size_t bgzf_block_size(std::span<char const> const data) noexcept
+{
+    if (data.size() < 18 || static_cast<uint8_t>(data[0]) != 0x1F || static_cast<uint8_t>(data[1]) != 0x8B ||
+        data[2] != 8 || (data[3] & 4) == 0)
+        return 0;
+
+    size_t const extra_end = 12 + read_little_endian(data.data() + 10, 2);
+    if (data.size() < extra_end)
+        return 0;
+    for (size_t field = 12; field + 4 <= extra_end;)
+    {
+        size_t const field_size = read_little_endian(data.data() + field + 2, 2);
+        if (data[field] == 'B' && data[field + 1] == 'C' && field_size == 2 && field + 6 <= extra_end)
+            return read_little_endian(data.data() + field + 4, 2) + 1;
+        field += 4 + field_size;
+    }
+    return 0;
+}
+
+//!\brief Releases the memory of a zlib stream.
+struct inflate_guard
+{
+    //!\brief The stream.
+    z_stream & stream;
+
+    //!\brief Calls `inflateEnd`.
+    ~inflate_guard()
+    {
+        inflateEnd(&stream);
+    }
+};
+
+} // namespace detail
+
+/*!\brief Decompresses a gzip file on background threads, while the caller processes the decompressed content.
+ *
+ * \details
+ *
+ * Files in the BGZF format, i.e. gzip files made of independent blocks as written by `bgzip`, are decompressed in
+ * groups of blocks, whose blocks are inflated in parallel. Other gzip files, also of several concatenated members, are
+ * inflated sequentially by one thread. In both cases, the decompression runs ahead of the caller by at most two
+ * chunks.
+ */
+class gzip_input
+{
+public:
+    //!\brief The size of the chunks of gzip files, that are not in the BGZF format.
+    static constexpr size_t chunk_size{1ULL << 22};
+    //!\brief The decompressed size of the blocks of a group per thread, for files in the BGZF format.
+    static constexpr size_t bgzf_bytes_per_thread{1ULL << 20};
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    gzip_input() = delete; //!< Deleted.
+    gzip_input(gzip_input const &) = delete; //!< Deleted, the background thread refers to the object.
+    gzip_input(gzip_input &&) = delete; //!< Deleted, the background thread refers to the object.
+    gzip_input & operator=(gzip_input const &) = delete; //!< Deleted, the background thread refers to the object.
+    gzip_input & operator=(gzip_input &&) = delete; //!< Deleted, the background thread refers to the object.
+
+    /*!\brief Starts the decompression.
+     * \param[in] file    The compressed file, see is_gzip().
+     * \param[in] path    The path of the file, for error messages.
+     * \param[in] threads The number of threads, that inflate the blocks of a file in the BGZF format.
+     */
+    gzip_input(mapped_file file, std::filesystem::path path, size_t const threads) :
+        file{std::move(file)},
+        path{std::move(path)},
+        threads{std::max<size_t>(threads, 1u)},
+        bgzf{detail::bgzf_block_size(this->file.data()) != 0}
+    {
+        producer = std::thread{[this] ()
+        {
+            try
+            {
+                if (bgzf)
+                    inflate_bgzf();
+                else
+                    inflate_gzip();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+            chunks.close();
+        }};
+    }
+
+    //!\brief Stops the decompression.
+    ~gzip_input()
+    {
+        chunks.close();
+        producer.join();
+    }
+    //!\}
+
+    //!\brief Whether the data starts with the magic bytes of gzip.
+    static bool is_gzip(std::span<char const> const data) noexcept
+    {
+        return data.size() >= 2 && static_cast<uint8_t>(data[0]) == 0x1F && static_cast<uint8_t>(data[1]) == 0x8B;
+    }
+
+    //!\brief Whether the file is in the BGZF format.
+    bool is_bgzf() const noexcept
+    {
+        return bgzf;
+    }
+
+    /*!\brief Waits for the next chunk of the decompressed content.
+     * \returns The chunk, std::nullopt at the end of the file.
+     * \throws std::runtime_error if the file is not a valid gzip file.
+     */
+    std::optional<std::vector<char>> next()
+    {
+        std::optional<std::vector<char>> chunk = chunks.pop();
+        if (!chunk && error)
+            std::rethrow_exception(error);
+        return chunk;
+    }
+
+private:
+    //!\brief A BGZF block.
+    struct block
+    {
+        //!\brief The position of the compressed data in the file.
+        size_t begin{};
+        //!\brief The size of the compressed data.
+        size_t size{};
+        //!\brief The position of the decompressed data in the chunk.
+        size_t offset{};
+        //!\brief The size of the decompressed data.
+        uint32_t inflated_size{};
+        //!\brief The CRC32 of the decompressed data.
+        uint32_t crc{};
+    };
+
+    //!\brief The compressed file.
+    mapped_file file;
+    //!\brief The path of the file.
+    std::filesystem::path path;
+    //!\brief The number of threads for files in the BGZF format.
+    size_t threads;
+    //!\brief Whether the file is in the BGZF format.
+    bool bgzf;
+    //!\brief The decompressed chunks.
+    bounded_queue<std::vector<char>> chunks{2};
+    //!\brief The exception of the background thread, which is rethrown by next().
+    std::exception_ptr error{};
+    //!\brief The background thread.
+    std::thread producer{};
+
+    //!\brief Throws the std::runtime_error for an invalid file.
+    [[noreturn]] void throw_invalid(std::string const & problem) const
+    {
+        throw std::runtime_error{"The gzip file " + path.string() + " " + problem + "."};
+    }
+
+    //!\brief Inflates all members of a gzip file one after another.
+    void inflate_gzip()
+    {
+        std::span<char const> const input = file.data();
+        z_stream stream{};
+        if (inflateInit2(&stream, 15 + 16) != Z_OK)
+            throw_invalid("cannot be decompressed");
+        detail::inflate_guard const guard{stream};
+
+        // zlib counts the input with 32 bits, so large files are passed in pieces.
+        constexpr size_t piece_size{1ULL << 30};
+        size_t consumed{0};
+        std::vector<char> chunk(chunk_size);
+        size_t filled{0};
+        while (true)
+        {
+            if (stream.avail_in == 0 && consumed < input.size())
+            {
+                size_t const piece = std::min(piece_size, input.size() - consumed);
+                stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data() + consumed));
+                stream.avail_in = piece;
+                consumed += piece;
+            }
+            stream.next_out = reinterpret_cast<Bytef *>(chunk.data() + filled);
+            stream.avail_out = chunk.size() - filled;
+
+            int const status = inflate(&stream, Z_NO_FLUSH);
+            filled = chunk.size() - stream.avail_out;
+            if (status == Z_STREAM_END)
+            {
+                // Another member may follow, trailing bytes that are no gzip header are ignored like gzip does.
+                size_t const remaining = stream.avail_in + (input.size() - consumed);
+                std::span<char const> const next_member{input.data() + input.size() - remaining, remaining};
+                if (!is_gzip(next_member))
+                    break;
+                inflateReset(&stream);
+            }
+            else if (status == Z_BUF_ERROR && stream.avail_in == 0 && consumed == input.size())
+            {
+                throw_invalid("ends unexpectedly");
+            }
+            else if (status != Z_OK)
+            {
+                throw_invalid("is corrupted");
+            }
+
+            if (filled == chunk.size())
+            {
+                if (!chunks.push(std::move(chunk)))
+                    return;
+                chunk = std::vector<char>(chunk_size);
+                filled = 0;
+            }
+        }
+
+        if (filled > 0)
+        {
+            chunk.erase(chunk.begin() + filled, chunk.end());
+            chunks.push(std::move(chunk));
+        }
+    }
+
+    //!\brief Inflates groups of BGZF blocks, the blocks of a group in parallel.
+    void inflate_bgzf()
+    {
+        std::span<char const> const input = file.data();
+        size_t const group_size = threads * bgzf_bytes_per_thread;
+        std::vector<block> blocks{};
+        size_t position{0};
+        while (position < input.size())
+        {
+            blocks.clear();
+            size_t inflated{0};
+            while (position < input.size() && inflated < group_size)
+            {
+                std::span<char const> const rest = input.subspan(position);
+                size_t const block_size = detail::bgzf_block_size(rest);
+                if (block_size == 0)
+                    throw_invalid("has an invalid BGZF block at byte " + std::to_string(position));
+                size_t const header_size = 12 + detail::read_little_endian(rest.data() + 10, 2);
+                if (block_size > rest.size() || block_size < header_size + 8)
+                    throw_invalid("has an invalid BGZF block at byte " + std::to_string(position));
+
+                block const current{position + header_size,
+                                    block_size - header_size - 8,
+                                    inflated,
+                                    detail::read_little_endian(rest.data() + block_size - 4, 4),
+                                    detail::read_little_endian(rest.data() + block_size - 8, 4)};
+                // Empty blocks, e.g. the end-of-file marker, have nothing to inflate and may form a group of their own.
+                if (current.inflated_size > 0)
+                    blocks.push_back(current);
+                inflated += current.inflated_size;
+                position += block_size;
+            }
+
+            std::vector<char> chunk(inflated);
+            parallel_for(blocks.size(), threads, [&] (size_t const b)
+            {
+                inflate_block(blocks[b], chunk);
+            });
+            if (!chunk.empty() && !chunks.push(std::move(chunk)))
+                return;
+        }
+    }
+
+    //!\brief Inflates one BGZF block into its place in the chunk and checks its size and CRC32.
+    void inflate_block(block const & b, std::vector<char> & chunk) const
+    {
+        z_stream stream{};
+        if (inflateInit2(&stream, -15) != Z_OK)
+            throw_invalid("cannot be decompressed");
+        detail::inflate_guard const guard{stream};
+
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(file.data().data() + b.begin));
+        stream.avail_in = b.size;
+        stream.next_out = reinterpret_cast<Bytef *>(chunk.data() + b.offset);
+        stream.avail_out = b.inflated_size;
+        Bytef const * const out = stream.next_out;
+        if (inflate(&stream, Z_FINISH) != Z_STREAM_END || stream.avail_out != 0 ||
+            crc32(0, out, b.inflated_size) != b.crc)
+            throw_invalid("has a corrupted BGZF block at byte " + std::to_string(b.begin));
+    }
+};
+
+} // namespace minions
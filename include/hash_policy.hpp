@@ -0,0 +1,145 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides the seeded hash policies used by the minions views.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstdint>
+
+namespace minions
+{
+
+/*!\brief A hash policy transforms a hash value with a seed, i.e. `policy(hash_value, seed)` returns a new hash value.
+ *
+ * \details
+ *
+ * A policy is a stateless, default constructible function object. All policies in this file are constexpr and do not
+ * allocate.
+ */
+template <typename policy_t>
+concept hash_policy = std::default_initializable<policy_t> && std::copy_constructible<policy_t> &&
+                      requires (policy_t const & policy, uint64_t const value, uint64_t const seed)
+{
+    { policy(value, seed) } -> std::convertible_to<uint64_t>;
+};
+
+/*!\brief XOR of hash value and seed, the seed transform of all *_hash views.
+ *
+ * \details
+ *
+ * This is a bijection for every seed, but neighbouring k-mers stay neighbours.
+ */
+struct xor_hash_policy
+{
+    //!\brief Returns `hash_value ^ seed`.
+    constexpr uint64_t operator()(uint64_t const hash_value, uint64_t const seed) const noexcept
+    {
+        return hash_value ^ seed;
+    }
+};
+
+/*!\brief The FNV based hash of former versions of minions, used by the modmers.
+ *
+ * \details
+ *
+ * The decimal representation of the hash value is multiplied in with the FNV-1 prime, starting from the hash value
+ * itself. If the seed is 0, the hash value is returned unchanged, any other seed results in the same hash value.
+ * The digits are produced on the stack, so the results are identical to the former string based implementation
+ * without allocating memory.
+ */
+struct fnv_hash_policy
+{
+    //!\brief Returns the FNV hash of the decimal representation of `hash_value`.
+    constexpr uint64_t operator()(uint64_t const hash_value, uint64_t const seed) const noexcept
+    {
+        // If seed is 0, then the hash value is just returned.
+        if (seed == 0)
+            return hash_value;
+
+        constexpr uint64_t prime = 0x100000001b3;
+
+        // A 64 bit value has at most 20 decimal digits, they are generated from the last one.
+        char digits[20]{};
+        int number_of_digits{0};
+        uint64_t value = hash_value;
+        do
+        {
+            digits[number_of_digits++] = '0' + value % 10;
+            value /= 10;
+        } while (value != 0);
+
+        uint64_t hashed = hash_value;
+        while (number_of_digits > 0)
+        {
+            hashed = hashed * prime;
+            hashed = hashed ^ digits[--number_of_digits];
+        }
+
+        return hashed;
+    }
+};
+
+/*!\brief The finalizer of splitmix64, applied to the sum of hash value and seed.
+ *
+ * \details
+ *
+ * Bijective for every seed. See http://xorshift.di.unimi.it/splitmix64.c
+ */
+struct splitmix_hash_policy
+{
+    //!\brief Returns splitmix64 of `hash_value + seed`.
+    constexpr uint64_t operator()(uint64_t const hash_value, uint64_t const seed) const noexcept
+    {
+        uint64_t z = hash_value + seed + 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+};
+
+/*!\brief The 64 bit finalizer of MurmurHash3, applied to the XOR of hash value and seed.
+ *
+ * \details
+ *
+ * Bijective for every seed. See https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+ */
+struct murmur_hash_policy
+{
+    //!\brief Returns fmix64 of `hash_value ^ seed`.
+    constexpr uint64_t operator()(uint64_t const hash_value, uint64_t const seed) const noexcept
+    {
+        uint64_t z = hash_value ^ seed;
+        z = (z ^ (z >> 33)) * 0xff51afd7ed558ccdULL;
+        z = (z ^ (z >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+        return z ^ (z >> 33);
+    }
+};
+
+/*!\brief The 128 bit multiply-and-fold mixer of wyhash, of hash value and seed.
+ *
+ * \details
+ *
+ * The fastest of the policies on 64 bit platforms, but not a bijection, i.e. different hash values may collide.
+ * See https://github.com/wangyi-fudan/wyhash
+ */
+struct wyhash_hash_policy
+{
+    //!\brief Returns the folded 128 bit product of `hash_value` and `seed`, both XORed with the wyhash secrets.
+    constexpr uint64_t operator()(uint64_t const hash_value, uint64_t const seed) const noexcept
+    {
+        unsigned __int128 const product = static_cast<unsigned __int128>(hash_value ^ 0xa0761d6478bd642fULL) *
+                                          (seed ^ 0xe7037ed1a0b428dbULL);
+        return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+    }
+};
+
+} // namespace minions
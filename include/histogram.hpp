@@ -0,0 +1,152 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::histogram.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <vector>
+
+namespace minions
+{
+
+/*!\brief Counts how often each value occurs, without storing the values.
+ *
+ * \details
+ *
+ * Values smaller than `dense_size` are counted in an array, which grows up to the largest value seen, larger values
+ * in an ordered map. Histograms of different threads can be combined with merge(), the result does not depend on the
+ * order of the merges.
+ */
+class histogram
+{
+public:
+    //!\brief Values below are counted in the array.
+    static constexpr uint64_t dense_size{1ULL << 16};
+
+    //!\brief Adds `count` occurrences of `value`.
+    void add(uint64_t const value, uint64_t const count = 1)
+    {
+        if (value < dense_size)
+        {
+            if (value >= dense.size())
+                dense.resize(value + 1, 0);
+            dense[value] += count;
+        }
+        else
+        {
+            overflow[value] += count;
+        }
+    }
+
+    //!\brief Adds all occurrences of another histogram.
+    void merge(histogram const & other)
+    {
+        if (other.dense.size() > dense.size())
+            dense.resize(other.dense.size(), 0);
+        for (size_t value = 0; value < other.dense.size(); ++value)
+            dense[value] += other.dense[value];
+        for (auto const & [value, count] : other.overflow)
+            overflow[value] += count;
+    }
+
+    //!\brief Calls `visitor(value, count)` for every value that occurred, in ascending order.
+    template <typename visitor_t>
+    void for_each(visitor_t && visitor) const
+    {
+        for (size_t value = 0; value < dense.size(); ++value)
+            if (dense[value] > 0)
+                visitor(static_cast<uint64_t>(value), dense[value]);
+        for (auto const & [value, count] : overflow)
+            visitor(value, count);
+    }
+
+    //!\brief The number of occurrences of all values.
+    uint64_t size() const
+    {
+        uint64_t total{0};
+        for_each([&] (uint64_t, uint64_t const count) { total += count; });
+        return total;
+    }
+
+    //!\brief The smallest value, 0 if empty.
+    uint64_t min() const
+    {
+        uint64_t result{0};
+        bool first{true};
+        for_each([&] (uint64_t const value, uint64_t)
+        {
+            result = first ? value : result;
+            first = false;
+        });
+        return result;
+    }
+
+    //!\brief The largest value, 0 if empty.
+    uint64_t max() const
+    {
+        uint64_t result{0};
+        for_each([&] (uint64_t const value, uint64_t) { result = value; });
+        return result;
+    }
+
+    //!\brief The mean of all occurrences.
+    double mean() const
+    {
+        double sum{0.0};
+        for_each([&] (uint64_t const value, uint64_t const count) { sum += static_cast<double>(value) * count; });
+        return sum / size();
+    }
+
+    //!\brief The standard deviation of all occurrences.
+    double standard_deviation() const
+    {
+        double const average = mean();
+        double sum{0.0};
+        for_each([&] (uint64_t const value, uint64_t const count)
+        {
+            sum += (value - average) * (value - average) * count;
+        });
+        return std::sqrt(sum / size());
+    }
+
+    //!\brief The mean of the squares of all occurrences.
+    double mean_square() const
+    {
+        double sum{0.0};
+        for_each([&] (uint64_t const value, uint64_t const count)
+        {
+            sum += static_cast<double>(value) * value * count;
+        });
+        return sum / size();
+    }
+
+    //!\brief Writes one line `value\tcount` for every value that occurred, in ascending order.
+    friend std::ostream & operator<<(std::ostream & stream, histogram const & hist)
+    {
+        hist.for_each([&] (uint64_t const value, uint64_t const count)
+        {
+            stream << value << "\t" << count << "\n";
+        });
+        return stream;
+    }
+
+private:
+    //!\brief The counts of values below `dense_size`.
+    std::vector<uint64_t> dense{};
+    //!\brief The counts of larger values.
+    std::map<uint64_t, uint64_t> overflow{};
+};
+
+} // namespace minions
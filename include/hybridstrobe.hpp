@@ -244,8 +244,8 @@ public:
           window_dist{std::move(it.window_dist)},
           window_size{std::move(it.window_size)},
           multiplicator{std::move(it.multiplicator)},
-          multiplicator3{std::move(it.multiplicator3)}
-
+          multiplicator3{std::move(it.multiplicator3)},
+          first_position{it.first_position}
     {}
 
     /*!\brief Construct from begin iterator and end iterator of a given range over std::totally_ordered values, and the
@@ -445,6 +445,12 @@ public:
         return hybridstrobe_value;
     }
 
+    //!\brief Return the position of the hybridstrobe, i.e. of its first strobe.
+    size_t position() const noexcept
+    {
+        return first_position;
+    }
+
 private:
     //!\brief The hybridstrobe value.
     value_type hybridstrobe_value{};
@@ -485,10 +491,14 @@ private:
     //!\brief The multiplicator for order 3.
     uint64_t multiplicator3{};
 
+    //!\brief The position of first_iterator.
+    size_t first_position{};
+
     //!\brief Advances the window of the iterators to the next position.
     void advance_windows()
     {
         ++first_iterator;
+        ++first_position;
         ++second_iterator;
 
         if constexpr(order_3)
@@ -0,0 +1,240 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::hyperloglog.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "batch_kernels.hpp"
+#include "hash_policy.hpp"
+
+namespace minions
+{
+
+namespace detail
+{
+
+//!\brief `target[i] = std::max(target[i], source[i])` for all i < size.
+inline void max_registers_scalar(uint8_t * const target, uint8_t const * const source, size_t const size) noexcept
+{
+    for (size_t i = 0; i < size; ++i)
+        target[i] = std::max(target[i], source[i]);
+}
+
+#if MINIONS_X86_KERNELS
+/*!\name x86 kernels
+ * \{
+ */
+__attribute__((target("sse4.2")))
+inline void max_registers_sse4_2(uint8_t * const target, uint8_t const * const source, size_t const size) noexcept
+{
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i const a = _mm_loadu_si128(reinterpret_cast<__m128i const *>(target + i));
+        __m128i const b = _mm_loadu_si128(reinterpret_cast<__m128i const *>(source + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(target + i), _mm_max_epu8(a, b));
+    }
+    max_registers_scalar(target + i, source + i, size - i);
+}
+
+__attribute__((target("avx2")))
+inline void max_registers_avx2(uint8_t * const target, uint8_t const * const source, size_t const size) noexcept
+{
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(target + i));
+        __m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(source + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(target + i), _mm256_max_epu8(a, b));
+    }
+    max_registers_scalar(target + i, source + i, size - i);
+}
+//!\}
+#endif
+
+/*!\brief `target[i] = std::max(target[i], source[i])` for all i < size.
+ * \param[in,out] target The registers, that are merged into.
+ * \param[in]     source The registers, that are merged.
+ * \param[in]     size   The number of registers.
+ * \param[in]     level  The instruction set to use, must be supported by the CPU.
+ */
+inline void max_registers(uint8_t * const target,
+                          uint8_t const * const source,
+                          size_t const size,
+                          simd_level const level = supported_simd_level()) noexcept
+{
+#if MINIONS_X86_KERNELS
+    if (level == simd_level::avx2)
+        return max_registers_avx2(target, source, size);
+    if (level == simd_level::sse4_2)
+        return max_registers_sse4_2(target, source, size);
+#endif
+    max_registers_scalar(target, source, size);
+}
+
+} // namespace detail
+
+/*!\brief Estimates the number of distinct hash values with a HyperLogLog sketch.
+ *
+ * \details
+ *
+ * The sketch has `2^precision` registers of one byte. A hash value is mixed with minions::murmur_hash_policy, its
+ * first `precision` bits select a register and the register keeps the largest position of the first set bit among the
+ * remaining bits. The estimate has a relative standard error of about `1.04 / sqrt(2^precision)`, e.g. 1.6% for the
+ * default precision of 12, which needs 4 KiB, and is computed from the histogram of the registers, which keeps it
+ * unbiased from small to large numbers.
+ *
+ * Sketches of the same precision are merged by the maximum of every register, which gives the sketch of the union of
+ * their hash values, independently of the order of merging.
+ */
+class hyperloglog
+{
+public:
+    //!\brief The default precision.
+    static constexpr uint8_t default_precision{12};
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    hyperloglog() : hyperloglog{default_precision} {} //!< Uses `default_precision`.
+    hyperloglog(hyperloglog const &) = default; //!< Defaulted.
+    hyperloglog(hyperloglog &&) = default; //!< Defaulted.
+    hyperloglog & operator=(hyperloglog const &) = default; //!< Defaulted.
+    hyperloglog & operator=(hyperloglog &&) = default; //!< Defaulted.
+    ~hyperloglog() = default; //!< Defaulted.
+
+    /*!\brief Construct with a given precision.
+     * \param[in] precision The number of bits, that select a register, between 4 and 18.
+     * \throws std::invalid_argument if the precision is out of range.
+     */
+    explicit hyperloglog(uint8_t const precision) : bits{precision}
+    {
+        if (precision < 4 || precision > 18)
+            throw std::invalid_argument{"The precision of a HyperLogLog sketch must be between 4 and 18, but is " +
+                                        std::to_string(precision) + "."};
+        register_values.resize(1ULL << precision);
+    }
+    //!\}
+
+    /*!\brief Adds a hash value.
+     * \param[in] hash The hash value.
+     */
+    void add(uint64_t const hash) noexcept
+    {
+        uint64_t const mixed = murmur_hash_policy{}(hash, 0u);
+        // The bit below the remaining bits bounds the position, if they are all 0.
+        uint64_t const remaining = (mixed << bits) | (1ULL << (bits - 1));
+        uint8_t & value = register_values[mixed >> (64 - bits)];
+        value = std::max<uint8_t>(value, std::countl_zero(remaining) + 1);
+    }
+
+    /*!\brief Merges another sketch into this one.
+     * \param[in] other The other sketch.
+     * \throws std::invalid_argument if the precisions differ.
+     */
+    void merge(hyperloglog const & other)
+    {
+        if (other.bits != bits)
+            throw std::invalid_argument{"Only HyperLogLog sketches of the same precision can be merged."};
+        detail::max_registers(register_values.data(), other.register_values.data(), register_values.size());
+    }
+
+    //!\brief Returns the estimated number of distinct hash values.
+    double estimate() const noexcept
+    {
+        // The improved estimator of Ertl, "New cardinality estimation algorithms for HyperLogLog sketches", 2017,
+        // which needs no bias correction for small numbers.
+        size_t const q = 64 - bits;
+        std::array<size_t, 66> histogram{};
+        for (uint8_t const value : register_values)
+            ++histogram[value];
+
+        double const m = register_values.size();
+        if (histogram[0] == register_values.size())
+            return 0.0;
+
+        double z = m * tau(1.0 - histogram[q + 1] / m);
+        for (size_t k = q; k > 0; --k)
+            z = 0.5 * (z + histogram[k]);
+        z += m * sigma(histogram[0] / m);
+        return m * m / (2.0 * std::log(2.0) * z);
+    }
+
+    //!\brief Returns the relative standard error of estimate().
+    double relative_error() const noexcept
+    {
+        return 1.04 / std::sqrt(static_cast<double>(register_values.size()));
+    }
+
+    //!\brief Returns the precision.
+    uint8_t precision() const noexcept
+    {
+        return bits;
+    }
+
+    //!\brief Returns the registers.
+    std::span<uint8_t const> registers() const noexcept
+    {
+        return register_values;
+    }
+
+private:
+    //!\brief The number of bits, that select a register.
+    uint8_t bits{};
+    //!\brief The registers.
+    std::vector<uint8_t> register_values{};
+
+    //!\brief The sigma function of the estimator for the fraction `x < 1` of empty registers.
+    static double sigma(double x) noexcept
+    {
+        double y{1.0};
+        double z{x};
+        while (true)
+        {
+            x *= x;
+            double const previous{z};
+            z += x * y;
+            y += y;
+            if (z == previous)
+                return z;
+        }
+    }
+
+    //!\brief The tau function of the estimator for the fraction `x` of registers, that are not saturated.
+    static double tau(double x) noexcept
+    {
+        if (x == 0.0 || x == 1.0)
+            return 0.0;
+        double y{1.0};
+        double z{1.0 - x};
+        while (true)
+        {
+            x = std::sqrt(x);
+            double const previous{z};
+            y *= 0.5;
+            z -= (1.0 - x) * (1.0 - x) * y;
+            if (z == previous)
+                return z / 3.0;
+        }
+    }
+};
+
+} // namespace minions
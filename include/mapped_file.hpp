@@ -0,0 +1,101 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::mapped_file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <seqan3/std/filesystem>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace minions
+{
+
+//!\brief A file mapped read-only into memory, for reading it once from the start to the end.
+class mapped_file
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    mapped_file() = default; //!< Defaulted.
+    mapped_file(mapped_file const &) = delete; //!< Deleted, owns the memory mapping.
+    mapped_file & operator=(mapped_file const &) = delete; //!< Deleted, owns the memory mapping.
+
+    //!\brief Move constructor.
+    mapped_file(mapped_file && other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    //!\brief Move assignment.
+    mapped_file & operator=(mapped_file && other) noexcept
+    {
+        std::swap(mapping, other.mapping);
+        std::swap(mapping_size, other.mapping_size);
+        return *this;
+    }
+
+    //!\brief Unmaps the file.
+    ~mapped_file()
+    {
+        if (mapping != nullptr)
+            munmap(mapping, mapping_size);
+    }
+
+    /*!\brief Maps a file into memory.
+     * \param[in] path The file.
+     * \throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit mapped_file(std::filesystem::path const & path)
+    {
+        int const file_descriptor = open(path.c_str(), O_RDONLY);
+        if (file_descriptor == -1)
+            throw std::runtime_error{"Could not open the file " + path.string() + "."};
+
+        struct stat file_status{};
+        if (fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0)
+        {
+            mapping_size = file_status.st_size;
+            mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+            if (mapping == MAP_FAILED)
+                mapping = nullptr;
+            else
+                madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+        }
+        close(file_descriptor);
+
+        if (mapping_size > 0 && mapping == nullptr)
+            throw std::runtime_error{"Could not map the file " + path.string() + "."};
+    }
+    //!\}
+
+    //!\brief The content of the file, empty for empty files.
+    std::span<char const> data() const noexcept
+    {
+        return {static_cast<char const *>(mapping), mapping == nullptr ? 0 : mapping_size};
+    }
+
+private:
+    //!\brief The memory mapping, nullptr if the file is empty.
+    void * mapping{nullptr};
+    //!\brief The size of the file.
+    size_t mapping_size{0};
+};
+
+} // namespace minions
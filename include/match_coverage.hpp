@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::match_coverage.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "histogram.hpp"
+
+namespace minions
+{
+
+/*!\brief Computes the coverage of a sequence by matches and the islands between them in one sweep.
+ *
+ * \details
+ *
+ * Matches are given as intervals with non-decreasing begin positions. Overlapping and adjacent intervals are merged, so
+ * only the current run of covered positions is stored, regardless of the length of the sequence.
+ *
+ * The islands are those of a scan over all positions, that extends the current island at every uncovered position and
+ * ends it at every covered position except the first one of the sequence. Hence, every covered position but the first
+ * adds an island of size 0 to islands(), and the last island is added by finish().
+ */
+class match_coverage
+{
+public:
+    /*!\brief Marks the positions in [begin, end) as covered.
+     * \param[in] begin The first covered position, must not be smaller than the begin of the previous interval.
+     * \param[in] end   The position behind the last covered position.
+     */
+    void add(uint64_t const begin, uint64_t const end)
+    {
+        if (begin >= end)
+            return;
+
+        if (has_run && begin <= run_end)
+        {
+            run_end = std::max(run_end, end);
+            return;
+        }
+
+        if (has_run)
+            flush(run_end);
+        has_run = true;
+        run_begin = begin;
+        run_end = end;
+    }
+
+    /*!\brief Ends the sweep.
+     * \param[in] length The number of positions of the sequence, later positions are ignored.
+     */
+    void finish(uint64_t const length)
+    {
+        if (has_run)
+            flush(length);
+        has_run = false;
+        islands_histogram.add(length - std::min(length, last_end));
+        sequence_length = length;
+    }
+
+    //!\brief The number of covered positions.
+    uint64_t covered() const noexcept
+    {
+        return covered_positions;
+    }
+
+    //!\brief The fraction of covered positions in percent, call finish() first.
+    double percentage() const noexcept
+    {
+        return covered_positions * 100.0 / sequence_length;
+    }
+
+    //!\brief The sizes of the islands, call finish() first.
+    histogram const & islands() const noexcept
+    {
+        return islands_histogram;
+    }
+
+private:
+    //!\brief Whether there is a current run.
+    bool has_run{false};
+    //!\brief The first position of the current run.
+    uint64_t run_begin{0};
+    //!\brief The position behind the current run.
+    uint64_t run_end{0};
+    //!\brief The position behind the last flushed run.
+    uint64_t last_end{0};
+    //!\brief The number of covered positions.
+    uint64_t covered_positions{0};
+    //!\brief The length given to finish().
+    uint64_t sequence_length{0};
+    //!\brief The island sizes.
+    histogram islands_histogram{};
+
+    //!\brief Adds the island before the current run and the empty islands within it, positions from `limit` on are ignored.
+    void flush(uint64_t const limit)
+    {
+        uint64_t const end = std::min(run_end, limit);
+        if (run_begin >= end)
+            return;
+
+        if (run_begin > 0)
+            islands_histogram.add(run_begin - last_end);
+        if (end - run_begin > 1)
+            islands_histogram.add(0, end - run_begin - 1);
+        covered_positions += end - run_begin;
+        last_end = end;
+    }
+};
+
+} // namespace minions
@@ -13,7 +13,6 @@
 #pragma once
 
 #include <seqan3/std/algorithm>
-#include <deque>
 
 #include <seqan3/core/detail/empty_type.hpp>
 #include <seqan3/core/range/detail/adaptor_from_functor.hpp>
@@ -21,6 +20,8 @@
 #include <seqan3/utility/range/concept.hpp>
 #include <seqan3/utility/type_traits/lazy_conditional.hpp>
 
+#include "window_minimum.hpp"
+
 namespace seqan3::detail
 {
 // ---------------------------------------------------------------------------------------------------------------------
@@ -282,7 +283,8 @@ public:
           urng1_iterator{std::move(it.urng1_iterator)},
           urng1_sentinel{std::move(it.urng1_sentinel)},
           urng2_iterator{std::move(it.urng2_iterator)},
-          window_values{std::move(it.window_values)}
+          minimiser_position{it.minimiser_position},
+          window{std::move(it.window)}
     {}
 
     /*!\brief Construct from begin and end iterators of a given range over std::totally_ordered values, and the number
@@ -322,7 +324,7 @@ public:
     {
         return (lhs.urng1_iterator == rhs.urng1_iterator) &&
                (rhs.urng2_iterator == rhs.urng2_iterator) &&
-               (lhs.window_values.size() == rhs.window_values.size());
+               (lhs.window.window_size() == rhs.window.window_size());
     }
 
     //!\brief Compare to another basic_iterator.
@@ -385,8 +387,8 @@ private:
     //!\brief Helper to track distance.
     size_t distance{};
 
-    //!\brief The offset relative to the beginning of the window where the minimizer value is found.
-    size_t minimiser_distance_position_offset{};
+    //!\brief The position of the minimiser, counted in values of the underlying range.
+    size_t minimiser_position{};
 
     //!\brief Iterator to the rightmost value of one window.
     urng1_iterator_t urng1_iterator{};
@@ -395,8 +397,8 @@ private:
     //!\brief Iterator to the rightmost value of one window of the second range.
     urng2_iterator_t urng2_iterator{};
 
-    //!\brief Stored values per window. It is necessary to store them, because a shift can remove the current minimiser_distance.
-    std::deque<value_type> window_values{};
+    //!\brief The minimum of the values per window. It is necessary, because a shift can remove the current minimiser.
+    minions::window_minimum<value_type> window{};
 
     //!\brief Increments iterator by 1.
     void next_unique_minimiser_distance()
@@ -427,24 +429,26 @@ private:
         if (window_size == 0u)
             return;
 
+        window = minions::window_minimum<value_type>{window_size};
         for (size_t i = 0u; i < window_size - 1u; ++i)
         {
-            window_values.push_back(window_value());
+            window.push(window_value());
             advance_window();
         }
-        window_values.push_back(window_value());
-        auto minimiser_distance_it = std::ranges::min_element(window_values, std::less_equal<value_type>{});
-        minimiser_value = *minimiser_distance_it;
-        minimiser_distance_value = std::distance(std::begin(window_values), minimiser_distance_it);
-        minimiser_distance_position_offset = std::distance(std::begin(window_values), minimiser_distance_it);
-        distance = window_values.size() - minimiser_distance_value - 1;
+        window.push(window_value());
+        minimiser_value = window.min();
+        minimiser_position = window.min_position();
+        minimiser_distance_value = minimiser_position;
+        distance = window_size - minimiser_distance_value - 1;
     }
 
     /*!\brief Calculates the next minimiser_distance value.
      * \returns True, if new minimiser_distance is found or end is reached. Otherwise returns false.
      * \details
-     * For the following windows, we remove the first window value (is now not in window_values) and add the new
-     * value that results from the window shifting.
+     * For the following windows, the first window value leaves the window and the new value that results from the
+     * window shifting is added. If the current minimiser left the window, the rightmost minimum of the window becomes
+     * the new minimiser and its offset in the window is returned. If a strictly smaller new value replaces the
+     * minimiser, the distance to the previous minimiser is returned.
      */
     bool next_minimiser_distance()
     {
@@ -454,16 +458,15 @@ private:
 
         value_type const new_value = window_value();
 
-        window_values.pop_front();
-        window_values.push_back(new_value);
+        window.push(new_value);
 
-        if (minimiser_distance_position_offset == 0)
+        size_t const window_begin = window.pushed_values() - window.window_size();
+        if (minimiser_position < window_begin)
         {
-            auto minimiser_distance_it = std::ranges::min_element(window_values, std::less_equal<value_type>{});
-            minimiser_distance_value = std::distance(std::begin(window_values), minimiser_distance_it);
-            minimiser_distance_position_offset = std::distance(std::begin(window_values), minimiser_distance_it);
-            minimiser_value = *minimiser_distance_it;
-            distance = window_values.size() - minimiser_distance_value - 1;
+            minimiser_value = window.min();
+            minimiser_position = window.min_position();
+            minimiser_distance_value = minimiser_position - window_begin;
+            distance = window.window_size() - minimiser_distance_value - 1;
             return true;
         }
 
@@ -471,13 +474,12 @@ private:
         {
             minimiser_distance_value = distance;
             distance = 0;
-            minimiser_distance_position_offset = window_values.size() - 1;
+            minimiser_position = window.pushed_values() - 1;
             minimiser_value = new_value;
             return true;
         }
 
         distance++;
-        --minimiser_distance_position_offset;
         return false;
     }
 };
@@ -17,6 +17,8 @@
 #include <seqan3/search/views/kmer_hash.hpp>
 #include <minions_minimiser.hpp>
 
+#include "hash_policy.hpp"
+
 namespace minions::detail
 {
 //!\brief seqan3::views::minimiser_hash's range adaptor object type (non-closure).
@@ -46,20 +48,37 @@ struct minimiser_hash_fn
         return seqan3::detail::adaptor_from_functor{*this, shape, window_size, seed};
     }
 
+    /*!\brief Store the shape, the window size, the seed and the hash policy and return a range adaptor closure object.
+    * \param[in] shape       The seqan3::shape to use for hashing.
+    * \param[in] window_size The size of the window.
+    * \param[in] seed        The seed to use.
+    * \param[in] hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+    * \throws std::invalid_argument if the size of the shape is greater than the `window_size`.
+    * \returns               A range of converted elements.
+    */
+    template <minions::hash_policy hash_policy_t>
+    constexpr auto operator()(seqan3::shape const & shape, seqan3::window_size const window_size, seqan3::seed const seed, hash_policy_t const hash_policy) const
+    {
+        return seqan3::detail::adaptor_from_functor{*this, shape, window_size, seed, hash_policy};
+    }
+
     /*!\brief Call the view's constructor with the underlying view, a seqan3::shape and a window size as argument.
      * \param[in] urange      The input range to process. Must model std::ranges::viewable_range and the reference type
      *                        of the range must model seqan3::semialphabet.
      * \param[in] shape       The seqan3::shape to use for hashing.
      * \param[in] window_size The size of the window.
      * \param[in] seed        The seed to use.
+     * \param[in] hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+     *                        Default: minions::xor_hash_policy.
      * \throws std::invalid_argument if the size of the shape is greater than the `window_size`.
      * \returns               A range of converted elements.
      */
-    template <std::ranges::range urng_t>
+    template <std::ranges::range urng_t, minions::hash_policy hash_policy_t = minions::xor_hash_policy>
     constexpr auto operator()(urng_t && urange,
                               seqan3::shape const & shape,
                               seqan3::window_size const window_size,
-                              seqan3::seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE}) const
+                              seqan3::seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE},
+                              hash_policy_t const hash_policy = hash_policy_t{}) const
     {
         static_assert(std::ranges::viewable_range<urng_t>,
             "The range parameter to views::minimiser_hash cannot be a temporary of a non-view range.");
@@ -72,14 +91,14 @@ struct minimiser_hash_fn
             throw std::invalid_argument{"The size of the shape cannot be greater than the window size."};
 
         auto forward_strand = std::forward<urng_t>(urange) | seqan3::views::kmer_hash(shape)
-                                                           | std::views::transform([seed] (uint64_t i)
-                                                                                  {return i ^ seed.get();});
+                                                           | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                                                  {return hash_policy(i, seed.get());});
 
         auto reverse_strand = std::forward<urng_t>(urange) | seqan3::views::complement
                                                            | std::views::reverse
                                                            | seqan3::views::kmer_hash(shape)
-                                                           | std::views::transform([seed] (uint64_t i)
-                                                                                  {return i ^ seed.get();})
+                                                           | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                                                  {return hash_policy(i, seed.get());})
                                                            | std::views::reverse;
 
         return minions::detail::minimiser_view(forward_strand, reverse_strand, window_size.get() - shape.size() + 1);
@@ -18,6 +18,7 @@
 #include <seqan3/search/views/minimiser_hash.hpp>
 #include <seqan3/utility/views/zip.hpp>
 
+#include "canonical_strobemer.hpp"
 #include "minstrobe.hpp"
 #include "shared.hpp"
 
@@ -52,6 +53,21 @@ struct minstrobe2_hash_fn
         return seqan3::detail::adaptor_from_functor{*this, shape, window_min, window_len, seed};
     }
 
+    /*!\brief Store the shape, the window size, the seed and the hash policy and return a range adaptor closure object.
+    * \param[in] shape       The seqan3::shape to use for hashing.
+    * \param[in] window_min  The lower offset for the position of the next window from the previous one.
+    * \param[in] window_len  The upper offset for the position of the next window from the previous one.
+    * \param[in] seed        The seed to use.
+    * \param[in] hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+    * \throws std::invalid_argument if window_min is greater than window_len or smaller than 1.
+    * \returns               A range of converted elements in vectors of size 2.
+    */
+    template <minions::hash_policy hash_policy_t>
+    constexpr auto operator()(shape const & shape, uint32_t const window_min, uint32_t const window_len, seed const seed, hash_policy_t const hash_policy) const
+    {
+        return seqan3::detail::adaptor_from_functor{*this, shape, window_min, window_len, seed, hash_policy};
+    }
+
     /*!\brief Call the view's constructor with the underlying view, a seqan3::shape and a window size as argument.
      * \param[in] urange      The input range to process. Must model std::ranges::viewable_range and the reference type
      *                        of the range must model seqan3::semialphabet.
@@ -59,15 +75,18 @@ struct minstrobe2_hash_fn
      * \param[in] window_min  The lower offset for the position of the next window from the previous one.
      * \param[in] window_len  The length of a window.
      * \param[in] seed        The seed to use.
+     * \param[in] hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+     *                        Default: minions::xor_hash_policy.
      * \throws std::invalid_argument if window_min is greater than window_len or smaller than 1.
      * \returns               A range of converted elements in vectors of size 2.
      */
-    template <std::ranges::range urng_t>
+    template <std::ranges::range urng_t, minions::hash_policy hash_policy_t = minions::xor_hash_policy>
     constexpr auto operator()(urng_t && urange,
                               shape const & shape,
                               uint32_t const window_min,
                               uint32_t const window_len,
-                              seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE}) const
+                              seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE},
+                              hash_policy_t const hash_policy = hash_policy_t{}) const
     {
         static_assert(std::ranges::forward_range<urng_t>,
             "The range parameter to views::minstrobe_hash must model std::ranges::forward_range.");
@@ -78,35 +97,27 @@ struct minstrobe2_hash_fn
             throw std::invalid_argument{"The chosen parameters are not valid. "
                                         "Please choose a window_len greater than window_min."};
 
-        auto hashed_values = std::forward<urng_t>(urange) | seqan3::views::kmer_hash(shape)
-                                                          | std::views::transform([seed] (uint64_t i)
-                                                                                  {return i ^ seed.get();});
-
-        auto forward = seqan3::detail::minstrobe_view(hashed_values, window_min + shape.size() - 1, window_len - shape.size() + 1, shape.count());
-
-        auto rev_hashed_values = std::forward<urng_t>(urange) | seqan3::views::complement
-                                                              | std::views::reverse
-                                                              | seqan3::views::kmer_hash(shape)
-                                                              | std::views::transform([seed] (uint64_t i)
-                                                                                     {return i ^ seed.get();});
-
-        // Todo: Instead of using vectors, use the std::views::reverse function and zip, but the view reverse is very slow in comparison.
-        auto reverse = seqan3::detail::minstrobe_view(rev_hashed_values, window_min + shape.size() - 1, window_len - shape.size() + 1, shape.count());
-
-        std::vector<uint64_t> rev{};
-        for(auto && h : reverse)
-            rev.push_back(h);
-        std::reverse(rev.begin(), rev.end());
-
-        int i{0};
-        std::vector<uint64_t> result{};
-        for(auto && h : forward)
-        {
-            result.push_back(std::min(h, rev[i]));
-            ++i;
-        }
-
-        return result;
+        auto forward_strand = std::forward<urng_t>(urange) | seqan3::views::kmer_hash(shape)
+                                                           | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                                                  {return hash_policy(i, seed.get());});
+
+        // The hashes of the reverse complement k-mers, in the order of the forward strand.
+        auto reverse_strand = std::forward<urng_t>(urange) | seqan3::views::complement
+                                                           | std::views::reverse
+                                                           | seqan3::views::kmer_hash(shape)
+                                                           | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                                                  {return hash_policy(i, seed.get());})
+                                                           | std::views::reverse;
+
+        using view_t = seqan3::detail::canonical_strobemer_view<decltype(forward_strand),
+                                                                decltype(reverse_strand),
+                                                                minions::strobemer_method::minstrobe,
+                                                                2>;
+        return view_t{forward_strand,
+                      reverse_strand,
+                      window_min + shape.size() - 1,
+                      window_len - shape.size() + 1,
+                      shape.count()};
     }
 };
 
@@ -139,6 +150,21 @@ struct minstrobe3_hash_fn
         return seqan3::detail::adaptor_from_functor{*this, shape, window_min, window_len, seed};
     }
 
+    /*!\brief Store the shape, the window size, the seed and the hash policy and return a range adaptor closure object.
+    * \param[in] shape       The seqan3::shape to use for hashing.
+    * \param[in] window_min  The lower offset for the position of the next window from the previous one.
+    * \param[in] window_len  The upper offset for the position of the next window from the previous one.
+    * \param[in] seed        The seed to use.
+    * \param[in] hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+    * \throws std::invalid_argument if window_min is greater than window_len or smaller than 1.
+    * \returns               A range of converted elements in vectors of size 2.
+    */
+    template <minions::hash_policy hash_policy_t>
+    constexpr auto operator()(shape const & shape, uint32_t const window_min, uint32_t const window_len, seed const seed, hash_policy_t const hash_policy) const
+    {
+        return seqan3::detail::adaptor_from_functor{*this, shape, window_min, window_len, seed, hash_policy};
+    }
+
     /*!\brief Call the view's constructor with the underlying view, a seqan3::shape and a window size as argument.
      * \param[in] urange      The input range to process. Must model std::ranges::viewable_range and the reference type
      *                        of the range must model seqan3::semialphabet.
@@ -146,15 +172,18 @@ struct minstrobe3_hash_fn
      * \param[in] window_min  The lower offset for the position of the next window from the previous one.
      * \param[in] window_len  The length of a window.
      * \param[in] seed        The seed to use.
+     * \param[in] hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+     *                        Default: minions::xor_hash_policy.
      * \throws std::invalid_argument if window_min is greater than window_len or smaller than 1.
      * \returns               A range of converted elements in vectors of size 2.
      */
-    template <std::ranges::range urng_t>
+    template <std::ranges::range urng_t, minions::hash_policy hash_policy_t = minions::xor_hash_policy>
     constexpr auto operator()(urng_t && urange,
                               shape const & shape,
                               uint32_t const window_min,
                               uint32_t const window_len,
-                              seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE}) const
+                              seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE},
+                              hash_policy_t const hash_policy = hash_policy_t{}) const
     {
         static_assert(std::ranges::forward_range<urng_t>,
             "The range parameter to views::minstrobe_hash must model std::ranges::forward_range.");
@@ -165,36 +194,27 @@ struct minstrobe3_hash_fn
             throw std::invalid_argument{"The chosen parameters are not valid. "
                                         "Please choose values greater than 0 and a window_len greater than window_min."};
 
-        auto hashed_values = std::forward<urng_t>(urange) | seqan3::views::kmer_hash(shape)
-                                                          | std::views::transform([seed] (uint64_t i)
-                                                                                  {return i ^ seed.get();});
-
-
-        auto forward = seqan3::detail::minstrobe_view<decltype(hashed_values), 3>(hashed_values, window_min + shape.size() - 1, window_len - shape.size() + 1, shape.count());
-
-        auto rev_hashed_values = std::forward<urng_t>(urange)  | seqan3::views::complement
-                                                               | std::views::reverse
-                                                               | seqan3::views::kmer_hash(shape)
-                                                               | std::views::transform([seed] (uint64_t i)
-                                                                                    {return i ^ seed.get();});
-
-        auto reverse =  seqan3::detail::minstrobe_view<decltype(rev_hashed_values), 3>(rev_hashed_values, window_min + shape.size() - 1, window_len - shape.size() + 1, shape.count());
-
-        std::vector<uint64_t> rev{};
-        for(auto && h : reverse)
-            rev.push_back(h);
-
-        std::reverse(rev.begin(), rev.end());
-
-        int i{0};
-        std::vector<uint64_t> result{};
-        for(auto && h : forward)
-        {
-            result.push_back(std::min(h, rev[i]));
-            ++i;
-        }
-
-        return result;
+        auto forward_strand = std::forward<urng_t>(urange) | seqan3::views::kmer_hash(shape)
+                                                           | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                                                  {return hash_policy(i, seed.get());});
+
+        // The hashes of the reverse complement k-mers, in the order of the forward strand.
+        auto reverse_strand = std::forward<urng_t>(urange) | seqan3::views::complement
+                                                           | std::views::reverse
+                                                           | seqan3::views::kmer_hash(shape)
+                                                           | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                                                  {return hash_policy(i, seed.get());})
+                                                           | std::views::reverse;
+
+        using view_t = seqan3::detail::canonical_strobemer_view<decltype(forward_strand),
+                                                                decltype(reverse_strand),
+                                                                minions::strobemer_method::minstrobe,
+                                                                3>;
+        return view_t{forward_strand,
+                      reverse_strand,
+                      window_min + shape.size() - 1,
+                      window_len - shape.size() + 1,
+                      shape.count()};
     }
 };
 
@@ -36,13 +36,17 @@ namespace seqan3::detail
  * \tparam urng2_t The type of the underlying range, must model std::ranges::forward_range, the reference type must
  *                 model std::totally_ordered. The typical use case is that the reference type is the result of
  *                 seqan3::kmer_hash.
+ * \tparam hash_policy_t The minions::hash_policy that decides with the seed, whether a value of two ranges is a
+ *                       modmer. Defaults to minions::fnv_hash_policy.
  * \implements std::ranges::view
  * \ingroup search_views
  *
  *
  * \note Most members of this class are generated by std::ranges::view_interface which is not yet documented here.
  */
-template <std::ranges::view urng1_t, std::ranges::view urng2_t = std::ranges::empty_view<seqan3::detail::empty_type>>
+template <std::ranges::view urng1_t,
+          std::ranges::view urng2_t = std::ranges::empty_view<seqan3::detail::empty_type>,
+          minions::hash_policy hash_policy_t = minions::fnv_hash_policy>
 class modmer_view : public std::ranges::view_interface<modmer_view<urng1_t>>
 {
 private:
@@ -101,9 +105,13 @@ public:
     *                        std::ranges::forward_range.
     * \param[in] mod_used    The modvalue used.
     * \param[in] seed_used   The seed used.
+    * \param[in] hash_policy The hash policy, only used for template argument deduction.
     */
-        explicit modmer_view(urng1_t urange1, size_t const mod_used, uint64_t const seed_used) :
-        modmer_view{std::move(urange1), default_urng2_t{}, mod_used, seed_used}
+        explicit modmer_view(urng1_t urange1,
+                             size_t const mod_used,
+                             uint64_t const seed_used,
+                             hash_policy_t const hash_policy = hash_policy_t{}) :
+        modmer_view{std::move(urange1), default_urng2_t{}, mod_used, seed_used, hash_policy}
     {}
 
     /*!\brief Construct from a non-view that can be view-wrapped and a given number of values in one window.
@@ -113,13 +121,17 @@ public:
     *                        std::ranges::forward_range.
     * \param[in] mod_used    The modvalue used.
     * \param[in] seed_used        The seed used.
+    * \param[in] hash_policy The hash policy, only used for template argument deduction.
     */
     template <typename other_urng1_t>
     //!\cond
         requires (std::ranges::viewable_range<other_urng1_t> &&
                   std::constructible_from<urng1_t, ranges::ref_view<std::remove_reference_t<other_urng1_t>>>)
     //!\endcond
-    modmer_view(other_urng1_t && urange1, size_t const mod_used, uint64_t const seed_used) :
+    modmer_view(other_urng1_t && urange1,
+                size_t const mod_used,
+                uint64_t const seed_used,
+                [[maybe_unused]] hash_policy_t const hash_policy = hash_policy_t{}) :
         urange1{std::views::all(std::forward<other_urng1_t>(urange1))},
         urange2{default_urng2_t{}},
         mod_used{mod_used},
@@ -133,8 +145,13 @@ public:
     *                        std::ranges::forward_range.
     * \param[in] mod_used    The modvalue used.
     * \param[in] seed_used        The seed used.
+    * \param[in] hash_policy The hash policy, only used for template argument deduction.
     */
-    modmer_view(urng1_t urange1, urng2_t urange2, size_t const mod_used, uint64_t const seed_used) :
+    modmer_view(urng1_t urange1,
+                urng2_t urange2,
+                size_t const mod_used,
+                uint64_t const seed_used,
+                [[maybe_unused]] hash_policy_t const hash_policy = hash_policy_t{}) :
         urange1{urange1},
         urange2{urange2},
         mod_used{mod_used},
@@ -158,6 +175,7 @@ public:
     *                        std::ranges::forward_range.
     * \param[in] mod_used    The modvalue used.
     * \param[in] seed_used   The seed used.
+    * \param[in] hash_policy The hash policy, only used for template argument deduction.
     */
     template <typename other_urng1_t, typename other_urng2_t>
     //!\cond
@@ -166,7 +184,11 @@ public:
                 && std::ranges::viewable_range<other_urng2_t>
                 && std::constructible_from<urng2_t, std::views::all_t<other_urng2_t>>)
     //!\endcond
-      explicit modmer_view(other_urng1_t && urange1, other_urng2_t && urange2, size_t const mod_used, uint64_t const seed_used) :
+      explicit modmer_view(other_urng1_t && urange1,
+                           other_urng2_t && urange2,
+                           size_t const mod_used,
+                           uint64_t const seed_used,
+                           [[maybe_unused]] hash_policy_t const hash_policy = hash_policy_t{}) :
           urange1{std::views::all(std::forward<other_urng1_t>(urange1))},
           urange2{std::views::all(std::forward<other_urng2_t>(urange2))},
           mod_used{mod_used},
@@ -240,9 +262,9 @@ public:
 };
 
 //!\brief Iterator for calculating modmers.
-template <std::ranges::view urng1_t, std::ranges::view urng2_t>
+template <std::ranges::view urng1_t, std::ranges::view urng2_t, minions::hash_policy hash_policy_t>
 template <bool const_range>
-class modmer_view<urng1_t, urng2_t>::basic_iterator
+class modmer_view<urng1_t, urng2_t, hash_policy_t>::basic_iterator
 {
 private:
     //!\brief The sentinel type of the first underlying range.
@@ -291,7 +313,8 @@ public:
         : modmer_value{std::move(it.modmer_value)},
           urng1_iterator{std::move(it.urng1_iterator)},
           urng2_iterator{std::move(it.urng2_iterator)},
-          urng1_sentinel{std::move(it.urng1_sentinel)}
+          urng1_sentinel{std::move(it.urng1_sentinel)},
+          modmer_position{it.modmer_position}
     {}
 
     /*!\brief Construct from begin and end iterators of a given range over std::totally_ordered values, and the number
@@ -388,6 +411,12 @@ public:
         return modmer_value;
     }
 
+    //!\brief Return the position of the modmer, counted in values of the underlying range.
+    size_t position() const noexcept
+    {
+        return modmer_position;
+    }
+
 private:
     //!\brief The modmer value.
     value_type modmer_value{};
@@ -405,9 +434,13 @@ private:
     //!brief The seed value used.
     uint64_t seed{};
 
+    //!\brief The position of the modmer, i.e. of urng1_iterator.
+    size_t modmer_position{};
+
     //!\brief Advances the window to the next position.
     void advance()
     {
+        ++modmer_position;
         ++urng1_iterator;
         if constexpr (second_range_is_given)
             ++urng2_iterator;
@@ -440,7 +473,7 @@ private:
 
         if constexpr (second_range_is_given)
         {
-            if (fnv_hash(std::min(*urng1_iterator, *urng2_iterator), seed) % mod == 0)
+            if (hash_policy_t{}(std::min(*urng1_iterator, *urng2_iterator), seed) % mod == 0)
             {
                 modmer_value = std::min(*urng1_iterator, *urng2_iterator);
                 return true;
@@ -470,6 +503,16 @@ template <std::ranges::viewable_range rng1_t, std::ranges::viewable_range rng2_t
 modmer_view(rng1_t &&, rng2_t &&, size_t const mod_used, uint64_t seed_used)
     -> modmer_view<std::views::all_t<rng1_t>, std::views::all_t<rng2_t>>;
 
+//!\brief A deduction guide for the view class template.
+template <std::ranges::viewable_range rng1_t, minions::hash_policy hash_policy_t>
+modmer_view(rng1_t &&, size_t const mod_used, uint64_t seed_used, hash_policy_t)
+    -> modmer_view<std::views::all_t<rng1_t>, std::ranges::empty_view<seqan3::detail::empty_type>, hash_policy_t>;
+
+//!\brief A deduction guide for the view class template.
+template <std::ranges::viewable_range rng1_t, std::ranges::viewable_range rng2_t, minions::hash_policy hash_policy_t>
+modmer_view(rng1_t &&, rng2_t &&, size_t const mod_used, uint64_t seed_used, hash_policy_t)
+    -> modmer_view<std::views::all_t<rng1_t>, std::views::all_t<rng2_t>, hash_policy_t>;
+
 // ---------------------------------------------------------------------------------------------------------------------
 // modmer_fn (adaptor definition)
 // ---------------------------------------------------------------------------------------------------------------------
@@ -49,20 +49,36 @@ struct modmer_hash_fn
         return seqan3::detail::adaptor_from_functor{*this, shape, mod_used, seed};
     }
 
+    /*!\brief Store the shape, the mod value, the seed and the hash policy and return a range adaptor closure object.
+    * \param[in] shape       The seqan3::shape to use for hashing.
+    * \param[in] mod_used    The mod value to use.
+    * \param[in] seed        The seed to use.
+    * \param[in] hash_policy The minions::hash_policy that decides with the seed, whether a k-mer is a modmer.
+    * \returns               A range of converted elements.
+    */
+    template <minions::hash_policy hash_policy_t>
+    constexpr auto operator()(shape const & shape, uint32_t const mod_used, seed const seed, hash_policy_t const hash_policy) const
+    {
+        return seqan3::detail::adaptor_from_functor{*this, shape, mod_used, seed, hash_policy};
+    }
+
     /*!\brief Call the view's constructor with the underlying view, a seqan3::shape and a window size as argument.
      * \param[in] urange      The input range to process. Must model std::ranges::viewable_range and the reference type
      *                        of the range must model seqan3::semialphabet.
      * \param[in] shape       The seqan3::shape to use for hashing.
      * \param[in] mod_used    The mod value to use.
      * \param[in] seed        The seed to use.
+     * \param[in] hash_policy The minions::hash_policy that decides with the seed, whether a k-mer is a modmer.
+     *                        Default: minions::fnv_hash_policy.
      * \throws std::invalid_argument if the size of the shape is greater than the `mod_used`.
      * \returns               A range of converted elements.
      */
-    template <std::ranges::range urng_t>
+    template <std::ranges::range urng_t, minions::hash_policy hash_policy_t = minions::fnv_hash_policy>
     constexpr auto operator()(urng_t && urange,
                               shape const & shape,
                               uint32_t const mod_used,
-                              seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE}) const
+                              seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE},
+                              hash_policy_t const hash_policy = hash_policy_t{}) const
     {
         static_assert(std::ranges::forward_range<urng_t>,
             "The range parameter to views::modmer_hash must model std::ranges::forward_range.");
@@ -80,7 +96,7 @@ struct modmer_hash_fn
                                                            | seqan3::views::kmer_hash(shape)
                                                            | std::views::reverse;
 
-        return seqan3::detail::modmer_view(forward_strand, reverse_strand, mod_used, seed.get());
+        return seqan3::detail::modmer_view(forward_strand, reverse_strand, mod_used, seed.get(), hash_policy);
     }
 };
 
@@ -0,0 +1,332 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::sketch_spec and minions::multi_sketch.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "batch.hpp"
+
+namespace minions
+{
+
+//!\brief The methods minions::multi_sketch computes.
+enum class sketch_method
+{
+    kmer,      //!< All k-mers, see minions::kmer_batch.
+    minimiser, //!< Minimisers, see minions::minimiser_batch.
+    modmer,    //!< Modmers, see minions::modmer_batch.
+    syncmer,   //!< Syncmers, see minions::syncmer_batch.
+    strobemer  //!< Strobemers, see minions::strobemer_batch.
+};
+
+//!\brief A method and its parameters, the parameters a method does not use are ignored.
+struct sketch_spec
+{
+    //!\brief The method.
+    sketch_method method{sketch_method::kmer};
+    //!\brief The shape of the k-mers, for strobemers the one of a strobe. Syncmers use an ungapped shape of its size.
+    seqan3::shape shape{};
+    //!\brief The window size for minimisers, the mod value for modmers and the s-mer size for syncmers.
+    uint32_t window{};
+    //!\brief The seed.
+    seqan3::seed seed{0x8F3F73B5CF1C9ADEULL};
+    //!\brief The positions of the smallest s-mer, that make a k-mer a syncmer.
+    std::vector<int> positions{};
+    //!\brief The strobemer method.
+    strobemer_method strobemer{strobemer_method::randstrobe};
+    //!\brief The number of strobes, 2 or 3.
+    uint16_t order{2};
+    //!\brief The minimal offset for the position of the next strobes.
+    uint32_t window_min{};
+    //!\brief The maximal offset for the position of the next strobes.
+    uint32_t window_max{};
+};
+
+/*!\brief Computes several methods on one sequence, hashing the k-mers of every shape only once.
+ *
+ * \details
+ *
+ * The k-mer hashes of both strands are computed once per distinct shape, including the s-mer shapes of syncmers, and
+ * every method selects its values from them with the same steps as its batch function. Hence, the values of a method
+ * are the ones of its batch function, e.g. minions::minimiser_batch for minions::sketch_method::minimiser.
+ *
+ * The k-mer hashes of both strands take 16 bytes per base and shape. To bound the memory for many shapes, e.g. for a
+ * sweep over k-mer sizes, the methods are split into passes of consecutive methods with at most `max_shapes` distinct
+ * shapes and only the hashes of one pass are stored. A shape, that is used by several passes, is hashed once per pass.
+ * Hence, the memory grows with the length of the sequence and `max_shapes`, but not with the number of methods. The
+ * memory is reused between sequences. Copies share no state, so every thread can use its own copy.
+ */
+class multi_sketch
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    multi_sketch() = default; //!< Defaulted.
+    multi_sketch(multi_sketch const &) = default; //!< Defaulted.
+    multi_sketch(multi_sketch &&) = default; //!< Defaulted.
+    multi_sketch & operator=(multi_sketch const &) = default; //!< Defaulted.
+    multi_sketch & operator=(multi_sketch &&) = default; //!< Defaulted.
+    ~multi_sketch() = default; //!< Defaulted.
+
+    /*!\brief Prepares the methods.
+     * \param[in] specs      The methods, in the order their values are reported.
+     * \param[in] max_shapes The maximal number of shapes, whose hashes are stored at the same time.
+     * \throws std::invalid_argument if the parameters of a method are not valid, see the batch functions, or if
+     *                               `max_shapes` is smaller than 2, the number of shapes of a syncmer method.
+     */
+    explicit multi_sketch(std::vector<sketch_spec> specs, size_t const max_shapes = default_max_shapes) :
+        specs{std::move(specs)}
+    {
+        if (max_shapes < 2)
+            throw std::invalid_argument{"At least two shapes must be stored at the same time."};
+
+        for (sketch_spec & spec : this->specs)
+        {
+            switch (spec.method)
+            {
+                case sketch_method::minimiser:
+                    if (spec.shape.size() > spec.window)
+                        throw std::invalid_argument{"The size of the shape cannot be greater than the window size."};
+                    break;
+                case sketch_method::modmer:
+                    if (spec.window == 0)
+                        throw std::invalid_argument{"The mod value must be greater than 0."};
+                    break;
+                case sketch_method::syncmer:
+                    if (spec.window < 1 || spec.shape.size() <= spec.window)
+                        throw std::invalid_argument{"The chosen kmers and smers are not valid. Please choose values "
+                                                    "greater than 1 and a smer size smaller than the kmer size."};
+                    spec.shape = seqan3::ungapped{static_cast<uint8_t>(spec.shape.size())};
+                    break;
+                case sketch_method::strobemer:
+                    if (spec.window_max < spec.window_min)
+                        throw std::invalid_argument{"The chosen parameters are not valid. "
+                                                    "Please choose a window_len greater than window_min."};
+                    if (spec.order != 2 && spec.order != 3)
+                        throw std::invalid_argument{"The order of strobemers must be 2 or 3."};
+                    break;
+                default:
+                    break;
+            }
+
+            // All methods but k-mers need the reverse complement strand.
+            bool const with_reverse = spec.method != sketch_method::kmer;
+            kmer_streams.push_back(stream_index(spec.shape, with_reverse));
+            if (spec.method == sketch_method::syncmer)
+                smer_streams.push_back(stream_index(seqan3::ungapped{static_cast<uint8_t>(spec.window)}, true));
+            else
+                smer_streams.push_back(kmer_streams.back());
+        }
+
+        // A method joins the pass of the previous methods, if the shapes of the pass and its own fit.
+        for (size_t i = 0; i < this->specs.size(); ++i)
+        {
+            std::vector<size_t> shapes = passes.empty() ? std::vector<size_t>{} : passes.back().streams;
+            for (size_t const index : {kmer_streams[i], smer_streams[i]})
+                if (std::ranges::find(shapes, index) == shapes.end())
+                    shapes.push_back(index);
+
+            if (passes.empty() || shapes.size() > max_shapes)
+            {
+                passes.push_back(pass{i, i, {}});
+                shapes = {kmer_streams[i]};
+                if (smer_streams[i] != kmer_streams[i])
+                    shapes.push_back(smer_streams[i]);
+            }
+            passes.back().streams = std::move(shapes);
+            passes.back().end = i + 1;
+            hashes.resize(std::max(hashes.size(), passes.back().streams.size()));
+        }
+        slots.resize(streams.size());
+    }
+    //!\}
+
+    //!\brief The maximal number of shapes, whose hashes are stored at the same time, if not given otherwise.
+    static constexpr size_t default_max_shapes{4};
+
+    //!\brief The number of methods.
+    size_t size() const noexcept
+    {
+        return specs.size();
+    }
+
+    //!\brief The method with the given index.
+    sketch_spec const & operator[](size_t const index) const noexcept
+    {
+        return specs[index];
+    }
+
+    /*!\brief Computes the values of all methods for one sequence.
+     * \param[in] sequence The sequence, see minions::batch_sequence.
+     * \param[in] emit     Callable `emit(index, hash)`, which is called for every value of every method, all values of
+     *                     a method in the order of its batch function before those of the next method.
+     * \throws std::invalid_argument if the sequence is too short for a syncmer or strobemer method.
+     */
+    template <batch_sequence sequence_t, typename emit_t>
+    void operator()(sequence_t const & sequence, emit_t && emit)
+    {
+        std::span<uint8_t const> const ranks = detail::batch_ranks(sequence, ranks_buffer);
+        for (pass const & p : passes)
+        {
+            for (size_t slot = 0; slot < p.streams.size(); ++slot)
+            {
+                stream const & s = streams[p.streams[slot]];
+                stream_hashes & h = hashes[slot];
+                slots[p.streams[slot]] = slot;
+                if (s.with_reverse)
+                    detail::batch_kmer_hashes<true>(ranks, s.shape, h.forward, h.reverse);
+                else
+                    detail::batch_kmer_hashes<false>(ranks, s.shape, h.forward, h.reverse);
+            }
+
+            for (size_t i = p.begin; i < p.end; ++i)
+            {
+                select(i);
+                for (uint64_t const hash : buffer.hashes)
+                    emit(i, hash);
+                buffer.clear();
+            }
+        }
+    }
+
+private:
+    //!\brief A distinct shape.
+    struct stream
+    {
+        //!\brief The shape.
+        seqan3::shape shape{};
+        //!\brief Whether the reverse complement hashes are needed.
+        bool with_reverse{false};
+    };
+
+    //!\brief The hashes of all k-mers of one shape.
+    struct stream_hashes
+    {
+        //!\brief The k-mer hashes of the forward strand.
+        std::vector<uint64_t> forward{};
+        //!\brief The k-mer hashes of the reverse complement strand, in the order of the forward strand.
+        std::vector<uint64_t> reverse{};
+    };
+
+    //!\brief Consecutive methods, whose shapes are hashed together.
+    struct pass
+    {
+        //!\brief The index of the first method.
+        size_t begin{};
+        //!\brief The index behind the last method.
+        size_t end{};
+        //!\brief The indices of the shapes of the methods, the hashes of `streams[i]` are stored in `hashes[i]`.
+        std::vector<size_t> streams{};
+    };
+
+    //!\brief The methods.
+    std::vector<sketch_spec> specs{};
+    //!\brief The index of the k-mer stream of every method.
+    std::vector<size_t> kmer_streams{};
+    //!\brief The index of the s-mer stream of every method, the k-mer stream for other methods than syncmers.
+    std::vector<size_t> smer_streams{};
+    //!\brief The distinct shapes.
+    std::vector<stream> streams{};
+    //!\brief The passes, in the order of the methods.
+    std::vector<pass> passes{};
+    //!\brief The hashes of the shapes of the current pass.
+    std::vector<stream_hashes> hashes{};
+    //!\brief The index into hashes of every shape of the current pass.
+    std::vector<size_t> slots{};
+    //!\brief The ranks of the current sequence, if it is not given as ranks.
+    std::vector<uint8_t> ranks_buffer{};
+    //!\brief The values of the current method and the scratch memory of the selection.
+    batch_buffer buffer{};
+
+    //!\brief Returns the index of the stream with the shape, which is added if it does not exist yet.
+    size_t stream_index(seqan3::shape const & shape, bool const with_reverse)
+    {
+        auto it = std::ranges::find_if(streams, [&shape] (stream const & s) { return s.shape == shape; });
+        if (it == streams.end())
+        {
+            streams.push_back(stream{shape, with_reverse});
+            return streams.size() - 1;
+        }
+        it->with_reverse |= with_reverse;
+        return it - streams.begin();
+    }
+
+    //!\brief Appends the values of a method to the buffer.
+    void select(size_t const index)
+    {
+        sketch_spec const & spec = specs[index];
+        stream_hashes const & kmers = hashes[slots[kmer_streams[index]]];
+        std::span<uint64_t const> const forward{kmers.forward};
+        std::span<uint64_t const> const reverse{kmers.reverse};
+
+        switch (spec.method)
+        {
+            case sketch_method::kmer:
+                detail::select_kmers(forward, buffer);
+                break;
+            case sketch_method::minimiser:
+                detail::select_minimisers(forward, reverse, spec.shape.size(), seqan3::window_size{spec.window},
+                                          spec.seed, buffer, xor_hash_policy{});
+                break;
+            case sketch_method::modmer:
+                detail::select_modmers(forward, reverse, spec.window, spec.seed, buffer, fnv_hash_policy{});
+                break;
+            case sketch_method::syncmer:
+            {
+                stream_hashes const & smers = hashes[slots[smer_streams[index]]];
+                detail::select_syncmers(forward, reverse, smers.forward, smers.reverse, spec.positions, spec.seed,
+                                        buffer, xor_hash_policy{});
+                break;
+            }
+            case sketch_method::strobemer:
+                select_strobemers(spec, forward, reverse);
+                break;
+        }
+    }
+
+    //!\brief Appends the strobemers of the method to the buffer.
+    void select_strobemers(sketch_spec const & spec,
+                           std::span<uint64_t const> const forward,
+                           std::span<uint64_t const> const reverse)
+    {
+        auto select = [&] <strobemer_method method> ()
+        {
+            if (spec.order == 2)
+                detail::select_strobemers<method, 2>(forward, reverse, spec.shape, spec.window_min, spec.window_max,
+                                                     spec.seed, buffer, xor_hash_policy{});
+            else
+                detail::select_strobemers<method, 3>(forward, reverse, spec.shape, spec.window_min, spec.window_max,
+                                                     spec.seed, buffer, xor_hash_policy{});
+        };
+
+        switch (spec.strobemer)
+        {
+            case strobemer_method::randstrobe:
+                select.template operator()<strobemer_method::randstrobe>();
+                break;
+            case strobemer_method::minstrobe:
+                select.template operator()<strobemer_method::minstrobe>();
+                break;
+            case strobemer_method::hybridstrobe:
+                select.template operator()<strobemer_method::hybridstrobe>();
+                break;
+        }
+    }
+};
+
+} // namespace minions
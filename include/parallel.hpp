@@ -0,0 +1,200 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::parallel_for, minions::parallel_sort and minions::bounded_queue.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace minions
+{
+
+/*!\brief Calls `worker(i)` for every `i` in `[0, n)` using up to `threads` threads.
+ * \param[in] n       The number of work items.
+ * \param[in] threads The maximal number of threads to use, the calling thread is one of them.
+ * \param[in] worker  Callable that is invoked with the index of a work item.
+ *
+ * \details
+ *
+ * Work items are handed out one at a time, so items of different cost are balanced between the threads. If a worker
+ * throws, no further items are started and the first exception is rethrown after all threads have been joined.
+ */
+template <typename worker_t>
+void parallel_for(size_t const n, size_t const threads, worker_t && worker)
+{
+    size_t const number_of_threads = std::clamp<size_t>(threads, 1u, std::max<size_t>(n, 1u));
+
+    if (number_of_threads == 1u)
+    {
+        for (size_t i = 0; i < n; ++i)
+            worker(i);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr exception{};
+    std::mutex exception_mutex{};
+
+    auto run = [&] ()
+    {
+        for (size_t i = next++; i < n; i = next++)
+        {
+            try
+            {
+                worker(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{exception_mutex};
+                if (!exception)
+                    exception = std::current_exception();
+                next = n;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool{};
+    for (size_t t = 1; t < number_of_threads; ++t)
+        pool.emplace_back(run);
+    run();
+    for (auto & thread : pool)
+        thread.join();
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+/*!\brief Sorts values in ascending order using up to `threads` threads.
+ * \param[in,out] values  The values.
+ * \param[in]     threads The maximal number of threads to use, the calling thread is one of them.
+ *
+ * \details
+ *
+ * The values are split into one chunk per thread, the chunks are sorted in parallel and then merged pairwise, where
+ * the merges of one round run in parallel as well.
+ */
+template <typename value_t>
+void parallel_sort(std::span<value_t> const values, size_t const threads)
+{
+    size_t const chunks = std::clamp<size_t>(threads, 1u, std::max<size_t>(values.size() / 4096u, 1u));
+    size_t const chunk_size = (values.size() + chunks - 1) / chunks;
+
+    auto bound = [&] (size_t const chunk) { return values.begin() + std::min(chunk * chunk_size, values.size()); };
+
+    parallel_for(chunks, threads, [&] (size_t const c)
+    {
+        std::sort(bound(c), bound(c + 1));
+    });
+
+    for (size_t width = 1; width < chunks; width *= 2)
+    {
+        parallel_for((chunks + 2 * width - 1) / (2 * width), threads, [&] (size_t const m)
+        {
+            size_t const first = m * 2 * width;
+            std::inplace_merge(bound(first),
+                               bound(std::min(first + width, chunks)),
+                               bound(std::min(first + 2 * width, chunks)));
+        });
+    }
+}
+
+/*!\brief A queue with a fixed capacity to pass work between the threads of a pipeline.
+ * \tparam value_t The type of the values.
+ *
+ * \details
+ *
+ * push() blocks while the queue is full and pop() blocks while it is empty, so a fast producer cannot run ahead of a
+ * slow consumer by more than `capacity` values. After close(), push() discards values and pop() returns the remaining
+ * values followed by std::nullopt. Closing the queue when a stage fails therefore releases all other stages.
+ */
+template <typename value_t>
+class bounded_queue
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    bounded_queue() = delete; //!< Deleted.
+    bounded_queue(bounded_queue const &) = delete; //!< Deleted, holds a mutex.
+    bounded_queue & operator=(bounded_queue const &) = delete; //!< Deleted, holds a mutex.
+
+    //!\brief Construct a queue holding up to `capacity` values.
+    explicit bounded_queue(size_t const capacity) : capacity{std::max<size_t>(capacity, 1u)}
+    {}
+    //!\}
+
+    /*!\brief Appends a value, waits while the queue is full.
+     * \returns `false` if the queue was closed and the value was discarded.
+     */
+    bool push(value_t value)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        not_full.wait(lock, [this] () { return closed || values.size() < capacity; });
+        if (closed)
+            return false;
+
+        values.push_back(std::move(value));
+        lock.unlock();
+        not_empty.notify_one();
+        return true;
+    }
+
+    //!\brief Removes the first value, waits while the queue is empty. Returns std::nullopt once closed and empty.
+    std::optional<value_t> pop()
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        not_empty.wait(lock, [this] () { return closed || !values.empty(); });
+        if (values.empty())
+            return std::nullopt;
+
+        std::optional<value_t> value{std::move(values.front())};
+        values.pop_front();
+        lock.unlock();
+        not_full.notify_one();
+        return value;
+    }
+
+    //!\brief No more values are accepted, wakes all waiting threads.
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            closed = true;
+        }
+        not_full.notify_all();
+        not_empty.notify_all();
+    }
+
+private:
+    //!\brief The maximal number of values.
+    size_t const capacity;
+    //!\brief The values.
+    std::deque<value_t> values{};
+    //!\brief Whether the queue was closed.
+    bool closed{false};
+    //!\brief Guards all members.
+    std::mutex mutex{};
+    //!\brief Signalled when a value was removed.
+    std::condition_variable not_full{};
+    //!\brief Signalled when a value was added.
+    std::condition_variable not_empty{};
+};
+
+} // namespace minions
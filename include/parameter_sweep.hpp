@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::parse_sweep and minions::sweep_product.
+ */
+
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace minions
+{
+
+namespace detail
+{
+
+//!\brief Parses a non-negative decimal number, which must make up the whole text.
+inline uint64_t parse_sweep_number(std::string_view const text, std::string_view const value)
+{
+    uint64_t number{0};
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), number);
+    if (text.empty() || error != std::errc{} || end != text.data() + text.size())
+        throw std::invalid_argument{"Invalid value " + std::string{value} + ": " + std::string{text} +
+                                    " is not a number."};
+    return number;
+}
+
+} // namespace detail
+
+/*!\brief Parses a list of values and ranges, e.g. `15,19,21` or `15-31:2`.
+ * \param[in] value Comma separated elements, each either a number, or a range `first-last` or `first-last:step`,
+ *                  which includes `first` and every step-th number up to `last`.
+ * \returns The values in the given order, duplicates are kept.
+ * \throws std::invalid_argument if an element is not a number or a range with first <= last and a step of at least 1.
+ */
+inline std::vector<uint64_t> parse_sweep(std::string_view const value)
+{
+    std::vector<uint64_t> values{};
+    size_t begin{0};
+    while (begin <= value.size())
+    {
+        size_t end = value.find(',', begin);
+        if (end == std::string_view::npos)
+            end = value.size();
+        std::string_view element = value.substr(begin, end - begin);
+        begin = end + 1;
+
+        size_t const dash = element.find('-');
+        if (dash == std::string_view::npos)
+        {
+            values.push_back(detail::parse_sweep_number(element, value));
+            continue;
+        }
+
+        uint64_t step{1};
+        size_t const colon = element.find(':', dash);
+        if (colon != std::string_view::npos)
+        {
+            step = detail::parse_sweep_number(element.substr(colon + 1), value);
+            element = element.substr(0, colon);
+        }
+        uint64_t const first = detail::parse_sweep_number(element.substr(0, dash), value);
+        uint64_t const last = detail::parse_sweep_number(element.substr(dash + 1), value);
+        if (first > last || step == 0)
+            throw std::invalid_argument{"Invalid value " + std::string{value} + ": The range " + std::string{element} +
+                                        " must not be empty and the step must be at least 1."};
+
+        for (uint64_t number = first; number <= last; number += step)
+        {
+            values.push_back(number);
+            if (last - number < step)
+                break;
+        }
+    }
+    return values;
+}
+
+/*!\brief Returns all combinations of one value per dimension.
+ * \param[in] dimensions The values of every dimension.
+ * \returns The combinations, the last dimension varies fastest. There are none, if a dimension is empty.
+ */
+inline std::vector<std::vector<uint64_t>> sweep_product(std::vector<std::vector<uint64_t>> const & dimensions)
+{
+    std::vector<std::vector<uint64_t>> combinations{{}};
+    for (std::vector<uint64_t> const & dimension : dimensions)
+    {
+        std::vector<std::vector<uint64_t>> extended{};
+        extended.reserve(combinations.size() * dimension.size());
+        for (std::vector<uint64_t> const & combination : combinations)
+        {
+            for (uint64_t const value : dimension)
+            {
+                extended.push_back(combination);
+                extended.back().push_back(value);
+            }
+        }
+        combinations = std::move(extended);
+    }
+    return combinations;
+}
+
+} // namespace minions
@@ -0,0 +1,553 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::partitioned_count_table.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <seqan3/std/filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include "count_file.hpp"
+#include "flat_count_table.hpp"
+
+namespace minions
+{
+
+/*!\brief A count table for hash values, that stores the hash values in temporary files and counts them with a bounded
+ *        amount of memory.
+ *
+ * \details
+ *
+ * The hash values are partitioned into buckets by the prefix of a mixed hash value and appended to one temporary file
+ * per bucket, similar to the bins of KMC. write() counts one bucket at a time in a minions::flat_count_table, that is
+ * limited to the given amount of memory. A bucket with more distinct hash values is split into sub-buckets by the next
+ * bits of the prefix. Every bucket is stored as a run sorted by hash value and the runs are merged into a count file,
+ * that is identical to the one written from an in-memory table.
+ *
+ * Threads collect their hash values in a local buffer first (see add()), full buffers are appended to the files under
+ * the lock of their bucket.
+ */
+class partitioned_count_table
+{
+public:
+    //!\brief The number of buffered hash values per bucket in a local buffer.
+    static constexpr size_t buffer_size{1ULL << 12};
+    //!\brief The number of sub-buckets a bucket is split into, if its hash values do not fit into memory.
+    static constexpr size_t split_bits{4};
+
+    //!\brief The thread local buffers of all buckets.
+    using local_buffer_type = std::vector<std::vector<uint64_t>>;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    partitioned_count_table() = delete; //!< Deleted.
+    partitioned_count_table(partitioned_count_table const &) = delete; //!< Deleted, owns the temporary files.
+    partitioned_count_table(partitioned_count_table &&) = delete; //!< Deleted, buckets hold a mutex.
+    partitioned_count_table & operator=(partitioned_count_table const &) = delete; //!< Deleted, owns the temporary files.
+    partitioned_count_table & operator=(partitioned_count_table &&) = delete; //!< Deleted, buckets hold a mutex.
+
+    /*!\brief Creates the temporary files.
+     * \param[in] directory         The directory, in which a temporary directory for the files is created.
+     * \param[in] max_memory        The memory in bytes, that write() uses for counting a bucket.
+     * \param[in] number_of_buckets The number of buckets, is rounded up to the next power of two.
+     * \throws std::runtime_error if the temporary files cannot be created.
+     */
+    partitioned_count_table(std::filesystem::path const & directory,
+                            size_t const max_memory,
+                            size_t const number_of_buckets = 64u) :
+        temporary_directory{unique_directory(directory)}
+    {
+        // Every slot of the count table needs 10 bytes and three of four slots are sorted for the run, 6 bytes.
+        table_slots = std::bit_floor(std::max<size_t>(1024u, max_memory / (flat_count_table::bytes_per_slot + 6u)));
+
+        while ((1ULL << bucket_bits) < number_of_buckets)
+            ++bucket_bits;
+        buckets = std::vector<bucket>(1ULL << bucket_bits);
+
+        std::filesystem::create_directories(temporary_directory);
+        for (size_t i = 0; i < buckets.size(); ++i)
+        {
+            buckets[i].path = temporary_directory / ("bucket_" + std::to_string(i));
+            buckets[i].file.open(buckets[i].path, std::ios::binary);
+            if (!buckets[i].file)
+                throw std::runtime_error{"Could not create the temporary file " + buckets[i].path.string() + "."};
+        }
+    }
+
+    //!\brief Removes the temporary files.
+    ~partitioned_count_table()
+    {
+        buckets.clear();
+        std::error_code error{};
+        std::filesystem::remove_all(temporary_directory, error);
+    }
+    //!\}
+
+    //!\brief Returns an empty thread local buffer.
+    local_buffer_type local_buffer() const
+    {
+        return local_buffer_type(buckets.size());
+    }
+
+    /*!\brief Adds one occurrence of a hash value to a thread local buffer.
+     * \param[in,out] local The thread local buffer.
+     * \param[in]     hash  The hash value.
+     */
+    void add(local_buffer_type & local, uint64_t const hash)
+    {
+        size_t const b = bucket_of(hash, 0u, bucket_bits);
+        local[b].push_back(hash);
+        if (local[b].size() == buffer_size)
+            flush(local[b], b);
+    }
+
+    /*!\brief Appends all hash values of a thread local buffer to the temporary files.
+     * \param[in,out] local The thread local buffer, which is emptied.
+     */
+    void flush(local_buffer_type & local)
+    {
+        for (size_t b = 0; b < buckets.size(); ++b)
+            flush(local[b], b);
+    }
+
+    /*!\brief Counts all hash values and stores them as a count file. Not thread safe.
+     * \param[in] path       The output file.
+     * \param[in] parameters The method parameters.
+     * \returns The number of distinct hash values.
+     * \throws std::runtime_error if a file cannot be read or written.
+     *
+     * \details
+     *
+     * All local buffers must be flushed before. The temporary files are removed while they are counted.
+     */
+    uint64_t write(std::filesystem::path const & path, count_file_parameters const & parameters)
+    {
+        std::vector<run> runs{};
+        for (bucket & b : buckets)
+        {
+            b.file.close();
+            if (!b.file)
+                throw std::runtime_error{"Could not write the temporary file " + b.path.string() + "."};
+            count_bucket(b.path, b.size, bucket_bits, runs);
+        }
+
+        reduce_runs(runs);
+        uint64_t distinct{0};
+        for (run const & r : runs)
+            distinct += r.size;
+
+        std::ofstream outfile{path, std::ios::binary};
+        write_count_file_header(outfile, parameters, distinct);
+        write_values(runs, outfile, [] (uint64_t const hash, uint16_t) { return hash; });
+        write_values(runs, outfile, [] (uint64_t, uint16_t const count) { return count; });
+        if (!outfile)
+            throw std::runtime_error{"Could not write the count file " + path.string() + "."};
+
+        for (run const & r : runs)
+            std::filesystem::remove(r.path);
+        return distinct;
+    }
+
+    //!\brief Returns the number of slots, that the count table of a bucket may have.
+    size_t table_capacity() const noexcept
+    {
+        return table_slots;
+    }
+
+    //!\brief Returns the largest number of slots, that the count table of a bucket had in write().
+    size_t largest_table_capacity() const noexcept
+    {
+        return largest_capacity;
+    }
+
+private:
+    //!\brief One partition of the hash values.
+    struct bucket
+    {
+        //!\brief Guards the file.
+        std::mutex mutex{};
+        //!\brief The temporary file.
+        std::filesystem::path path{};
+        //!\brief The stream of the temporary file.
+        std::ofstream file{};
+        //!\brief The number of hash values in the file.
+        size_t size{0};
+    };
+
+    //!\brief A temporary file of records of a hash value and a count, sorted by hash value.
+    struct run
+    {
+        //!\brief The temporary file.
+        std::filesystem::path path{};
+        //!\brief The number of records.
+        size_t size{0};
+    };
+
+    //!\brief The size of a record of a run.
+    static constexpr size_t record_size{sizeof(uint64_t) + sizeof(uint16_t)};
+    //!\brief The largest number of runs, that are merged at once.
+    static constexpr size_t max_open_runs{256};
+
+    //!\brief The directory of the temporary files.
+    std::filesystem::path temporary_directory{};
+    //!\brief Number of bits of the prefix, that select a bucket.
+    size_t bucket_bits{0};
+    //!\brief The buckets.
+    std::vector<bucket> buckets{};
+    //!\brief The number of slots of the count table of write().
+    size_t table_slots{};
+    //!\brief The largest number of slots, that the count table of a bucket had.
+    size_t largest_capacity{0};
+
+    //!\brief Returns a directory for the temporary files, that no other table uses.
+    static std::filesystem::path unique_directory(std::filesystem::path const & directory)
+    {
+        static std::atomic<uint64_t> counter{0};
+        return directory / ("minions_tmp_" + std::to_string(getpid()) + "_" + std::to_string(counter++));
+    }
+
+    /*!\brief Selects a bucket by bits of the prefix of the mixed hash value, k-mer hashes rarely use the upper bits.
+     * \param[in] hash   The hash value.
+     * \param[in] skip   The number of leading bits of the prefix, that are skipped.
+     * \param[in] length The number of bits, that select the bucket.
+     */
+    static size_t bucket_of(uint64_t const hash, size_t const skip, size_t const length) noexcept
+    {
+        if (length == 0)
+            return 0;
+        return ((hash * 0x9E3779B97F4A7C15ULL) << skip) >> (64u - length);
+    }
+
+    //!\brief Appends the hash values of a local bucket to its file.
+    void flush(std::vector<uint64_t> & values, size_t const b)
+    {
+        if (values.empty())
+            return;
+
+        std::lock_guard<std::mutex> lock{buckets[b].mutex};
+        buckets[b].file.write(reinterpret_cast<char const *>(values.data()), values.size() * sizeof(uint64_t));
+        buckets[b].size += values.size();
+        values.clear();
+    }
+
+    /*!\brief Calls `callback(values)` for the hash values of a temporary file, in blocks.
+     * \param[in] path     The temporary file.
+     * \param[in] callback The callback, returns false to stop reading.
+     */
+    template <typename callback_t>
+    static void read_hashes(std::filesystem::path const & path, callback_t && callback)
+    {
+        std::ifstream infile{path, std::ios::binary};
+        if (!infile)
+            throw std::runtime_error{"Could not read the temporary file " + path.string() + "."};
+
+        std::vector<uint64_t> values(buffer_size * 16);
+        while (infile)
+        {
+            infile.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(uint64_t));
+            size_t const read = infile.gcount() / sizeof(uint64_t);
+            if (read > 0 && !callback(std::span<uint64_t const>{values.data(), read}))
+                return;
+        }
+    }
+
+    /*!\brief Counts the hash values of a temporary file into sorted runs and removes the file.
+     * \param[in]     path   The temporary file.
+     * \param[in]     size   The number of hash values in the file.
+     * \param[in]     used   The number of prefix bits, that all hash values of the file share.
+     * \param[in,out] runs   The runs, new runs are appended.
+     */
+    void count_bucket(std::filesystem::path const & path, size_t const size, size_t const used, std::vector<run> & runs)
+    {
+        if (size == 0)
+        {
+            std::filesystem::remove(path);
+            return;
+        }
+
+        // The table is sized for all hash values of the file, if they fit.
+        size_t const max_size = flat_count_table::max_size_for(table_slots);
+        flat_count_table table{std::min(size, max_size)};
+        bool fits{true};
+        read_hashes(path, [&] (std::span<uint64_t const> const values)
+        {
+            for (uint64_t const hash : values)
+            {
+                // With all bits of the prefix used, the hash values of the file are equal.
+                if (table.size() == max_size && used + split_bits <= 64u && !table.contains(hash))
+                    return fits = false;
+                table.add(hash);
+            }
+            return true;
+        });
+
+        largest_capacity = std::max(largest_capacity, table.capacity());
+        if (fits)
+        {
+            runs.push_back(write_run(table, path.string() + ".run"));
+        }
+        else
+        {
+            table.clear();
+            split_bucket(path, used, runs);
+        }
+        std::filesystem::remove(path);
+    }
+
+    //!\brief Splits a temporary file into sub-buckets by the next bits of the prefix and counts them.
+    void split_bucket(std::filesystem::path const & path, size_t const used, std::vector<run> & runs)
+    {
+        std::vector<bucket> parts(1ULL << split_bits);
+        for (size_t i = 0; i < parts.size(); ++i)
+        {
+            parts[i].path = path.string() + "_" + std::to_string(i);
+            parts[i].file.open(parts[i].path, std::ios::binary);
+            if (!parts[i].file)
+                throw std::runtime_error{"Could not create the temporary file " + parts[i].path.string() + "."};
+        }
+
+        std::vector<std::vector<uint64_t>> local(parts.size());
+        auto flush_part = [&] (size_t const i)
+        {
+            parts[i].file.write(reinterpret_cast<char const *>(local[i].data()), local[i].size() * sizeof(uint64_t));
+            parts[i].size += local[i].size();
+            local[i].clear();
+        };
+        read_hashes(path, [&] (std::span<uint64_t const> const values)
+        {
+            for (uint64_t const hash : values)
+            {
+                size_t const i = bucket_of(hash, used, split_bits);
+                local[i].push_back(hash);
+                if (local[i].size() == buffer_size)
+                    flush_part(i);
+            }
+            return true;
+        });
+
+        for (size_t i = 0; i < parts.size(); ++i)
+        {
+            flush_part(i);
+            parts[i].file.close();
+            if (!parts[i].file)
+                throw std::runtime_error{"Could not write the temporary file " + parts[i].path.string() + "."};
+            count_bucket(parts[i].path, parts[i].size, used + split_bits, runs);
+        }
+    }
+
+    //!\brief Writes the records of a run one after another.
+    class run_writer
+    {
+    public:
+        //!\brief Creates the run.
+        explicit run_writer(std::filesystem::path path) : result{std::move(path), 0u}, outfile{result.path, std::ios::binary}
+        {
+            block.reserve(buffer_size * record_size);
+        }
+
+        //!\brief Appends a record, the hash value must be larger than the one of the previous record.
+        void push(uint64_t const hash, uint16_t const count)
+        {
+            block.insert(block.end(), reinterpret_cast<char const *>(&hash), reinterpret_cast<char const *>(&hash + 1));
+            block.insert(block.end(), reinterpret_cast<char const *>(&count), reinterpret_cast<char const *>(&count + 1));
+            ++result.size;
+            if (block.size() == buffer_size * record_size)
+            {
+                outfile.write(block.data(), block.size());
+                block.clear();
+            }
+        }
+
+        //!\brief Writes the remaining records and returns the run.
+        run finish()
+        {
+            outfile.write(block.data(), block.size());
+            outfile.close();
+            if (!outfile)
+                throw std::runtime_error{"Could not write the temporary file " + result.path.string() + "."};
+            return result;
+        }
+
+    private:
+        //!\brief The written run.
+        run result;
+        //!\brief The stream of the run.
+        std::ofstream outfile;
+        //!\brief The records, that have not been written yet.
+        std::vector<char> block{};
+    };
+
+    //!\brief Reads the records of a run one after another.
+    class run_reader
+    {
+    public:
+        //!\brief Opens a run and reads the first record.
+        explicit run_reader(run const & r) : infile{r.path, std::ios::binary}, remaining{r.size}
+        {
+            if (!infile)
+                throw std::runtime_error{"Could not read the temporary file " + r.path.string() + "."};
+            next();
+        }
+
+        //!\brief Whether all records have been read.
+        bool empty() const noexcept
+        {
+            return position == block.size();
+        }
+
+        //!\brief The hash value of the current record.
+        uint64_t hash() const noexcept
+        {
+            uint64_t value{};
+            std::memcpy(&value, block.data() + position, sizeof(value));
+            return value;
+        }
+
+        //!\brief The count of the current record.
+        uint16_t count() const noexcept
+        {
+            uint16_t value{};
+            std::memcpy(&value, block.data() + position + sizeof(uint64_t), sizeof(value));
+            return value;
+        }
+
+        //!\brief Moves to the next record.
+        void next()
+        {
+            if (position + record_size < block.size())
+            {
+                position += record_size;
+                return;
+            }
+
+            size_t const records = std::min(remaining, buffer_size);
+            block.resize(records * record_size);
+            infile.read(block.data(), block.size());
+            if (static_cast<size_t>(infile.gcount()) != block.size())
+                throw std::runtime_error{"A temporary file of the count table is truncated."};
+            remaining -= records;
+            position = 0;
+        }
+
+    private:
+        //!\brief The stream of the run.
+        std::ifstream infile;
+        //!\brief The number of records, that have not been read into the block.
+        size_t remaining;
+        //!\brief The current block of records.
+        std::vector<char> block{};
+        //!\brief The position of the current record in the block.
+        size_t position{0};
+    };
+
+    //!\brief Stores the entries of a table as a run.
+    static run write_run(flat_count_table const & table, std::filesystem::path const & path)
+    {
+        run_writer writer{path};
+        for (uint64_t const hash : table.sorted_hashes())
+            writer.push(hash, table.count(hash));
+        return writer.finish();
+    }
+
+    /*!\brief Calls `callback(hash, count)` for the records of all runs in ascending order of the hash values.
+     * \param[in] runs     The runs, their hash values are disjoint.
+     * \param[in] callback The callback.
+     */
+    template <typename callback_t>
+    static void merge_runs(std::span<run const> const runs, callback_t && callback)
+    {
+        std::vector<run_reader> readers{};
+        readers.reserve(runs.size());
+        using entry = std::pair<uint64_t, size_t>;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue{};
+        for (run const & r : runs)
+        {
+            readers.emplace_back(r);
+            if (!readers.back().empty())
+                queue.emplace(readers.back().hash(), readers.size() - 1);
+        }
+
+        while (!queue.empty())
+        {
+            size_t const index = queue.top().second;
+            run_reader & reader = readers[index];
+            queue.pop();
+            callback(reader.hash(), reader.count());
+            reader.next();
+            if (!reader.empty())
+                queue.emplace(reader.hash(), index);
+        }
+    }
+
+    //!\brief Merges groups of runs, until all runs can be merged with at most `max_open_runs` open files.
+    void reduce_runs(std::vector<run> & runs) const
+    {
+        size_t generation{0};
+        while (runs.size() > max_open_runs)
+        {
+            std::vector<run> merged{};
+            for (size_t first = 0; first < runs.size(); first += max_open_runs)
+            {
+                std::span<run const> const group{runs.data() + first, std::min(max_open_runs, runs.size() - first)};
+                run_writer writer{temporary_directory / ("merged_" + std::to_string(generation) + "_" +
+                                                         std::to_string(merged.size()))};
+                merge_runs(group, [&] (uint64_t const hash, uint16_t const count) { writer.push(hash, count); });
+                merged.push_back(writer.finish());
+                for (run const & r : group)
+                    std::filesystem::remove(r.path);
+            }
+            runs = std::move(merged);
+            ++generation;
+        }
+    }
+
+    /*!\brief Merges the runs and writes a value of every record in ascending order of the hash values.
+     * \param[in]     runs    The runs, their hash values are disjoint.
+     * \param[in,out] outfile The output stream.
+     * \param[in]     value   Callable `value(hash, count)`, which returns the value to write.
+     */
+    template <typename value_t>
+    static void write_values(std::span<run const> const runs, std::ostream & outfile, value_t && value)
+    {
+        using value_type = decltype(value(uint64_t{}, uint16_t{}));
+
+        std::vector<value_type> block{};
+        block.reserve(buffer_size);
+        merge_runs(runs, [&] (uint64_t const hash, uint16_t const count)
+        {
+            block.push_back(value(hash, count));
+            if (block.size() == buffer_size)
+            {
+                outfile.write(reinterpret_cast<char const *>(block.data()), block.size() * sizeof(value_type));
+                block.clear();
+            }
+        });
+        outfile.write(reinterpret_cast<char const *>(block.data()), block.size() * sizeof(value_type));
+    }
+};
+
+} // namespace minions
@@ -0,0 +1,180 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::perf_counters.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#if defined(__linux__)
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace minions
+{
+
+/*!\brief Counts hardware events of the calling thread with the Linux `perf_event_open` interface.
+ *
+ * \details
+ *
+ * Every event is opened on its own, so events the processor or the virtual machine does not support do not hide the
+ * others. If the kernel does not allow counting, e.g. because of `/proc/sys/kernel/perf_event_paranoid`, or on other
+ * systems than Linux, no event is available and value() returns std::nullopt. Counts are scaled, if the kernel had to
+ * multiplex the counters.
+ */
+class perf_counters
+{
+public:
+    //!\brief The counted events.
+    enum event : size_t
+    {
+        cycles,        //!< CPU cycles.
+        instructions,  //!< Retired instructions.
+        branch_misses, //!< Mispredicted branches.
+        l1d_misses,    //!< Level 1 data cache read misses.
+        llc_misses,    //!< Last level cache read misses.
+        event_count    //!< The number of events.
+    };
+
+    //!\brief The names of the events.
+    static constexpr std::array<std::string_view, event_count> names{"cycles",
+                                                                     "instructions",
+                                                                     "branch_misses",
+                                                                     "l1d_misses",
+                                                                     "llc_misses"};
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    perf_counters(perf_counters const &) = delete; //!< Deleted, owns the file descriptors.
+    perf_counters & operator=(perf_counters const &) = delete; //!< Deleted, owns the file descriptors.
+
+    //!\brief Opens the counters, they do not count until start() is called.
+    perf_counters()
+    {
+        descriptors.fill(-1);
+#if defined(__linux__)
+        open_counter(cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open_counter(instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open_counter(branch_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+        open_counter(l1d_misses, PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D));
+        open_counter(llc_misses, PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_LL));
+#endif
+    }
+
+    //!\brief Closes the counters.
+    ~perf_counters()
+    {
+#if defined(__linux__)
+        for (int const descriptor : descriptors)
+            if (descriptor != -1)
+                close(descriptor);
+#endif
+    }
+    //!\}
+
+    //!\brief Whether the event can be counted.
+    bool available(event const e) const noexcept
+    {
+        return descriptors[e] != -1;
+    }
+
+    //!\brief Whether any event can be counted.
+    bool any_available() const noexcept
+    {
+        for (int const descriptor : descriptors)
+            if (descriptor != -1)
+                return true;
+        return false;
+    }
+
+    //!\brief Sets all counters to 0 and starts counting.
+    void start() noexcept
+    {
+#if defined(__linux__)
+        for (int const descriptor : descriptors)
+        {
+            if (descriptor != -1)
+            {
+                ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+                ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    //!\brief Stops counting.
+    void stop() noexcept
+    {
+#if defined(__linux__)
+        for (int const descriptor : descriptors)
+            if (descriptor != -1)
+                ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+#endif
+    }
+
+    //!\brief The number of events between start() and stop(), std::nullopt if the event is not available.
+    std::optional<uint64_t> value(event const e) const noexcept
+    {
+#if defined(__linux__)
+        if (available(e))
+        {
+            // The value, the time the counter was enabled and the time it was running.
+            std::array<uint64_t, 3> values{};
+            if (read(descriptors[e], values.data(), sizeof(values)) != sizeof(values))
+                return std::nullopt;
+            if (values[2] == 0)
+                return values[0];
+            return static_cast<uint64_t>(static_cast<double>(values[0]) * values[1] / values[2]);
+        }
+#endif
+        return std::nullopt;
+    }
+
+private:
+    //!\brief The file descriptors of the events, -1 for events that are not available.
+    std::array<int, event_count> descriptors{};
+
+#if defined(__linux__)
+    //!\brief The configuration of a cache read miss event.
+    static uint64_t cache_event(uint64_t const cache)
+    {
+        return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    //!\brief Opens a disabled counter for user space events of the calling thread.
+    void open_counter(event const e, uint32_t const type, uint64_t const config)
+    {
+        perf_event_attr attributes{};
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = type;
+        attributes.size = sizeof(attributes);
+        attributes.config = config;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        long const descriptor = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+        descriptors[e] = (descriptor < 0) ? -1 : static_cast<int>(descriptor);
+    }
+#endif
+};
+
+} // namespace minions
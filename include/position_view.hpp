@@ -0,0 +1,247 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::views::with_position.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+#include <seqan3/core/range/detail/adaptor_from_functor.hpp>
+
+namespace minions::detail
+{
+
+/*!\brief An iterator, that knows the position of its current value in the underlying range.
+ *
+ * \details
+ *
+ * The iterators of minions::detail::minimiser_view, seqan3::detail::modmer_view, seqan3::detail::syncmer_view,
+ * seqan3::detail::canonical_strobemer_view and the strobemer views model this concept. The position is counted in
+ * values of the range the view was applied to, e.g. in k-mers of the sequence for a minimiser.
+ */
+template <typename iterator_t>
+concept position_iterator = std::input_iterator<iterator_t> && requires (iterator_t const & it)
+{
+    { it.position() } -> std::convertible_to<size_t>;
+};
+
+/*!\brief The type returned by minions::views::with_position.
+ * \tparam urng_t The type of the underlying range, its iterator must model minions::detail::position_iterator.
+ * \implements std::ranges::view
+ *
+ * \details
+ *
+ * Each value is a `std::pair` of the value of the underlying range and its position. The view is not const-iterable.
+ */
+template <std::ranges::view urng_t>
+//!\cond
+    requires std::ranges::forward_range<urng_t> && position_iterator<std::ranges::iterator_t<urng_t>>
+//!\endcond
+class position_view : public std::ranges::view_interface<position_view<urng_t>>
+{
+private:
+    //!\brief The underlying range.
+    urng_t urange{};
+
+    //!\brief The iterator type of the underlying range.
+    using urng_iterator_t = std::ranges::iterator_t<urng_t>;
+    //!\brief The sentinel type of the underlying range.
+    using urng_sentinel_t = std::ranges::sentinel_t<urng_t>;
+
+    class iterator;
+    class sentinel;
+
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    position_view() = default; //!< Defaulted.
+    position_view(position_view const & rhs) = default; //!< Defaulted.
+    position_view(position_view && rhs) = default; //!< Defaulted.
+    position_view & operator=(position_view const & rhs) = default; //!< Defaulted.
+    position_view & operator=(position_view && rhs) = default; //!< Defaulted.
+    ~position_view() = default; //!< Defaulted.
+
+    /*!\brief Construct from a view.
+    * \param[in] urange The input range to process. Must model std::ranges::view and std::ranges::forward_range.
+    */
+    explicit position_view(urng_t urange) : urange{std::move(urange)}
+    {}
+    //!\}
+
+    //!\brief Returns an iterator to the first value.
+    iterator begin()
+    {
+        return iterator{std::ranges::begin(urange)};
+    }
+
+    //!\brief Returns the sentinel.
+    sentinel end()
+    {
+        return sentinel{std::ranges::end(urange)};
+    }
+};
+
+//!\brief The iterator of minions::detail::position_view.
+template <std::ranges::view urng_t>
+//!\cond
+    requires std::ranges::forward_range<urng_t> && position_iterator<std::ranges::iterator_t<urng_t>>
+//!\endcond
+class position_view<urng_t>::iterator
+{
+public:
+    /*!\name Associated types
+     * \{
+     */
+    //!\brief Type for distances between iterators.
+    using difference_type = std::ranges::range_difference_t<urng_t>;
+    //!\brief The value and its position.
+    using value_type = std::pair<std::ranges::range_value_t<urng_t>, size_t>;
+    //!\brief The pointer type.
+    using pointer = void;
+    //!\brief Reference to `value_type`.
+    using reference = value_type;
+    //!\brief Tag this class as a forward iterator.
+    using iterator_category = std::forward_iterator_tag;
+    //!\brief Tag this class as a forward iterator.
+    using iterator_concept = iterator_category;
+    //!\}
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    iterator() = default; //!< Defaulted.
+    iterator(iterator const &) = default; //!< Defaulted.
+    iterator(iterator &&) = default; //!< Defaulted.
+    iterator & operator=(iterator const &) = default; //!< Defaulted.
+    iterator & operator=(iterator &&) = default; //!< Defaulted.
+    ~iterator() = default; //!< Defaulted.
+
+    //!\brief Construct from an iterator of the underlying range.
+    explicit iterator(urng_iterator_t urng_iterator) : urng_iterator{std::move(urng_iterator)}
+    {}
+    //!\}
+
+    //!\brief Compare to another iterator.
+    friend bool operator==(iterator const & lhs, iterator const & rhs)
+    {
+        return lhs.urng_iterator == rhs.urng_iterator;
+    }
+
+    //!\brief Pre-increment.
+    iterator & operator++()
+    {
+        ++urng_iterator;
+        return *this;
+    }
+
+    //!\brief Post-increment.
+    iterator operator++(int)
+    {
+        iterator tmp{*this};
+        ++urng_iterator;
+        return tmp;
+    }
+
+    //!\brief Return the value and its position.
+    value_type operator*() const
+    {
+        return {*urng_iterator, urng_iterator.position()};
+    }
+
+    //!\brief Returns the iterator of the underlying range.
+    urng_iterator_t const & base() const noexcept
+    {
+        return urng_iterator;
+    }
+
+private:
+    //!\brief The iterator of the underlying range.
+    urng_iterator_t urng_iterator{};
+};
+
+//!\brief The sentinel of minions::detail::position_view.
+template <std::ranges::view urng_t>
+//!\cond
+    requires std::ranges::forward_range<urng_t> && position_iterator<std::ranges::iterator_t<urng_t>>
+//!\endcond
+class position_view<urng_t>::sentinel
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    sentinel() = default; //!< Defaulted.
+    sentinel(sentinel const &) = default; //!< Defaulted.
+    sentinel(sentinel &&) = default; //!< Defaulted.
+    sentinel & operator=(sentinel const &) = default; //!< Defaulted.
+    sentinel & operator=(sentinel &&) = default; //!< Defaulted.
+    ~sentinel() = default; //!< Defaulted.
+
+    //!\brief Construct from the sentinel of the underlying range.
+    explicit sentinel(urng_sentinel_t urng_sentinel) : urng_sentinel{std::move(urng_sentinel)}
+    {}
+    //!\}
+
+    //!\brief Compare to an iterator of the position_view.
+    friend bool operator==(iterator const & lhs, sentinel const & rhs)
+    {
+        return lhs.base() == rhs.urng_sentinel;
+    }
+
+private:
+    //!\brief The sentinel of the underlying range.
+    urng_sentinel_t urng_sentinel{};
+};
+
+//!\brief A deduction guide for the view class template.
+template <std::ranges::viewable_range rng_t>
+position_view(rng_t &&) -> position_view<std::views::all_t<rng_t>>;
+
+//!\brief minions::views::with_position's range adaptor object type.
+struct with_position_fn
+{
+    /*!\brief Call the view's constructor with the underlying view.
+     * \param[in] urange The input range to process. Must model std::ranges::viewable_range and its iterator must
+     *                   model minions::detail::position_iterator.
+     * \returns A range of pairs of the values of urange and their positions.
+     */
+    template <std::ranges::viewable_range urng_t>
+    constexpr auto operator()(urng_t && urange) const
+    {
+        return position_view{std::forward<urng_t>(urange)};
+    }
+};
+
+} // namespace minions::detail
+
+namespace minions::views
+{
+
+/*!\brief Yields the hashes of a minimiser, modmer, syncmer or strobemer view together with their positions.
+ * \returns A range of `std::pair`s of a hash and its position.
+ *
+ * \details
+ *
+ * The position of a minimiser, modmer or syncmer is the position of its k-mer in the sequence, the one of a strobemer
+ * the position of its first strobe. If the view is applied to another range of hashes, e.g. minimisers of strobemers,
+ * the position is the one in that range.
+ *
+ * ```cpp
+ * for (auto && [hash, position] : sequence | minimiser_hash(shape, window_size) | minions::views::with_position)
+ * ```
+ */
+inline constexpr auto with_position = seqan3::detail::adaptor_from_functor{detail::with_position_fn{}};
+
+} // namespace minions::views
@@ -244,8 +244,8 @@ public:
           window_dist{std::move(it.window_dist)},
           window_size{std::move(it.window_size)},
           multiplicator{std::move(it.multiplicator)},
-          multiplicator3{std::move(it.multiplicator3)}
-
+          multiplicator3{std::move(it.multiplicator3)},
+          first_position{it.first_position}
     {}
 
     /*!\brief Construct from begin iterator and end iterator of a given range over std::totally_ordered values, and the
@@ -438,6 +438,12 @@ public:
         return randstrobe_value;
     }
 
+    //!\brief Return the position of the randstrobe, i.e. of its first strobe.
+    size_t position() const noexcept
+    {
+        return first_position;
+    }
+
 private:
     //!\brief The randstrobe value.
     value_type randstrobe_value{};
@@ -469,6 +475,9 @@ private:
     //!\brief The multiplicator for order 3.
     uint64_t multiplicator3{};
 
+    //!\brief The position of first_iterator.
+    size_t first_position{};
+
     //!\brief Link two strobes.
     value_type linking(value_type const & first, value_type const & second)
     {
@@ -550,6 +559,7 @@ private:
     void next_randstrobe()
     {
         ++first_iterator;
+        ++first_position;
         if (second_iterator == urng_sentinel)
             return;
         if constexpr(order_3)
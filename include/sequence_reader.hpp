@@ -0,0 +1,546 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::sequence_reader.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <seqan3/std/filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+
+#include "batch_kernels.hpp"
+#include "gzip_input.hpp"
+#include "mapped_file.hpp"
+
+namespace minions
+{
+
+namespace detail
+{
+
+//!\brief The rank of every character, the same as seqan3::dna4 assigns: `U` is `T` and all other characters are `A`.
+inline constexpr std::array<uint8_t, 256> ascii_rank_table = [] ()
+{
+    std::array<uint8_t, 256> table{};
+    table['C'] = table['c'] = 1;
+    table['G'] = table['g'] = 2;
+    table['T'] = table['t'] = table['U'] = table['u'] = 3;
+    return table;
+}();
+
+//!\brief How a character of a sequence line is read.
+enum class sequence_character : uint8_t
+{
+    base,   //!< A character of seqan3::dna15, i.e. an IUPAC code.
+    space,  //!< Whitespace, which is skipped.
+    digit,  //!< A digit, which is skipped in FASTA files.
+    invalid //!< Any other character.
+};
+
+//!\brief The kind of every character, the same as seqan3::sequence_file_input reads into seqan3::dna4 by default.
+inline constexpr std::array<sequence_character, 256> sequence_character_table = [] ()
+{
+    std::array<sequence_character, 256> table{};
+    table.fill(sequence_character::invalid);
+    for (char const base : std::string_view{"ACGTUNRYSWKMBDHV"})
+        table[static_cast<uint8_t>(base)] = table[static_cast<uint8_t>(base - 'A' + 'a')] = sequence_character::base;
+    for (char const space : std::string_view{" \t\n\v\f\r"})
+        table[static_cast<uint8_t>(space)] = sequence_character::space;
+    for (char digit = '0'; digit <= '9'; ++digit)
+        table[static_cast<uint8_t>(digit)] = sequence_character::digit;
+    return table;
+}();
+
+//!\brief The position of the first character in `in`, that is no base, or `size` if there is none.
+inline size_t find_non_base_scalar(char const * const in, size_t const size) noexcept
+{
+    size_t i = 0;
+    while (i < size && sequence_character_table[static_cast<uint8_t>(in[i])] == sequence_character::base)
+        ++i;
+    return i;
+}
+
+//!\brief `out[i] = ascii_rank_table[in[i]]` for all i < size.
+inline void ascii_to_rank_scalar(char const * const in, size_t const size, uint8_t * const out) noexcept
+{
+    for (size_t i = 0; i < size; ++i)
+        out[i] = ascii_rank_table[static_cast<uint8_t>(in[i])];
+}
+
+#if MINIONS_X86_KERNELS
+/*!\name x86 kernels
+ * \brief The rank is looked up by the low nibble of the upper case character, which is the same for the two cases of a
+ *        letter. Characters with the nibble of `C`, `G`, `T` or `U`, but another value are masked to `A`.
+ * \{
+ */
+__attribute__((target("sse4.2")))
+inline void ascii_to_rank_sse4_2(char const * const in, size_t const size, uint8_t * const out) noexcept
+{
+    __m128i const table = _mm_setr_epi8(0, 0, 0, 1, 3, 3, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i const to_upper = _mm_set1_epi8(static_cast<char>(0xDF));
+    __m128i const low_nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i const upper = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i)), to_upper);
+        __m128i const valid = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(upper, _mm_set1_epi8('C')),
+                                                        _mm_cmpeq_epi8(upper, _mm_set1_epi8('G'))),
+                                           _mm_or_si128(_mm_cmpeq_epi8(upper, _mm_set1_epi8('T')),
+                                                        _mm_cmpeq_epi8(upper, _mm_set1_epi8('U'))));
+        __m128i const ranks = _mm_shuffle_epi8(table, _mm_and_si128(upper, low_nibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_and_si128(ranks, valid));
+    }
+    ascii_to_rank_scalar(in + i, size - i, out + i);
+}
+
+__attribute__((target("avx2")))
+inline void ascii_to_rank_avx2(char const * const in, size_t const size, uint8_t * const out) noexcept
+{
+    __m256i const table = _mm256_setr_epi8(0, 0, 0, 1, 3, 3, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0,
+                                           0, 0, 0, 1, 3, 3, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i const to_upper = _mm256_set1_epi8(static_cast<char>(0xDF));
+    __m256i const low_nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i const upper = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i)),
+                                               to_upper);
+        __m256i const valid = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(upper, _mm256_set1_epi8('C')),
+                                                              _mm256_cmpeq_epi8(upper, _mm256_set1_epi8('G'))),
+                                              _mm256_or_si256(_mm256_cmpeq_epi8(upper, _mm256_set1_epi8('T')),
+                                                              _mm256_cmpeq_epi8(upper, _mm256_set1_epi8('U'))));
+        __m256i const ranks = _mm256_shuffle_epi8(table, _mm256_and_si256(upper, low_nibble));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_and_si256(ranks, valid));
+    }
+    ascii_to_rank_scalar(in + i, size - i, out + i);
+}
+
+// The bases are the letters ACGTUNRYSWKMBDHV with the case bit cleared, i.e. 0x41 to 0x59. A character is a base, if
+// the bit of its high nibble (1 for 0x4_, 2 for 0x5_) is set in the table entry of its low nibble.
+__attribute__((target("sse4.2")))
+inline size_t find_non_base_sse4_2(char const * const in, size_t const size) noexcept
+{
+    __m128i const low_table = _mm_setr_epi8(0, 1, 3, 3, 3, 2, 2, 3, 1, 2, 0, 1, 0, 1, 1, 0);
+    __m128i const high_table = _mm_setr_epi8(0, 0, 0, 0, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i const to_upper = _mm_set1_epi8(static_cast<char>(0xDF));
+    __m128i const low_nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i const upper = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<__m128i const *>(in + i)), to_upper);
+        __m128i const low = _mm_shuffle_epi8(low_table, _mm_and_si128(upper, low_nibble));
+        __m128i const high = _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi16(upper, 4), low_nibble));
+        __m128i const no_base = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+        if (unsigned const mask = _mm_movemask_epi8(no_base); mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    return i + find_non_base_scalar(in + i, size - i);
+}
+
+__attribute__((target("avx2")))
+inline size_t find_non_base_avx2(char const * const in, size_t const size) noexcept
+{
+    __m256i const low_table = _mm256_setr_epi8(0, 1, 3, 3, 3, 2, 2, 3, 1, 2, 0, 1, 0, 1, 1, 0,
+                                               0, 1, 3, 3, 3, 2, 2, 3, 1, 2, 0, 1, 0, 1, 1, 0);
+    __m256i const high_table = _mm256_setr_epi8(0, 0, 0, 0, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                0, 0, 0, 0, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m256i const to_upper = _mm256_set1_epi8(static_cast<char>(0xDF));
+    __m256i const low_nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i const upper = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(in + i)),
+                                               to_upper);
+        __m256i const low = _mm256_shuffle_epi8(low_table, _mm256_and_si256(upper, low_nibble));
+        __m256i const high = _mm256_shuffle_epi8(high_table,
+                                                 _mm256_and_si256(_mm256_srli_epi16(upper, 4), low_nibble));
+        __m256i const no_base = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256());
+        if (unsigned const mask = _mm256_movemask_epi8(no_base); mask != 0)
+            return i + __builtin_ctz(mask);
+    }
+    return i + find_non_base_scalar(in + i, size - i);
+}
+//!\}
+#endif
+
+/*!\brief Converts characters to the ranks of seqan3::dna4, see minions::detail::ascii_rank_table.
+ * \param[in]  in    The characters.
+ * \param[in]  size  The number of characters.
+ * \param[out] out   The ranks, must hold `size` values.
+ * \param[in]  level The instruction set to use, must be supported by the CPU.
+ */
+inline void ascii_to_rank(char const * const in,
+                          size_t const size,
+                          uint8_t * const out,
+                          simd_level const level = supported_simd_level()) noexcept
+{
+#if MINIONS_X86_KERNELS
+    if (level == simd_level::avx2)
+        return ascii_to_rank_avx2(in, size, out);
+    if (level == simd_level::sse4_2)
+        return ascii_to_rank_sse4_2(in, size, out);
+#endif
+    ascii_to_rank_scalar(in, size, out);
+}
+
+/*!\brief Finds the first character, that is no base, see minions::detail::sequence_character_table.
+ * \param[in] in    The characters.
+ * \param[in] size  The number of characters.
+ * \param[in] level The instruction set to use, must be supported by the CPU.
+ * \returns The position of the character, `size` if all characters are bases.
+ */
+inline size_t find_non_base(char const * const in,
+                            size_t const size,
+                            simd_level const level = supported_simd_level()) noexcept
+{
+#if MINIONS_X86_KERNELS
+    if (level == simd_level::avx2)
+        return find_non_base_avx2(in, size);
+    if (level == simd_level::sse4_2)
+        return find_non_base_sse4_2(in, size);
+#endif
+    return find_non_base_scalar(in, size);
+}
+
+} // namespace detail
+
+/*!\brief Reads the records of a FASTA or FASTQ file, which may be compressed with gzip.
+ *
+ * \details
+ *
+ * The format is detected by the first character, `>` for FASTA and `@` for FASTQ. Sequences and qualities may span
+ * several lines. Line ends are found with `std::memchr` and characters, that are no bases, with
+ * minions::detail::find_non_base. Like seqan3::sequence_file_input, whitespace in sequence lines and digits in sequence
+ * lines of FASTA files are skipped and any other character, that is not an IUPAC code of seqan3::dna15, is rejected,
+ * see minions::detail::sequence_character_table. The bases are converted to seqan3::dna4 with
+ * minions::detail::ascii_rank_table, i.e. all characters but `ACGTU` in either case become `A`.
+ *
+ * Uncompressed files are mapped into memory and parsed in place. Files compressed with gzip are decompressed by
+ * minions::gzip_input on background threads, while the records of the chunks decompressed so far are read. Files
+ * compressed with other formats cannot be read, see can_read().
+ *
+ * The id, sequence() and text() of the current record are valid until next() is called. They are stored in buffers,
+ * that are reused for all records, and sequence() and text() are only computed if they are called.
+ */
+class sequence_reader
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    sequence_reader() = default; //!< Defaulted.
+    sequence_reader(sequence_reader const &) = delete; //!< Deleted, owns the memory mapping.
+    sequence_reader(sequence_reader &&) = default; //!< Defaulted.
+    sequence_reader & operator=(sequence_reader const &) = delete; //!< Deleted, owns the memory mapping.
+    sequence_reader & operator=(sequence_reader &&) = default; //!< Defaulted.
+    ~sequence_reader() = default; //!< Defaulted.
+
+    /*!\brief Opens a sequence file.
+     * \param[in] path    The sequence file, see can_read().
+     * \param[in] threads The number of threads, that decompress a file in the BGZF format.
+     * \throws std::runtime_error if the file cannot be opened, mapped or decompressed.
+     * \throws std::invalid_argument if the file is neither empty, nor a FASTA or FASTQ file.
+     */
+    explicit sequence_reader(std::filesystem::path const & path, size_t const threads = 1) :
+        file_path{path},
+        file{path}
+    {
+        if (gzip_input::is_gzip(file.data()))
+        {
+            compressed = std::make_unique<gzip_input>(std::move(file), path, threads);
+            exhausted = false;
+        }
+        else
+        {
+            content = file.data();
+        }
+
+        skip_line_breaks();
+        while (position == content.size() && !exhausted)
+        {
+            refill();
+            skip_line_breaks();
+        }
+
+        if (position < content.size())
+        {
+            if (content[position] != '>' && content[position] != '@')
+                throw std::invalid_argument{"The sequence file " + path.string() +
+                                            " is neither a FASTA nor a FASTQ file."};
+            fastq = content[position] == '@';
+        }
+    }
+    //!\}
+
+    /*!\brief Whether the file can be read by minions::sequence_reader, i.e. it is a regular file that is not compressed
+     *        with bzip2 or zstd.
+     * \param[in] path The sequence file.
+     * \returns false if the file cannot be opened.
+     */
+    static bool can_read(std::filesystem::path const & path) noexcept
+    {
+        int const file_descriptor = open(path.c_str(), O_RDONLY);
+        if (file_descriptor == -1)
+            return false;
+
+        std::array<unsigned char, 4> magic{};
+        struct stat file_status{};
+        bool const regular = fstat(file_descriptor, &file_status) == 0 && S_ISREG(file_status.st_mode);
+        ssize_t const size = regular ? read(file_descriptor, magic.data(), magic.size()) : -1;
+        close(file_descriptor);
+
+        if (size < 0)
+            return false;
+        bool const bzip2 = size >= 3 && magic[0] == 'B' && magic[1] == 'Z' && magic[2] == 'h';
+        bool const zstd = size >= 4 && magic[0] == 0x28 && magic[1] == 0xB5 && magic[2] == 0x2F && magic[3] == 0xFD;
+        return !bzip2 && !zstd;
+    }
+
+    /*!\brief Moves to the next record.
+     * \returns false if there are no more records.
+     * \throws std::invalid_argument if the record is malformed or has an invalid character.
+     * \throws std::runtime_error if the file cannot be decompressed.
+     */
+    bool next()
+    {
+        std::optional<bool> found = parse_record();
+        while (!found)
+        {
+            // The record continues in the next chunks. The content after the start of the record is at least doubled
+            // before it is parsed again, so a long record is parsed only a logarithmic number of times.
+            position = record_start;
+            size_t const target = 2 * (content.size() - record_start);
+            do
+            {
+                refill();
+            }
+            while (!exhausted && content.size() - record_start < target);
+            found = parse_record();
+        }
+        return *found;
+    }
+
+    //!\brief The id of the current record, i.e. the header line without `>` or `@`.
+    std::string_view id() const noexcept
+    {
+        return current_id;
+    }
+
+    //!\brief The number of bases of the current record.
+    size_t size() const noexcept
+    {
+        return length;
+    }
+
+    //!\brief The sequence of the current record.
+    std::span<seqan3::dna4 const> sequence()
+    {
+        static_assert(sizeof(seqan3::dna4) == 1, "The ranks are written into the memory of the seqan3::dna4 values.");
+
+        if (!ranks_valid)
+        {
+            ranks.resize(length);
+            uint8_t * out = reinterpret_cast<uint8_t *>(ranks.data());
+            for (std::string_view const line : lines)
+            {
+                detail::ascii_to_rank(line.data(), line.size(), out);
+                out += line.size();
+            }
+            ranks_valid = true;
+        }
+        return {ranks.data(), length};
+    }
+
+    //!\brief The sequence of the current record as it is stored in the file, without line breaks and skipped characters.
+    std::string & text()
+    {
+        if (!characters_valid)
+        {
+            characters.clear();
+            for (std::string_view const line : lines)
+                characters.append(line);
+            characters_valid = true;
+        }
+        return characters;
+    }
+
+private:
+    //!\brief The sequence file, for error messages.
+    std::filesystem::path file_path{};
+    //!\brief The memory mapping of an uncompressed file.
+    mapped_file file{};
+    //!\brief The decompression of a compressed file, nullptr for uncompressed files.
+    std::unique_ptr<gzip_input> compressed{};
+    //!\brief The decompressed content from the current record on, for compressed files.
+    std::vector<char> buffer{};
+    //!\brief The content that is parsed, the mapping or the buffer.
+    std::span<char const> content{};
+    //!\brief The number of decompressed bytes, that were removed from the buffer.
+    size_t discarded{0};
+    //!\brief Whether the content reaches the end of the file.
+    bool exhausted{true};
+    //!\brief Whether the file is a FASTQ file.
+    bool fastq{false};
+    //!\brief The position of the next record in the content.
+    size_t position{0};
+    //!\brief The position of the current record in the content.
+    size_t record_start{0};
+    //!\brief The id of the current record.
+    std::string_view current_id{};
+    //!\brief The sequence lines of the current record.
+    std::vector<std::string_view> lines{};
+    //!\brief The number of bases of the current record.
+    size_t length{0};
+    //!\brief The converted sequence, reused for all records.
+    std::vector<seqan3::dna4> ranks{};
+    //!\brief Whether ranks holds the current record.
+    bool ranks_valid{false};
+    //!\brief The characters of the sequence, reused for all records.
+    std::string characters{};
+    //!\brief Whether characters holds the current record.
+    bool characters_valid{false};
+
+    /*!\brief Parses the record at the current position.
+     * \returns Whether there was a record, std::nullopt if the record may continue after the end of the content.
+     */
+    std::optional<bool> parse_record()
+    {
+        lines.clear();
+        length = 0;
+        ranks_valid = false;
+        characters_valid = false;
+
+        skip_line_breaks();
+        record_start = position;
+        if (position == content.size())
+            return exhausted ? std::optional<bool>{false} : std::nullopt;
+
+        char const marker = fastq ? '@' : '>';
+        if (content[position] != marker)
+            throw_malformed("does not start with " + std::string{marker});
+        current_id = next_line().substr(1);
+
+        // The sequence lines end at the next record for FASTA and at the separator line for FASTQ.
+        char const end_marker = fastq ? '+' : '>';
+        while (position < content.size() && content[position] != end_marker)
+            add_sequence_line(next_line());
+
+        size_t qualities{0};
+        if (fastq && position < content.size())
+        {
+            next_line();
+            while (qualities < length && position < content.size())
+            {
+                std::string_view const line = next_line();
+                qualities += std::ranges::count_if(line, [] (char const character)
+                {
+                    return detail::sequence_character_table[static_cast<uint8_t>(character)] !=
+                           detail::sequence_character::space;
+                });
+            }
+        }
+
+        // Unless the file ends, the last line may be incomplete or the record may have more lines.
+        if (position == content.size() && !exhausted)
+            return std::nullopt;
+        if (fastq && qualities != length)
+            throw_malformed("has " + std::to_string(qualities) + " qualities for " + std::to_string(length) + " bases");
+        return true;
+    }
+
+    /*!\brief Appends the bases of a sequence line to the lines of the current record.
+     * \param[in] line The sequence line, its bases are split into several lines at skipped characters.
+     * \throws std::invalid_argument if the line has an invalid character.
+     */
+    void add_sequence_line(std::string_view line)
+    {
+        while (!line.empty())
+        {
+            size_t const bases = detail::find_non_base(line.data(), line.size());
+            if (bases > 0)
+            {
+                lines.push_back(line.substr(0, bases));
+                length += bases;
+            }
+            if (bases == line.size())
+                return;
+
+            detail::sequence_character const kind = detail::sequence_character_table[static_cast<uint8_t>(line[bases])];
+            if (kind == detail::sequence_character::invalid || (kind == detail::sequence_character::digit && fastq))
+                throw_malformed("has the invalid character '" + std::string{line[bases]} + "' in its sequence");
+            line.remove_prefix(bases + 1);
+        }
+    }
+
+    //!\brief Removes the content before the current record and appends the next decompressed chunk.
+    void refill()
+    {
+        buffer.erase(buffer.begin(), buffer.begin() + record_start);
+        discarded += record_start;
+        position -= record_start;
+        record_start = 0;
+
+        std::optional<std::vector<char>> chunk = compressed->next();
+        if (!chunk)
+            exhausted = true;
+        else if (buffer.empty())
+            buffer = std::move(*chunk);
+        else
+            buffer.insert(buffer.end(), chunk->begin(), chunk->end());
+        content = buffer;
+    }
+
+    //!\brief Skips empty lines, e.g. at the start or the end of the file.
+    void skip_line_breaks() noexcept
+    {
+        while (position < content.size() && (content[position] == '\n' || content[position] == '\r'))
+            ++position;
+    }
+
+    //!\brief Returns the line at the current position without the line break and moves to the next line.
+    std::string_view next_line() noexcept
+    {
+        char const * const begin = content.data() + position;
+        size_t const rest = content.size() - position;
+        char const * const line_break = static_cast<char const *>(std::memchr(begin, '\n', rest));
+        size_t line_size = (line_break == nullptr) ? rest : line_break - begin;
+        position += line_size + (line_break != nullptr);
+        if (line_size > 0 && begin[line_size - 1] == '\r')
+            --line_size;
+        return {begin, line_size};
+    }
+
+    //!\brief Throws the std::invalid_argument for a malformed record.
+    [[noreturn]] void throw_malformed(std::string const & problem) const
+    {
+        throw std::invalid_argument{"The sequence file " + file_path.string() + " is malformed, the record at byte " +
+                                    std::to_string(discarded + record_start) + " " + problem + "."};
+    }
+};
+
+} // namespace minions
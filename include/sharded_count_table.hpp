@@ -0,0 +1,212 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::sharded_count_table.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <seqan3/std/filesystem>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "count_file.hpp"
+#include "flat_count_table.hpp"
+
+namespace minions
+{
+
+/*!\brief A count table for hash values that can be filled from multiple threads.
+ *
+ * \details
+ *
+ * The table is partitioned into shards by the prefix of a mixed hash value, every shard is a
+ * minions::flat_count_table guarded by its own mutex. Threads count their hash values in a local table first and merge
+ * it with merge(), which locks every shard at most once. Counts saturate at `max_count`, like the counts stored by
+ * `minions counts`.
+ *
+ * write() sorts one shard at a time and frees its table, then merges the sorted shards into a count file, that is
+ * identical to the one written from a single minions::flat_count_table.
+ */
+class sharded_count_table
+{
+public:
+    //!\brief The largest stored count.
+    static constexpr uint16_t max_count{flat_count_table::max_count};
+
+    //!\brief The type of the thread local tables, which are merged into the shards.
+    using local_table_type = flat_count_table;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    sharded_count_table() : sharded_count_table{64u} {} //!< Uses 64 shards.
+    sharded_count_table(sharded_count_table const &) = delete; //!< Deleted, shards hold a mutex.
+    sharded_count_table(sharded_count_table &&) = delete; //!< Deleted, shards hold a mutex.
+    sharded_count_table & operator=(sharded_count_table const &) = delete; //!< Deleted, shards hold a mutex.
+    sharded_count_table & operator=(sharded_count_table &&) = delete; //!< Deleted, shards hold a mutex.
+    ~sharded_count_table() = default; //!< Defaulted.
+
+    /*!\brief Construct with a given number of shards.
+     * \param[in] number_of_shards The number of shards, is rounded up to the next power of two.
+     */
+    explicit sharded_count_table(size_t const number_of_shards)
+    {
+        while ((1ULL << shard_bits) < number_of_shards)
+            ++shard_bits;
+        shards = std::vector<shard>(1ULL << shard_bits);
+    }
+    //!\}
+
+    /*!\brief Merges a thread local table into the shards.
+     * \param[in] local The thread local table.
+     */
+    void merge(local_table_type const & local)
+    {
+        std::vector<std::vector<std::pair<uint64_t, uint16_t>>> per_shard(shards.size());
+        local.for_each([&] (uint64_t const hash, uint16_t const count)
+        {
+            per_shard[shard_of(hash)].emplace_back(hash, count);
+        });
+
+        for (size_t i = 0; i < shards.size(); ++i)
+        {
+            if (per_shard[i].empty())
+                continue;
+
+            std::lock_guard<std::mutex> lock{shards[i].mutex};
+            for (auto && [hash, count] : per_shard[i])
+                shards[i].table.add(hash, count);
+        }
+    }
+
+    //!\brief Returns the number of distinct hash values. Not thread safe.
+    size_t size() const
+    {
+        size_t result{0};
+        for (auto const & s : shards)
+            result += s.table.size();
+        return result;
+    }
+
+    /*!\brief Stores the counts as a count file, sorted by hash value. Not thread safe.
+     * \param[in] path       The output file.
+     * \param[in] parameters The method parameters.
+     * \returns The number of distinct hash values.
+     * \throws std::runtime_error if the file cannot be written.
+     *
+     * \details
+     *
+     * The shards are emptied while the counts are collected.
+     */
+    uint64_t write(std::filesystem::path const & path, count_file_parameters const & parameters)
+    {
+        // A sorted shard takes 10 bytes per entry, only the table of one shard is sorted at a time.
+        std::vector<sorted_shard> sorted(shards.size());
+        uint64_t distinct{0};
+        for (size_t i = 0; i < shards.size(); ++i)
+        {
+            flat_count_table & table = shards[i].table;
+            sorted[i].hashes = table.sorted_hashes();
+            sorted[i].counts.resize(sorted[i].hashes.size());
+            for (size_t j = 0; j < sorted[i].hashes.size(); ++j)
+                sorted[i].counts[j] = table.count(sorted[i].hashes[j]);
+            table.clear();
+            distinct += sorted[i].hashes.size();
+        }
+
+        std::ofstream outfile{path, std::ios::binary};
+        write_count_file_header(outfile, parameters, distinct);
+        write_values(sorted, outfile, &sorted_shard::hashes);
+        write_values(sorted, outfile, &sorted_shard::counts);
+        if (!outfile)
+            throw std::runtime_error{"Could not write the count file " + path.string() + "."};
+        return distinct;
+    }
+
+private:
+    //!\brief One partition of the table.
+    struct shard
+    {
+        //!\brief Guards the table.
+        std::mutex mutex{};
+        //!\brief The counts of all hash values belonging to this shard.
+        flat_count_table table{};
+    };
+
+    //!\brief The entries of a shard, sorted by hash value.
+    struct sorted_shard
+    {
+        //!\brief The hash values in ascending order.
+        std::vector<uint64_t> hashes{};
+        //!\brief The counts, `counts[i]` belongs to `hashes[i]`.
+        std::vector<uint16_t> counts{};
+    };
+
+    //!\brief The number of values, that are written at once.
+    static constexpr size_t block_size{1ULL << 12};
+
+    //!\brief Number of bits of the hash prefix that select a shard.
+    size_t shard_bits{0};
+
+    //!\brief The shards.
+    std::vector<shard> shards{};
+
+    //!\brief Selects the shard by the prefix of the mixed hash value, k-mer hashes rarely use the upper bits.
+    size_t shard_of(uint64_t const hash) const noexcept
+    {
+        if (shard_bits == 0)
+            return 0;
+        return (hash * 0x9E3779B97F4A7C15ULL) >> (64u - shard_bits);
+    }
+
+    /*!\brief Merges the sorted shards and writes a value of every entry in ascending order of the hash values.
+     * \param[in]     sorted  The sorted shards, their hash values are disjoint.
+     * \param[in,out] outfile The output stream.
+     * \param[in]     values  The member of minions::sharded_count_table::sorted_shard, whose values are written.
+     */
+    template <typename value_t>
+    static void write_values(std::vector<sorted_shard> const & sorted,
+                             std::ostream & outfile,
+                             std::vector<value_t> sorted_shard::* const values)
+    {
+        // The next hash value of a shard and the shard.
+        using entry = std::pair<uint64_t, size_t>;
+        std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue{};
+        std::vector<size_t> positions(sorted.size());
+        for (size_t i = 0; i < sorted.size(); ++i)
+            if (!sorted[i].hashes.empty())
+                queue.emplace(sorted[i].hashes[0], i);
+
+        std::vector<value_t> block{};
+        block.reserve(block_size);
+        while (!queue.empty())
+        {
+            size_t const i = queue.top().second;
+            queue.pop();
+            block.push_back((sorted[i].*values)[positions[i]]);
+            if (++positions[i] < sorted[i].hashes.size())
+                queue.emplace(sorted[i].hashes[positions[i]], i);
+            if (block.size() == block_size)
+            {
+                outfile.write(reinterpret_cast<char const *>(block.data()), block.size() * sizeof(value_t));
+                block.clear();
+            }
+        }
+        outfile.write(reinterpret_cast<char const *>(block.data()), block.size() * sizeof(value_t));
+    }
+};
+
+} // namespace minions
@@ -22,6 +22,8 @@
 #include <seqan3/utility/range/concept.hpp>
 #include <seqan3/utility/type_traits/lazy_conditional.hpp>
 
+#include "syncmer_classifier.hpp"
+
 namespace seqan3::detail
 {
 // ---------------------------------------------------------------------------------------------------------------------
@@ -326,7 +328,8 @@ public:
           urng1_sentinel{std::move(it.urng1_sentinel)},
           urng3_iterator{std::move(it.urng3_iterator)},
           urng4_iterator{std::move(it.urng4_iterator)},
-          w_size{std::move(it.w_size)}
+          w_size{std::move(it.w_size)},
+          syncmer_position{it.syncmer_position}
     {}
 
     /*!\brief Construct from begin and end iterators of a given range over std::totally_ordered values, and the number
@@ -432,6 +435,12 @@ public:
         return syncmer_value;
     }
 
+    //!\brief Return the position of the syncmer, i.e. of its k-mer.
+    size_t position() const noexcept
+    {
+        return syncmer_position;
+    }
+
 private:
     //!\brief The syncmer value.
     value_type syncmer_value{};
@@ -469,6 +478,9 @@ private:
     //!brief The position that determines if an element is a syncmer.
     std::vector<int> positions{};
 
+    //!\brief The position of the syncmer, i.e. of urng2_iterator.
+    size_t syncmer_position{};
+
     //!\brief Increments iterator by 1.
     void next_unique_syncmer()
     {
@@ -478,6 +490,7 @@ private:
     //!\brief Advances both windows to the next position.
     void advance_window()
     {
+        ++syncmer_position;
         ++urng1_iterator;
         ++urng2_iterator;
 
@@ -781,39 +794,16 @@ seqan3::dna4 transform_to_dna(uint64_t letter)
     }
 }
 
-bool syncmer_filter(uint64_t seq, uint64_t smer, uint64_t kmer, std::vector<int> const positions, uint64_t const seed = 0x8F3F73B5CF1C9ADE)
+/*!\brief Returns whether a k-mer hash is a syncmer.
+ * \param[in] seq       The k-mer hash.
+ * \param[in] smer      The size of the s-mers.
+ * \param[in] kmer      The size of the k-mers.
+ * \param[in] positions The positions of the smallest s-mer, that make a k-mer a syncmer.
+ * \param[in] seed      The seed the k-mer hash is skewed with.
+ * \details
+ * Prefer constructing a minions::syncmer_classifier once, if many k-mers are tested with the same parameters.
+ */
+inline bool syncmer_filter(uint64_t seq, uint64_t smer, uint64_t kmer, std::vector<int> const & positions, uint64_t const seed = 0x8F3F73B5CF1C9ADE)
 {
-    uint64_t mod{};
-    seq = seq ^ seed;
-    std::deque<seqan3::dna4> text{};
-
-    while(seq > 4)
-    {
-        mod = seq % 4;
-        seq = seq/4;
-        text.push_front(transform_to_dna(mod));
-    }
-    mod = seq % 4;
-    text.push_front(transform_to_dna(mod));
-
-    while(text.size() < kmer)
-    {
-        text.push_front(transform_to_dna(0));
-    }
-
-    auto smers = text | seqan3::views::kmer_hash(seqan3::shape(seqan3::ungapped(smer)));
-    size_t min_pos{};
-    uint64_t min = std::numeric_limits<uint64_t>::max();
-    int i{0};
-    for (auto && hash : smers)
-    {
-        if (hash < min)
-        {
-            min = hash;
-            min_pos = i;
-        }
-        ++i;
-    }
-
-    return (std::find(positions.begin(), positions.end(), min_pos) != positions.end());
+    return minions::syncmer_classifier{smer, kmer, positions, seed}(seq);
 }
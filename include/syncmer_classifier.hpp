@@ -0,0 +1,180 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::syncmer_classifier.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace minions
+{
+
+/*!\brief Decides whether a k-mer hash is a syncmer, working directly on the 2-bit packed value.
+ *
+ * \details
+ *
+ * A k-mer is a syncmer, if the position of its smallest s-mer is one of the given positions. The classifier removes
+ * the seed, extracts every s-mer by a shift and a mask, determines the position of the first smallest s-mer without
+ * branches and looks the position up in a bitmask. The result is the same as the one of syncmer_filter(), which
+ * decodes the k-mer into a sequence of seqan3::dna4 and hashes the s-mers of that sequence, including its handling
+ * of values, that are longer than a k-mer or start with the digits "10" (see pack()).
+ *
+ * Positions outside of [0, 63] can never be the position of the smallest s-mer and are ignored.
+ */
+class syncmer_classifier
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    syncmer_classifier() = default; //!< Defaulted.
+    syncmer_classifier(syncmer_classifier const &) = default; //!< Defaulted.
+    syncmer_classifier(syncmer_classifier &&) = default; //!< Defaulted.
+    syncmer_classifier & operator=(syncmer_classifier const &) = default; //!< Defaulted.
+    syncmer_classifier & operator=(syncmer_classifier &&) = default; //!< Defaulted.
+    ~syncmer_classifier() = default; //!< Defaulted.
+
+    /*!\brief Construct from the s-mer size, the k-mer size, the positions and the seed.
+     * \param[in] smer      The size of the s-mers.
+     * \param[in] kmer      The size of the k-mers.
+     * \param[in] positions The positions of the smallest s-mer, that make a k-mer a syncmer.
+     * \param[in] seed      The seed the k-mer hashes are skewed with.
+     */
+    syncmer_classifier(uint64_t const smer,
+                       uint64_t const kmer,
+                       std::vector<int> const & positions,
+                       uint64_t const seed = 0x8F3F73B5CF1C9ADE) :
+        smer{smer},
+        kmer{kmer},
+        seed{seed},
+        smer_mask{smer >= 32 ? ~0ULL : (1ULL << (2 * smer)) - 1}
+    {
+        for (int position : positions)
+            if (position >= 0 && position < 64)
+                position_mask |= 1ULL << position;
+    }
+    //!\}
+
+    //!\brief Returns whether the k-mer hash is a syncmer.
+    bool operator()(uint64_t const hash) const noexcept
+    {
+        size_t const position = smallest_smer(hash);
+        return position < 64 && ((position_mask >> position) & 1ULL);
+    }
+
+    /*!\brief Classifies several k-mer hashes at once.
+     * \param[in]  hashes     The k-mer hashes.
+     * \param[out] is_syncmer Whether the k-mer hash at the same index is a syncmer, must be as long as hashes.
+     * \returns The number of syncmers.
+     */
+    size_t classify(std::span<uint64_t const> const hashes, std::span<bool> const is_syncmer) const noexcept
+    {
+        size_t syncmers{0};
+        for (size_t i = 0; i < hashes.size(); ++i)
+        {
+            is_syncmer[i] = (*this)(hashes[i]);
+            syncmers += is_syncmer[i];
+        }
+        return syncmers;
+    }
+
+    /*!\brief Copies the k-mer hashes, that are syncmers, keeping their order.
+     * \param[in]  hashes The k-mer hashes.
+     * \param[out] out    The syncmers, must be as long as hashes. May be the same memory as hashes.
+     * \returns The number of syncmers, i.e. the number of values written to out.
+     */
+    size_t select(std::span<uint64_t const> const hashes, std::span<uint64_t> const out) const noexcept
+    {
+        size_t syncmers{0};
+        for (size_t i = 0; i < hashes.size(); ++i)
+        {
+            uint64_t const hash = hashes[i];
+            out[syncmers] = hash;
+            syncmers += (*this)(hash);
+        }
+        return syncmers;
+    }
+
+    //!\brief Returns the position of the first smallest s-mer of the k-mer hash.
+    size_t smallest_smer(uint64_t const hash) const noexcept
+    {
+        auto [value, length] = pack(hash ^ seed);
+        if (length < smer)
+            return 0;
+
+        // The position is stored in the lowest bits, so the first position wins ties and one minimum suffices.
+        size_t const smers = length - smer + 1;
+        if (2 * smer + position_bits <= 64 && smers <= (1ULL << position_bits))
+        {
+            uint64_t minimum = ~0ULL;
+            for (size_t i = 0; i < smers; ++i)
+                minimum = std::min(minimum, (smer_at(value, smers - 1 - i) << position_bits) | i);
+            return minimum & ((1ULL << position_bits) - 1);
+        }
+
+        uint64_t minimum = ~0ULL;
+        size_t minimum_position{0};
+        for (size_t i = 0; i < smers; ++i)
+        {
+            uint64_t const current = smer_at(value, smers - 1 - i);
+            bool const smaller = current < minimum;
+            minimum = smaller ? current : minimum;
+            minimum_position = smaller ? i : minimum_position;
+        }
+        return minimum_position;
+    }
+
+private:
+    //!\brief The number of bits used to store a position in smallest_smer().
+    static constexpr size_t position_bits{7};
+
+    //!\brief The size of the s-mers.
+    uint64_t smer{};
+    //!\brief The size of the k-mers.
+    uint64_t kmer{};
+    //!\brief The seed the k-mer hashes are skewed with.
+    uint64_t seed{};
+    //!\brief Keeps the lowest 2 * smer bits.
+    uint64_t smer_mask{};
+    //!\brief The bit i is set, if i is one of the positions.
+    uint64_t position_mask{};
+
+    //!\brief Returns the s-mer, that ends `offset` bases before the end of the packed sequence.
+    uint64_t smer_at(uint64_t const value, size_t const offset) const noexcept
+    {
+        // The bases in front of the 32 packed ones are A, i.e. 0.
+        return (2 * offset < 64) ? (value >> (2 * offset)) & smer_mask : 0;
+    }
+
+    /*!\brief Returns the packed sequence of a k-mer and its length in bases.
+     * \details
+     * Values with fewer digits than a k-mer are filled up with A. syncmer_filter() stops decoding, when the remaining
+     * value is at most 4, so a value starting with the digits "10" loses its leading 1. This is kept, such that both
+     * give the same results.
+     */
+    std::pair<uint64_t, size_t> pack(uint64_t value) const noexcept
+    {
+        size_t digits = std::max<size_t>(1, (std::bit_width(value) + 1) / 2);
+        if (digits >= 2 && (value >> (2 * (digits - 2))) == 4)
+        {
+            value ^= 1ULL << (2 * (digits - 1));
+            --digits;
+        }
+        return {value, std::max<size_t>(digits, kmer)};
+    }
+};
+
+} // namespace minions
@@ -51,6 +51,21 @@ struct syncmer_hash_fn
         return seqan3::detail::adaptor_from_functor{*this, smers, kmers, pos, seed};
     }
 
+    /*!\brief Store the k-mer size, the s-mer size, the seed and the hash policy and return a range adaptor closure object.
+    * \param[in] kmers       The k-mer size to be used.
+    * \param[in] smers       The s-mer size (s<k) to be used.
+    * \param[in] pos         The position that determines if an element is a syncmer.
+    * \param[in] seed        The seed to use.
+    * \param[in] hash_policy The minions::hash_policy that transforms every k-mer hash with the seed.
+    * \throws std::invalid_argument if the s-mer size is smaller than 1 or the k-mer size is smaller than the s-mers.
+    * \returns               A range of converted elements.
+    */
+    template <minions::hash_policy hash_policy_t>
+    auto operator()(size_t const smers, size_t const kmers, std::vector<int> const pos, seed const seed, hash_policy_t const hash_policy) const
+    {
+        return seqan3::detail::adaptor_from_functor{*this, smers, kmers, pos, seed, hash_policy};
+    }
+
     /*!\brief Call the view's constructor with the underlying view, a k-mer size and a s-mer size as argument.
      * \param[in] urange     The input range to process. Must model std::ranges::viewable_range and
      *                       the reference type of the range must model seqan3::semialphabet.
@@ -58,15 +73,18 @@ struct syncmer_hash_fn
      * \param[in] smers      The s-mer size (s<k) to be used.
      * \param[in] pos        The position that determines if an element is a syncmer.
      * \param[in] seed       The seed to use.
+     * \param[in] hash_policy The minions::hash_policy that transforms every k-mer and s-mer hash with the seed.
+     *                        Default: minions::xor_hash_policy.
      * \throws std::invalid_argument if the s-mer size is smaller than 1 or the k-mer size is smaller than the s-mers.
      * \returns              A range of converted elements.
      */
-    template <std::ranges::range urng_t>
+    template <std::ranges::range urng_t, minions::hash_policy hash_policy_t = minions::xor_hash_policy>
     auto operator()(urng_t && urange,
                     size_t const smers,
 			        size_t const kmers,
 			        std::vector<int> const pos,
-                    seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE}) const
+                    seed const seed = seqan3::seed{0x8F3F73B5CF1C9ADE},
+                    hash_policy_t const hash_policy = hash_policy_t{}) const
     {
         static_assert(std::ranges::viewable_range<urng_t>,
             "The range parameter to views::syncmer_hash cannot be a temporary of a non-view range.");
@@ -81,27 +99,27 @@ struct syncmer_hash_fn
 
         auto forward_strand = std::forward<urng_t>(urange)
                                                  | seqan3::views::kmer_hash(seqan3::shape(seqan3::ungapped(kmers)))
-                                                 | std::views::transform([seed] (uint64_t i)
-                                                          {return i ^ seed.get();});
+                                                 | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                          {return hash_policy(i, seed.get());});
 
         auto forward_strand_smer = std::forward<urng_t>(urange)
                                                  | seqan3::views::kmer_hash(seqan3::shape(seqan3::ungapped(smers)))
-                                                 | std::views::transform([seed] (uint64_t i)
-                                                          {return i ^ seed.get();});
+                                                 | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                          {return hash_policy(i, seed.get());});
 
 
         auto reverse_strand = std::forward<urng_t>(urange) | seqan3::views::complement
                                                            | std::views::reverse
                                                            | seqan3::views::kmer_hash(seqan3::shape(seqan3::ungapped(kmers)))
-                                                           | std::views::transform([seed] (uint64_t i)
-                                                                                  {return i ^ seed.get();})
+                                                           | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                                                  {return hash_policy(i, seed.get());})
                                                            | std::views::reverse;
 
         auto reverse_strand_smer = std::forward<urng_t>(urange) | seqan3::views::complement
                                                                 | std::views::reverse
                                                                 | seqan3::views::kmer_hash(seqan3::shape(seqan3::ungapped(smers)))
-                                                                | std::views::transform([seed] (uint64_t i)
-                                                                                       {return i ^ seed.get();})
+                                                                | std::views::transform([seed, hash_policy] (uint64_t i)
+                                                                                       {return hash_policy(i, seed.get());})
                                                                 | std::views::reverse;
 
         return seqan3::detail::syncmer_view<decltype(forward_strand_smer), decltype(forward_strand), decltype(reverse_strand_smer), decltype(reverse_strand)>
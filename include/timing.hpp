@@ -0,0 +1,75 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::interval_estimate and minions::estimate_mean.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace minions
+{
+
+//!\brief The mean of repeated measurements and its 95% confidence interval.
+struct interval_estimate
+{
+    double mean{};   //!< The sample mean.
+    double stdev{};  //!< The sample standard deviation, 0 for fewer than two measurements.
+    double lower{};  //!< The lower bound of the confidence interval.
+    double upper{};  //!< The upper bound of the confidence interval.
+};
+
+/*!\brief The 97.5% quantile of Student's t-distribution.
+ * \param[in] degrees_of_freedom The degrees of freedom, must be at least 1.
+ * \details Above 30 degrees of freedom, the quantile of the normal distribution is returned.
+ */
+inline double student_t_quantile(size_t const degrees_of_freedom)
+{
+    static constexpr std::array<double, 30> quantiles{12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+                                                      2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+                                                      2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+                                                      2.048, 2.045, 2.042};
+    return (degrees_of_freedom <= quantiles.size()) ? quantiles[degrees_of_freedom - 1] : 1.960;
+}
+
+/*!\brief Estimates the mean of repeated measurements.
+ * \param[in] samples The measurements.
+ * \returns The mean and its 95% confidence interval, based on Student's t-distribution. With a single measurement, the
+ *          interval consists of the measurement only, without measurements everything is 0.
+ */
+inline interval_estimate estimate_mean(std::vector<double> const & samples)
+{
+    interval_estimate estimate{};
+    if (samples.empty())
+        return estimate;
+
+    for (double const sample : samples)
+        estimate.mean += sample;
+    estimate.mean /= samples.size();
+
+    if (samples.size() > 1)
+    {
+        double sum{0.0};
+        for (double const sample : samples)
+            sum += (sample - estimate.mean) * (sample - estimate.mean);
+        estimate.stdev = std::sqrt(sum / (samples.size() - 1));
+    }
+
+    double const half_width = student_t_quantile(std::max<size_t>(samples.size() - 1, 1)) * estimate.stdev /
+                              std::sqrt(static_cast<double>(samples.size()));
+    estimate.lower = estimate.mean - half_width;
+    estimate.upper = estimate.mean + half_width;
+    return estimate;
+}
+
+} // namespace minions
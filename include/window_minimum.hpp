@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \author Mitra Darvish <mitra.darvish AT fu-berlin.de>
+ * \brief Provides minions::window_minimum.
+ */
+
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <vector>
+
+namespace minions
+{
+
+/*!\brief The minimum of a sliding window in O(1) amortized time per shift.
+ * \tparam value_t The type of the values, must model std::totally_ordered.
+ *
+ * \details
+ *
+ * The values are pushed one after another, the window consists of the last `window_size` pushed values. Internally,
+ * a monotone queue is kept in a ring buffer, whose capacity is fixed on construction, so pushing never allocates.
+ * The queue only keeps values that are strictly smaller than all values pushed after them, therefore min_position()
+ * is the position of the rightmost minimum in the window, i.e. the same position
+ * `std::ranges::min_element(window, std::less_equal<value_t>{})` returns.
+ *
+ * Positions count the pushed values, the first value has position 0.
+ */
+template <std::totally_ordered value_t>
+class window_minimum
+{
+public:
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    window_minimum() = default; //!< Defaulted.
+    window_minimum(window_minimum const &) = default; //!< Defaulted.
+    window_minimum(window_minimum &&) = default; //!< Defaulted.
+    window_minimum & operator=(window_minimum const &) = default; //!< Defaulted.
+    window_minimum & operator=(window_minimum &&) = default; //!< Defaulted.
+    ~window_minimum() = default; //!< Defaulted.
+
+    /*!\brief Construct an empty window.
+     * \param[in] window_size The number of values in one window.
+     */
+    explicit window_minimum(size_t const window_size) :
+        window_length{window_size},
+        // Before the oldest value is removed in push(), the queue can hold one value more than the window.
+        buffer(std::bit_ceil(window_size + 1u)),
+        mask{buffer.size() - 1}
+    {}
+    //!\}
+
+    /*!\brief Adds a value to the window, the oldest value leaves the window if it is full.
+     * \param[in] value The new value.
+     */
+    void push(value_t const value) noexcept
+    {
+        while (head != tail && !(buffer[(tail - 1) & mask].value < value))
+            --tail;
+
+        buffer[tail++ & mask] = entry{value, pushed};
+        ++pushed;
+
+        if (buffer[head & mask].position + window_length < pushed)
+            ++head;
+    }
+
+    //!\brief Returns the minimum of the window. The window must not be empty.
+    value_t min() const noexcept
+    {
+        return buffer[head & mask].value;
+    }
+
+    //!\brief Returns the position of the rightmost minimum of the window. The window must not be empty.
+    size_t min_position() const noexcept
+    {
+        return buffer[head & mask].position;
+    }
+
+    //!\brief Returns the number of pushed values, i.e. the position of the next value.
+    size_t pushed_values() const noexcept
+    {
+        return pushed;
+    }
+
+    //!\brief Returns the number of values in one window.
+    size_t window_size() const noexcept
+    {
+        return window_length;
+    }
+
+    //!\brief Empties the window, the capacity is kept.
+    void clear() noexcept
+    {
+        head = 0;
+        tail = 0;
+        pushed = 0;
+    }
+
+private:
+    //!\brief A value of the monotone queue and its position.
+    struct entry
+    {
+        //!\brief The value.
+        value_t value{};
+        //!\brief The position of the value.
+        size_t position{};
+    };
+
+    //!\brief The number of values in one window.
+    size_t window_length{};
+    //!\brief The ring buffer holding the monotone queue between `head` and `tail`.
+    std::vector<entry> buffer{};
+    //!\brief Maps head and tail to an index of the ring buffer, the capacity is a power of two.
+    size_t mask{};
+    //!\brief The index of the minimum.
+    size_t head{};
+    //!\brief The index after the last value of the queue.
+    size_t tail{};
+    //!\brief The number of pushed values.
+    size_t pushed{};
+};
+
+} // namespace minions
@@ -1,5 +1,16 @@
+#include <array>
 #include <chrono>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <ranges>
+#include <sstream>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include <index.hpp>
 #include <seqan3/alphabet/adaptation/char.hpp>
@@ -8,13 +19,29 @@
 #include <seqan3/io/views/detail/take_until_view.hpp>
 #include <seqan3/search/views/minimiser_hash.hpp>
 
+#include "approximate_counts.hpp"
 #include "compare.h"
+#include "count_file.hpp"
+#include "cross_file_uniqueness.hpp"
+#include "flat_count_table.hpp"
+#include "histogram.hpp"
+#include "hyperloglog.hpp"
 #include "hybridstrobe_hash.hpp"
+#include "match_coverage.hpp"
 #include "minions_minimiser_hash.hpp"
 #include "minstrobe_hash.hpp"
 #include "modmer_hash.hpp"
+#include "multi_sketch.hpp"
+#include "parallel.hpp"
+#include "partitioned_count_table.hpp"
+#include "perf_counters.hpp"
+#include "position_view.hpp"
 #include "randstrobe_hash.hpp"
+#include "sequence_reader.hpp"
+#include "sharded_count_table.hpp"
+#include "syncmer_classifier.hpp"
 #include "syncmer_hash.hpp"
+#include "timing.hpp"
 
 #include <seqan3/core/debug_stream.hpp>
 
@@ -66,65 +93,214 @@ std::vector<std::tuple<uint64_t, unsigned int, unsigned int, unsigned int, unsig
         strobes_vector = seq_to_minstrobes2(args.order, args.k_size, args.w_min, args.w_max, seq, 0);
 }
 
-template <typename urng_t>
-void accuracy(urng_t input_view,
-              std::string method_name,
-              accuracy_arguments & args)
+/*! \brief The records of a sequence file, read one at a time.
+ *  \tparam text Whether the sequences are std::string instead of ranges of seqan3::dna4.
+ *  \details Uncompressed and gzip compressed files are read with minions::sequence_reader, which decompresses on
+ *           background threads and reuses the memory of the sequence for all records. Files compressed with other
+ *           formats are read with seqan3::sequence_file_input.
+ */
+template <bool text = false>
+class sequence_records
 {
-    // Loading/Creating the ibf.
-    seqan3::interleaved_bloom_filter<seqan3::data_layout::uncompressed> ibf;
-    if ((std::filesystem::path{args.input_file[0]}.extension() == ".ibf") & (args.input_file.size() == 1))
+public:
+    /*! \brief Opens the sequence file.
+     *  \param sequence_file The sequence file.
+     *  \param threads The number of threads, that decompress a file in the BGZF format.
+     */
+    explicit sequence_records(std::filesystem::path const & sequence_file, size_t const threads = 1)
     {
-        load_ibf(ibf, args.input_file[0]);
+        if (minions::sequence_reader::can_read(sequence_file))
+            reader.emplace(sequence_file, threads);
+        else
+            fin = std::make_unique<file_t>(sequence_file);
+    }
+
+    //!\brief Moves to the next record, returns false at the end of the file.
+    bool next()
+    {
+        if (reader)
+            return reader->next();
+
+        if (it)
+            ++*it;
+        else
+            it = fin->begin();
+        return *it != fin->end();
     }
-    else if (std::filesystem::path{args.input_file[0]}.extension() == ".out")
+
+    //!\brief The id of the current record.
+    std::string_view id()
     {
-        seqan3::interleaved_bloom_filter ibf_create{seqan3::bin_count{args.input_file.size()},
-                                     seqan3::bin_size{args.ibfsize},
-                                     seqan3::hash_function_count{args.number_hashes}};
+        if (reader)
+            return reader->id();
+        auto & [id, seq] = **it;
+        return id;
+    }
 
-        uint64_t minimiser;
-        uint16_t minimiser_count;
-        for(size_t i = 0; i < args.input_file.size(); i++)
+    //!\brief The sequence of the current record, valid until next() is called.
+    decltype(auto) sequence()
+    {
+        if constexpr (text)
         {
-            std::ifstream infile{args.input_file[i], std::ios::binary};
-            while(infile.read((char*)&minimiser, sizeof(minimiser)))
-            {
-                infile.read((char*)&minimiser_count, sizeof(minimiser_count));
-                ibf_create.emplace(minimiser, seqan3::bin_index{i});
-            }
+            return reader ? reader->text() : std::get<1>(**it);
+        }
+        else
+        {
+            if (reader)
+                return reader->sequence();
+            auto & [id, seq] = **it;
+            return std::span<seqan3::dna4 const>{seq};
+        }
+    }
+
+private:
+    using traits_t = std::conditional_t<text, my_traits2, my_traits>;
+    using file_t = seqan3::sequence_file_input<traits_t, seqan3::fields<seqan3::field::id, seqan3::field::seq>>;
+
+    std::optional<minions::sequence_reader> reader{};
+    std::unique_ptr<file_t> fin{};
+    std::optional<std::ranges::iterator_t<file_t>> it{};
+};
+
+/*! \brief Calls a function for every record of a sequence file.
+ *  \param sequence_file The sequence file, see sequence_records.
+ *  \param callback Callable `callback(seq)`, where `seq` is a range of seqan3::dna4, or a std::string if `text` is true.
+ *  \param threads The number of threads, that decompress a file in the BGZF format.
+ */
+template <bool text = false, typename callback_t>
+void for_each_sequence(std::filesystem::path const & sequence_file, callback_t && callback, size_t const threads = 1)
+{
+    sequence_records<text> records{sequence_file, threads};
+    while (records.next())
+    {
+        if constexpr (text)
+        {
+            callback(records.sequence());
+        }
+        else
+        {
+            std::span<seqan3::dna4 const> seq = records.sequence();
+            callback(seq);
         }
-        store_ibf(ibf_create, std::string{args.path_out} + method_name + ".ibf");
-        load_ibf(ibf, std::string{args.path_out} + method_name + ".ibf");
     }
-    else // Sequence files
+}
+
+/*! \brief Returns the parameters stored in the header of a count file.
+ *  \param args The arguments about the view.
+ *  \param underlying_strobemer Whether the method is applied to strobemers.
+ *  \throws std::invalid_argument if a syncmer position is not between 0 and 63.
+ */
+minions::count_file_parameters count_parameters(range_arguments const & args, bool underlying_strobemer)
+{
+    minions::count_file_parameters parameters{};
+    parameters.method = args.name;
+    parameters.kmer_size = args.k_size;
+    parameters.order = args.order;
+    parameters.flags = (args.rand ? minions::count_file_parameters::randstrobe : 0) |
+                       (args.hybrid ? minions::count_file_parameters::hybridstrobe : 0) |
+                       (args.minstrobers ? minions::count_file_parameters::minstrobe : 0) |
+                       (underlying_strobemer ? minions::count_file_parameters::underlying_strobemer : 0);
+    parameters.window_size = args.w_size.get();
+    parameters.window_min = args.w_min;
+    parameters.window_max = args.w_max;
+    parameters.seed = args.seed_se.get();
+    parameters.shape = args.shape.to_ulong();
+    for (int position : args.positions)
     {
-        seqan3::interleaved_bloom_filter ibf_create{seqan3::bin_count{args.input_file.size()},
-                                     seqan3::bin_size{args.ibfsize},
-                                     seqan3::hash_function_count{args.number_hashes}};
+        // The positions are stored as a bit mask, so a larger position cannot be told apart from a smaller one.
+        if (position < 0 || position >= 64)
+            throw std::invalid_argument{"The syncmer position " + std::to_string(position) + " is not between 0 and 63."};
+        parameters.syncmer_positions |= 1ULL << position;
+    }
+    return parameters;
+}
+
+/*! \brief Fills an ibf with the hash values of sequence files or count files, one bin per file.
+ *  \param ibf The ibf, must have one bin per input file.
+ *  \param input_view View that should be tested.
+ *  \param method_name Name of the tested method.
+ *  \param args The arguments, the input files are filled by `args.threads` threads.
+ *
+ *  The interleaved layout stores the same bit of 64 adjacent bins in one word. Bins of different groups of 64 never
+ *  share a word, so each group is guarded by its own mutex, and files are hashed without holding it.
+ */
+template <typename urng_t>
+void fill_ibf(seqan3::interleaved_bloom_filter<seqan3::data_layout::uncompressed> & ibf,
+              urng_t input_view,
+              std::string const & method_name,
+              accuracy_arguments const & args)
+{
+    bool const count_files = std::filesystem::path{args.input_file[0]}.extension() == ".out";
+    minions::count_file_parameters const parameters = count_parameters(args, false);
+    std::vector<std::mutex> word_mutexes((args.input_file.size() + 63) / 64);
 
-        for(size_t i = 0; i < args.input_file.size(); i++)
+    minions::parallel_for(args.input_file.size(), args.threads, [&] (size_t const i)
+    {
+        std::mutex & word_mutex = word_mutexes[i / 64];
+        if (count_files)
+        {
+            minions::count_file_reader const infile{args.input_file[i]};
+            if (!infile.is_legacy() && (infile.parameters() != parameters))
+                throw std::invalid_argument{"The count file " + args.input_file[i].string() +
+                                            " was created with other parameters than " + method_name + "."};
+
+            std::lock_guard<std::mutex> lock{word_mutex};
+            for (uint64_t const minimiser : infile.hashes())
+                ibf.emplace(minimiser, seqan3::bin_index{i});
+        }
+        else
         {
-            for (auto && [seq] : seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::seq>>{args.input_file[i]})
+            std::vector<uint64_t> values{};
+            for_each_sequence(args.input_file[i], [&] (auto & seq)
+            {
+                values.clear();
                 for (auto && value : seq | input_view)
-                    ibf_create.emplace(value, seqan3::bin_index{i});
+                    values.push_back(value);
+
+                std::lock_guard<std::mutex> lock{word_mutex};
+                for (uint64_t const value : values)
+                    ibf.emplace(value, seqan3::bin_index{i});
+            });
         }
-        store_ibf(ibf_create, std::string{args.path_out} + method_name + ".ibf");
-        load_ibf(ibf, std::string{args.path_out} + method_name + ".ibf");
-    }
+    });
+}
 
-    // Search through the ibf with a given threshold.
+//!\brief The sequences of the search file, that are searched together.
+struct search_batch
+{
+    std::vector<std::string> ids{};
+    std::vector<seqan3::dna4_vector> seqs{};
+};
 
-    // Load search sequence file.
-    seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::id, seqan3::field::seq>> fin{args.search_file};
-    std::vector<std::string> ids;
-    std::vector<seqan3::dna4_vector> seqs;
-    for (auto & [id, seq] : fin)
+template <typename urng_t>
+void accuracy(urng_t input_view,
+              std::string method_name,
+              accuracy_arguments & args)
+{
+    // Loading/Creating the ibf.
+    seqan3::interleaved_bloom_filter<seqan3::data_layout::uncompressed> ibf;
+    std::future<void> stored_ibf{};
+    if ((std::filesystem::path{args.input_file[0]}.extension() == ".ibf") & (args.input_file.size() == 1))
     {
-        ids.push_back(id);
-        seqs.push_back(seq);
+        load_ibf(ibf, args.input_file[0]);
+    }
+    else
+    {
+        ibf = seqan3::interleaved_bloom_filter{seqan3::bin_count{args.input_file.size()},
+                                               seqan3::bin_size{args.ibfsize},
+                                               seqan3::hash_function_count{args.number_hashes}};
+        fill_ibf(ibf, input_view, method_name, args);
+
+        // The search only reads the ibf, so it can be stored at the same time.
+        if (!args.skip_ibf_output)
+            stored_ibf = std::async(std::launch::async, [&ibf, path = std::string{args.path_out} + method_name + ".ibf"] ()
+            {
+                store_ibf(ibf, path);
+            });
     }
 
+    // Search through the ibf with a given threshold.
+
     // Read in "solution", in which files the sequences should be present.
     robin_hood::unordered_node_map<std::string, std::vector<uint32_t>> solutions{};
     std::ifstream infile;
@@ -142,324 +318,770 @@ void accuracy(urng_t input_view,
     }
     infile.close();
 
-    int tp = 0, tn = 0, fp = 0, fn = 0;
-    std::ofstream outfile;
-    outfile.open(std::string{args.path_out} + method_name + "_" + std::string{args.search_file.stem()} + ".search_out");
-    // Go over the sequences in the search file.
-    for (int i = 0; i < seqs.size(); ++i)
-    {
-        std::vector<uint32_t> counter;
-        counter.assign(ibf.bin_count(), 0);
-        uint64_t length = 0;
-        auto agent = ibf.membership_agent();
-        for (auto && hash : seqs[i] | input_view)
+    // The search file is streamed through a pipeline: One thread reads batches of sequences, the batches are searched
+    // in chunks by multiple threads and another thread writes the results. At most two batches wait in each queue.
+    size_t const chunk_size = std::max<size_t>(args.chunk_size, 1u);
+    size_t const batch_size = chunk_size * 4 * std::max<size_t>(args.threads, 1u);
+    minions::bounded_queue<search_batch> batches{2};
+    minions::bounded_queue<std::string> outputs{2};
+
+    std::future<void> reader = std::async(std::launch::async, [&] ()
+    {
+        try
+        {
+            sequence_records<> records{args.search_file, args.threads};
+            search_batch batch{};
+            while (records.next())
+            {
+                std::span<seqan3::dna4 const> const seq = records.sequence();
+                batch.ids.emplace_back(records.id());
+                batch.seqs.emplace_back(seq.begin(), seq.end());
+                if ((batch.ids.size() == batch_size) && !batches.push(std::exchange(batch, search_batch{})))
+                    break;
+            }
+            if (!batch.ids.empty())
+                batches.push(std::move(batch));
+        }
+        catch (...)
         {
-            std::transform (counter.begin(), counter.end(), agent.bulk_contains(hash).begin(), counter.begin(),
-                            std::plus<int>());
-            ++length;
+            batches.close();
+            throw;
         }
+        batches.close();
+    });
 
-        outfile << ids[i] << "\t";
-        for (int j = 0; j < ibf.bin_count(); ++j)
+    std::future<void> writer = std::async(std::launch::async, [&] ()
+    {
+        try
         {
-            bool found = (counter[j] >= (length * args.threshold));
-            bool true_positive = std::binary_search(solutions[ids[i]].begin(), solutions[ids[i]].end(), j);
-            if (counter[j] >= (length * args.threshold))
-                outfile << j << ",";
-
-            if (found && true_positive)
-                tp++;
-            else if(found && !true_positive)
-                fp++;
-            else if (!found &&true_positive)
-                fn++;
-            else if (!found && !true_positive)
-                tn++;
+            std::ofstream outfile;
+            outfile.open(std::string{args.path_out} + method_name + "_" + std::string{args.search_file.stem()} + ".search_out");
+            while (std::optional<std::string> output = outputs.pop())
+                outfile << *output;
+        }
+        catch (...)
+        {
+            outputs.close();
+            throw;
+        }
+    });
+
+    uint64_t tp = 0, tn = 0, fp = 0, fn = 0;
+    std::vector<uint32_t> const no_solution{};
+    try
+    {
+        while (std::optional<search_batch> batch = batches.pop())
+        {
+            auto & [ids, seqs] = *batch;
+            size_t const chunk_count = (seqs.size() + chunk_size - 1) / chunk_size;
+            std::vector<std::string> chunk_outputs(chunk_count);
+            std::vector<std::array<uint64_t, 4>> chunk_results(chunk_count); // tp, tn, fp, fn
+
+            minions::parallel_for(chunk_count, args.threads, [&] (size_t const c)
+            {
+                // Counting in uint16_t adds more bins per instruction, sequences with more hash values need uint32_t.
+                auto agent16 = ibf.counting_agent<uint16_t>();
+                auto agent32 = ibf.counting_agent<uint32_t>();
+                std::vector<uint64_t> values{};
+                std::string & output = chunk_outputs[c];
+                auto & [tp, tn, fp, fn] = chunk_results[c];
+
+                for (size_t i = c * chunk_size; i < std::min(seqs.size(), (c + 1) * chunk_size); ++i)
+                {
+                    values.clear();
+                    for (auto && hash : seqs[i] | input_view)
+                        values.push_back(hash);
+                    uint64_t const length = values.size();
+
+                    auto solution_it = solutions.find(ids[i]);
+                    std::vector<uint32_t> const & solution = (solution_it != solutions.end()) ? solution_it->second : no_solution;
+
+                    auto classify = [&] (auto const & counter)
+                    {
+                        output += ids[i];
+                        output += '\t';
+                        for (int j = 0; j < ibf.bin_count(); ++j)
+                        {
+                            bool found = (counter[j] >= (length * args.threshold));
+                            bool true_positive = std::binary_search(solution.begin(), solution.end(), j);
+                            if (found)
+                            {
+                                output += std::to_string(j);
+                                output += ',';
+                            }
+
+                            if (found && true_positive)
+                                tp++;
+                            else if(found && !true_positive)
+                                fp++;
+                            else if (!found &&true_positive)
+                                fn++;
+                            else if (!found && !true_positive)
+                                tn++;
+                        }
+                        output += '\n';
+                    };
+
+                    if (length <= std::numeric_limits<uint16_t>::max())
+                        classify(agent16.bulk_count(values));
+                    else
+                        classify(agent32.bulk_count(values));
+                }
+            });
+
+            // Chunks are written and summed in input order.
+            std::string output{};
+            for (size_t c = 0; c < chunk_count; ++c)
+            {
+                output += chunk_outputs[c];
+                tp += chunk_results[c][0];
+                tn += chunk_results[c][1];
+                fp += chunk_results[c][2];
+                fn += chunk_results[c][3];
+            }
+            outputs.push(std::move(output));
         }
-        outfile << "\n";
     }
-    outfile.close();
+    catch (...)
+    {
+        // Releases the reader and the writer, which are joined by the destructors of the futures.
+        batches.close();
+        outputs.close();
+        throw;
+    }
+    outputs.close();
+    reader.get();
+    writer.get();
+
     // Store tp, tn, fp, fn
     std::ofstream outfile2;
     outfile2.open(std::string{args.path_out} + method_name +  "_" + std::string{args.search_file.stem()} + "_accuracy.out");
     outfile2 << method_name << "\t" << tp << "\t" << tn << "\t" << fp << "\t" << fn << "\n";
     outfile2.close();
+
+    if (stored_ibf.valid())
+        stored_ibf.get();
 }
 
-/*! \brief Function, counting the number of submers.
- *  \param sequence_files A vector of sequence files.
- *  \param input_view View that should be tested.
- *  \param method_name Name of the tested method.
- *  \param args The arguments about the view to be used, needed for strobemers.
+/*! \brief Reads the records of a sequence file in batches and processes up to `threads` batches in parallel.
+ *  \param sequence_file The sequence file.
+ *  \param threads The number of threads.
+ *  \param worker Callable `worker(batch_index, records)`, where `batch_index` counts the batches of the file and
+ *                `records` are spans of seqan3::dna4.
+ *  \details The bases of a batch are stored contiguously in memory, that is reused for all batches.
  */
-template <typename urng_t>
-void counts(std::vector<std::filesystem::path> & sequence_files, urng_t input_view, std::string method_name, range_arguments & args)
+template <typename worker_t>
+void for_each_record_batch(std::filesystem::path const & sequence_file, size_t const threads, worker_t && worker)
 {
-    std::vector<uint64_t> counts_results{};
-    std::ofstream outfile;
-    for (int i = 0; i < sequence_files.size(); ++i)
+    // Number of bases after which a batch is closed.
+    constexpr size_t batch_bases{1ULL << 20};
+
+    std::vector<std::vector<seqan3::dna4>> bases(threads);
+    std::vector<std::vector<size_t>> ends(threads);
+    std::vector<std::vector<std::span<seqan3::dna4 const>>> batches(threads);
+    uint64_t batch_index{0};
+    size_t filled{0};
+
+    auto process = [&] ()
     {
-        robin_hood::unordered_node_map<uint64_t, uint16_t> hash_table{};
-        seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_files[i]};
-        for (auto & [seq] : fin)
+        for (size_t b = 0; b < filled; ++b)
         {
-            for (auto && hash : seq | input_view)
-                hash_table[hash] = std::min<uint16_t>(65534u, hash_table[hash] + 1);
+            batches[b].clear();
+            size_t begin{0};
+            for (size_t const end : ends[b])
+            {
+                batches[b].emplace_back(bases[b].data() + begin, end - begin);
+                begin = end;
+            }
         }
-        counts_results.push_back(hash_table.size());
 
-        // Store representative k-mers
-        outfile.open(std::string{args.path_out} + method_name + "_"+ std::string{sequence_files[i].stem()} + "_counts.out", std::ios::binary);
-        for (auto && hash : hash_table)
+        minions::parallel_for(filled, threads, [&] (size_t const b)
         {
-            outfile.write(reinterpret_cast<const char*>(&hash.first), sizeof(hash.first));
-            outfile.write(reinterpret_cast<const char*>(&hash.second), sizeof(hash.second));
-        }
-        outfile.close();
-    }
+            worker(batch_index + b, batches[b]);
+        });
+        batch_index += filled;
 
-    double mean_counts, stdev_counts;
-    get_mean_and_var(counts_results, mean_counts, stdev_counts);
+        for (size_t b = 0; b < filled; ++b)
+        {
+            bases[b].clear();
+            ends[b].clear();
+        }
+        filled = 0;
+    };
 
-    // Store speed and counts
-    outfile.open(std::string{args.path_out} + method_name + "_counts.out");
-    outfile << method_name << "\t" << *std::min_element(counts_results.begin(), counts_results.end()) << "\t" << mean_counts << "\t" << stdev_counts << "\t" << *std::max_element(counts_results.begin(), counts_results.end()) << "\n";
-    outfile.close();
+    for_each_sequence(sequence_file, [&] (auto & seq)
+    {
+        bases[filled].insert(bases[filled].end(), seq.begin(), seq.end());
+        ends[filled].push_back(bases[filled].size());
+        if (bases[filled].size() >= batch_bases && ++filled == threads)
+            process();
+    }, threads);
+
+    if (filled < threads && !ends[filled].empty())
+        ++filled;
+    process();
 }
 
-template <typename urng_t, typename urng_t2>
-void counts_strobemer(std::vector<std::filesystem::path> & sequence_files, urng_t input_view, urng_t2 input_view2, std::string method_name, range_arguments & args)
+/*! \brief Counts the hash values of one sequence file and stores them in one binary file per method.
+ *  \param sequence_file The sequence file.
+ *  \param hasher Callable `hasher(seq, emit)`, which calls `emit(method, hash)` for every hash value of `seq`, where
+ *                `method` is the index of the method. Every thread hashes with its own copy.
+ *  \param method_names Names of the tested methods.
+ *  \param args The arguments, needed for the output path.
+ *  \param parameters The parameters stored in the header of the count file of every method.
+ *  \param threads The number of threads used to hash the records of the file.
+ *  \param max_memory The memory in bytes for counting the hash values of one method, 0 to count them in memory.
+ *  \returns The number of distinct hash values of every method.
+ *
+ *  With more than one thread, the records are read in batches, which are hashed in parallel and counted in a
+ *  minions::sharded_count_table. The resulting files are identical to the ones of a single thread. With a memory
+ *  limit, the hash values are partitioned into temporary files next to the output files and counted by a
+ *  minions::partitioned_count_table, which writes the same files.
+ */
+template <typename hasher_t>
+std::vector<uint64_t> count_file(std::filesystem::path const & sequence_file, hasher_t const & hasher, std::vector<std::string> const & method_names, range_arguments const & args, std::vector<minions::count_file_parameters> const & parameters, size_t const threads, uint64_t const max_memory)
 {
-    std::vector<uint64_t> counts_results{};
-    std::ofstream outfile;
-    for (int i = 0; i < sequence_files.size(); ++i)
+    auto output_path = [&] (size_t const method)
     {
-        robin_hood::unordered_node_map<uint64_t, uint16_t> hash_table{};
-        seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_files[i]};
-        for (auto & [seq] : fin)
+        return std::string{args.path_out} + method_names[method] + "_"+ std::string{sequence_file.stem()} + "_counts.out";
+    };
+    std::vector<uint64_t> distinct(method_names.size());
+
+    if (max_memory > 0)
+    {
+        std::filesystem::path const directory = std::filesystem::path{output_path(0)}.parent_path();
+        std::vector<std::unique_ptr<minions::partitioned_count_table>> partitioned_tables{};
+        for (size_t method = 0; method < method_names.size(); ++method)
+            partitioned_tables.push_back(std::make_unique<minions::partitioned_count_table>(directory.empty() ? "." : directory, max_memory));
+
+        for_each_record_batch(sequence_file, threads, [&] (uint64_t, auto & records)
         {
-            std::vector<uint64_t> res = seq | input_view;
-            for (auto && hash : res | input_view2)
-            {
-                hash_table[hash] = std::min<uint16_t>(65534u, hash_table[hash] + 1);
-            }
-        }
+            hasher_t local_hasher{hasher};
+            std::vector<minions::partitioned_count_table::local_buffer_type> local_buffers{};
+            for (auto & table : partitioned_tables)
+                local_buffers.push_back(table->local_buffer());
+            for (auto & seq : records)
+                local_hasher(seq, [&] (size_t const method, uint64_t const hash)
+                {
+                    partitioned_tables[method]->add(local_buffers[method], hash);
+                });
+            for (size_t method = 0; method < method_names.size(); ++method)
+                partitioned_tables[method]->flush(local_buffers[method]);
+        });
+
+        for (size_t method = 0; method < method_names.size(); ++method)
+            distinct[method] = partitioned_tables[method]->write(output_path(method), parameters[method]);
+        return distinct;
+    }
 
-        counts_results.push_back(hash_table.size());
+    if (threads == 1)
+    {
+        std::vector<minions::flat_count_table> hash_tables(method_names.size());
+        hasher_t local_hasher{hasher};
+        for_each_sequence(sequence_file, [&] (auto & seq)
+        {
+            local_hasher(seq, [&] (size_t const method, uint64_t const hash)
+            {
+                hash_tables[method].add(hash);
+            });
+        });
 
         // Store representative k-mers
-        outfile.open(std::string{args.path_out} + method_name + "_"+ std::string{sequence_files[i].stem()} + "_counts.out", std::ios::binary);
-        for (auto && hash : hash_table)
+        for (size_t method = 0; method < method_names.size(); ++method)
         {
-            outfile.write(reinterpret_cast<const char*>(&hash.first), sizeof(hash.first));
-            outfile.write(reinterpret_cast<const char*>(&hash.second), sizeof(hash.second));
+            minions::write_count_file(output_path(method), parameters[method], hash_tables[method]);
+            distinct[method] = hash_tables[method].size();
+            hash_tables[method].clear();
         }
-        outfile.close();
+        return distinct;
     }
 
-    double mean_counts, stdev_counts;
-    get_mean_and_var(counts_results, mean_counts, stdev_counts);
+    std::vector<minions::sharded_count_table> shared_tables(method_names.size());
+    for_each_record_batch(sequence_file, threads, [&] (uint64_t, auto & records)
+    {
+        hasher_t local_hasher{hasher};
+        std::vector<minions::sharded_count_table::local_table_type> local_tables(method_names.size());
+        for (auto & seq : records)
+            local_hasher(seq, [&] (size_t const method, uint64_t const hash)
+            {
+                local_tables[method].add(hash);
+            });
+        for (size_t method = 0; method < method_names.size(); ++method)
+            shared_tables[method].merge(local_tables[method]);
+    });
 
-    // Store speed and counts
-    outfile.open(std::string{args.path_out} + method_name + "_counts.out");
-    outfile << method_name << "\t" << *std::min_element(counts_results.begin(), counts_results.end()) << "\t" << mean_counts << "\t" << stdev_counts << "\t" << *std::max_element(counts_results.begin(), counts_results.end()) << "\n";
-    outfile.close();
+    // Store representative k-mers
+    for (size_t method = 0; method < method_names.size(); ++method)
+        distinct[method] = shared_tables[method].write(output_path(method), parameters[method]);
+
+    return distinct;
 }
 
-template <typename urng_t, bool syncmer = false>
-std::vector<uint64_t> read_seq_file(std::filesystem::path sequence_file, urng_t input_view, range_arguments & args)
+/*! \brief Samples the hash values of one sequence file and stores the sample of every method.
+ *  \param sequence_file The sequence file.
+ *  \param hasher Callable `hasher(seq, emit)`, which calls `emit(method, hash)` for every hash value of `seq`, where
+ *                `method` is the index of the method. Every thread hashes with its own copy.
+ *  \param method_names Names of the tested methods.
+ *  \param args The arguments, needed for the output path.
+ *  \param parameters The parameters stored in the header of the sample file of every method.
+ *  \param threads The number of threads used to hash the records of the file.
+ *  \returns The sample of every method.
+ *
+ *  The samples take fixed memory and are stored as `{method}_{file}_sample.out` instead of a count file. Every batch
+ *  of records is sampled on its own and merged, which gives the same samples for any number of threads.
+ */
+template <typename hasher_t>
+std::vector<minions::approximate_counts> sample_file(std::filesystem::path const & sequence_file, hasher_t const & hasher, std::vector<std::string> const & method_names, range_arguments const & args, std::vector<minions::count_file_parameters> const & parameters, size_t const threads)
 {
-    std::vector<uint64_t> vector{};
-    seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_file};
-    for (auto & [seq] : fin)
+    std::vector<minions::approximate_counts> samples(method_names.size());
+    std::mutex mutex{};
+    for_each_record_batch(sequence_file, threads, [&] (uint64_t, auto & records)
     {
-        if constexpr (syncmer)
+        hasher_t local_hasher{hasher};
+        std::vector<minions::approximate_counts> local_samples(method_names.size());
         {
-            for (auto && hash : seq | input_view)
+            std::lock_guard<std::mutex> lock{mutex};
+            for (size_t method = 0; method < method_names.size(); ++method)
+                local_samples[method].skip_larger(samples[method]);
+        }
+        for (auto & seq : records)
+            local_hasher(seq, [&] (size_t const method, uint64_t const hash)
+            {
+                local_samples[method].add(hash);
+            });
+
+        std::lock_guard<std::mutex> lock{mutex};
+        for (size_t method = 0; method < method_names.size(); ++method)
+            samples[method].merge(local_samples[method]);
+    });
+
+    for (size_t method = 0; method < method_names.size(); ++method)
+        samples[method].write(std::string{args.path_out} + method_names[method] + "_"+ std::string{sequence_file.stem()} + "_sample.out",
+                              parameters[method]);
+    return samples;
+}
+
+/*! \brief Estimates the number of distinct hash values of one sequence file.
+ *  \param sequence_file The sequence file.
+ *  \param hasher Callable `hasher(seq, emit)`, which calls `emit(method, hash)` for every hash value of `seq`, where
+ *                `method` is the index of the method. Every thread hashes with its own copy.
+ *  \param methods The number of methods.
+ *  \param threads The number of threads used to hash the records of the file.
+ *  \returns The HyperLogLog sketch of every method.
+ *
+ *  Every batch of records is sketched on its own and merged, which gives the same sketches for any number of threads.
+ */
+template <typename hasher_t>
+std::vector<minions::hyperloglog> estimate_file(std::filesystem::path const & sequence_file, hasher_t const & hasher, size_t const methods, size_t const threads)
+{
+    std::vector<minions::hyperloglog> sketches(methods);
+    std::mutex mutex{};
+    for_each_record_batch(sequence_file, threads, [&] (uint64_t, auto & records)
+    {
+        hasher_t local_hasher{hasher};
+        std::vector<minions::hyperloglog> local_sketches(methods);
+        for (auto & seq : records)
+            local_hasher(seq, [&] (size_t const method, uint64_t const hash)
             {
-                if (syncmer_filter(hash, args.w_size.get(), (args.k_size *args.order),  args.positions, args.seed_se.get()))
-                    vector.push_back(hash);
+                local_sketches[method].add(hash);
+            });
+
+        std::lock_guard<std::mutex> lock{mutex};
+        for (size_t method = 0; method < methods; ++method)
+            sketches[method].merge(local_sketches[method]);
+    });
+    return sketches;
+}
+
+/*! \brief Counts the hash values of all sequence files and stores the number of distinct hash values of every method.
+ *  \param sequence_files A vector of sequence files.
+ *  \param hasher Callable `hasher(seq, emit)`, which calls `emit(method, hash)` for every hash value of `seq`.
+ *  \param method_names Names of the tested methods.
+ *  \param parameters The parameters stored in the header of the count files of every method.
+ *  \param args The arguments, `args.threads` threads are shared between files and records of a file, as is the memory
+ *              limit `args.max_memory`.
+ *
+ *  With `args.approximate`, the numbers of distinct hash values are estimated from samples, see sample_file(), and the
+ *  largest relative standard error of the estimates of a method is appended to its line. With `args.estimate`, they are
+ *  estimated with HyperLogLog sketches, see estimate_file(), and the relative standard error and the estimated number
+ *  of distinct hash values of all files together are appended. Neither writes count files.
+ */
+template <typename hasher_t>
+void count_files(std::vector<std::filesystem::path> & sequence_files, hasher_t const & hasher, std::vector<std::string> const & method_names, std::vector<minions::count_file_parameters> const & parameters, range_arguments const & args)
+{
+    size_t const file_threads = std::clamp<size_t>(sequence_files.size(), 1u, std::max<size_t>(args.threads, 1u));
+    size_t const batch_threads = std::max<size_t>(1u, args.threads / file_threads);
+    // The memory limit is shared by the methods of all files, that are counted at the same time.
+    uint64_t const max_memory = (args.max_memory << 20) / (file_threads * method_names.size());
+
+    std::vector<std::vector<uint64_t>> counts_results(method_names.size(), std::vector<uint64_t>(sequence_files.size()));
+    // The relative standard errors of the estimated numbers of distinct hash values.
+    std::vector<double> counts_errors(method_names.size());
+    // The sketches of all files, for estimating the number of distinct hash values of their union.
+    std::vector<minions::hyperloglog> union_sketches(method_names.size());
+    std::mutex mutex{};
+    minions::parallel_for(sequence_files.size(), file_threads, [&] (size_t const i)
+    {
+        if (args.estimate)
+        {
+            std::vector<minions::hyperloglog> const sketches = estimate_file(sequence_files[i], hasher, method_names.size(), batch_threads);
+            std::lock_guard<std::mutex> lock{mutex};
+            for (size_t method = 0; method < method_names.size(); ++method)
+            {
+                counts_results[method][i] = std::llround(sketches[method].estimate());
+                counts_errors[method] = sketches[method].relative_error();
+                union_sketches[method].merge(sketches[method]);
             }
+            return;
         }
-        else
+
+        if (args.approximate)
         {
-            for (auto && hash : seq | input_view)
-                vector.push_back(hash);
+            std::vector<minions::approximate_counts> const samples = sample_file(sequence_files[i], hasher, method_names, args, parameters, batch_threads);
+            std::lock_guard<std::mutex> lock{mutex};
+            for (size_t method = 0; method < method_names.size(); ++method)
+            {
+                counts_results[method][i] = samples[method].distinct();
+                counts_errors[method] = std::max(counts_errors[method], samples[method].distinct_error());
+            }
+            return;
         }
+
+        std::vector<uint64_t> const distinct = count_file(sequence_files[i], hasher, method_names, args, parameters, batch_threads, max_memory);
+        for (size_t method = 0; method < method_names.size(); ++method)
+            counts_results[method][i] = distinct[method];
+    });
+
+    for (size_t method = 0; method < method_names.size(); ++method)
+    {
+        double mean_counts, stdev_counts;
+        get_mean_and_var(counts_results[method], mean_counts, stdev_counts);
+
+        // Store speed and counts
+        std::ofstream outfile;
+        outfile.open(std::string{args.path_out} + method_names[method] + "_counts.out");
+        outfile << method_names[method] << "\t" << *std::min_element(counts_results[method].begin(), counts_results[method].end()) << "\t" << mean_counts << "\t" << stdev_counts << "\t" << *std::max_element(counts_results[method].begin(), counts_results[method].end());
+        if (args.approximate || args.estimate)
+            outfile << "\t" << counts_errors[method];
+        if (args.estimate)
+            outfile << "\t" << std::llround(union_sketches[method].estimate());
+        outfile << "\n";
+        outfile.close();
     }
+}
 
-    return vector;
+/*! \brief Counts the hash values of all sequence files for a single method.
+ *  \param sequence_files A vector of sequence files.
+ *  \param hasher Callable `hasher(seq, emit)`, which calls `emit(hash)` for every hash value of `seq`.
+ *  \param method_name Name of the tested method.
+ *  \param args The arguments, `args.threads` threads are shared between files and records of a file.
+ *  \param underlying_strobemer Whether the method is applied to strobemers.
+ */
+template <typename hasher_t>
+void count_files(std::vector<std::filesystem::path> & sequence_files, hasher_t const & hasher, std::string method_name, range_arguments & args, bool underlying_strobemer)
+{
+    count_files(sequence_files, [hasher] (auto & seq, auto && emit)
+    {
+        hasher(seq, [&emit] (uint64_t const hash) { emit(0u, hash); });
+    }, std::vector<std::string>{method_name}, {count_parameters(args, underlying_strobemer)}, args);
 }
 
-template <typename urng_t, typename urng_t2>
-std::vector<uint64_t> read_seq_file(std::filesystem::path sequence_file, urng_t input_view, urng_t2 input_view2)
+/*! \brief Function, counting the number of submers.
+ *  \param sequence_files A vector of sequence files.
+ *  \param input_view View that should be tested.
+ *  \param method_name Name of the tested method.
+ *  \param args The arguments about the view to be used, needed for strobemers.
+ */
+template <typename urng_t>
+void counts(std::vector<std::filesystem::path> & sequence_files, urng_t input_view, std::string method_name, range_arguments & args)
 {
-    std::vector<uint64_t> vector{};
-    seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_file};
-    for (auto & [seq] : fin)
+    count_files(sequence_files, [input_view] (auto & seq, auto && emit)
     {
-        auto v = seq | input_view;
-        for (auto && hash : v | input_view2)
-            vector.push_back(hash);
-    }
+        for (auto && hash : seq | input_view)
+            emit(hash);
+    }, method_name, args, false);
+}
 
-    return vector;
+template <typename urng_t, typename urng_t2>
+void counts_strobemer(std::vector<std::filesystem::path> & sequence_files, urng_t input_view, urng_t2 input_view2, std::string method_name, range_arguments & args)
+{
+    count_files(sequence_files, [input_view, input_view2] (auto & seq, auto && emit)
+    {
+        for (auto && hash : seq | input_view | input_view2)
+            emit(hash);
+    }, method_name, args, true);
 }
 
-template <int strobemers>
-std::vector<uint64_t> read_seq_file(std::filesystem::path sequence_file, range_arguments & args)
+//!\brief Whether a type is a std::pair.
+template <typename type_t>
+constexpr bool is_pair_v = false;
+
+//!\brief Whether a type is a std::pair.
+template <typename first_t, typename second_t>
+constexpr bool is_pair_v<std::pair<first_t, second_t>> = true;
+
+/*! \brief The representatives of a sequence file and their positions, computed lazily one record at a time.
+ *  \tparam text Whether the sequences are read as std::string instead of ranges of seqan3::dna4.
+ *  \tparam record_representatives_t Callable `record_representatives(seq)`, which returns either a range of the hash
+ *          values of one record, whose positions are their indices, or a std::pair of a range of pairs of a
+ *          representative and its position within the record and the number of k-mers, or strobemers, of the record.
+ *  \details The positions count the k-mers, or strobemers, of all records, i.e. the records are concatenated. The
+ *           range of the current record is iterated as the representatives are consumed, so only its iterator, i.e. the
+ *           current window of the view, is stored.
+ */
+template <bool text, typename record_representatives_t>
+class representative_stream
 {
-    std::vector<uint64_t> vector{};
-    seqan3::sequence_file_input<my_traits2, seqan3::fields<seqan3::field::seq>> fin{sequence_file};
-    for (auto & [seq] : fin)
-    {
-        std::vector<std::tuple<uint64_t, unsigned int, unsigned int, unsigned int, unsigned int>> strobes_vector;
-        get_strobemers<strobemers>(seq, args, strobes_vector);
-        for (auto & t : strobes_vector) // iterate over the strobemer tuples
-            vector.push_back(std::get<0>(t));
+public:
+    representative_stream(std::filesystem::path const & sequence_file, record_representatives_t record_representatives) :
+        records{sequence_file},
+        record_representatives{std::move(record_representatives)}
+    {
+        load();
     }
 
-    return vector;
-}
+    // The iterator refers to the range, the range may refer to the callable.
+    representative_stream(representative_stream const &) = delete;
+    representative_stream & operator=(representative_stream const &) = delete;
 
-template <typename urng_t, typename urng_t2>
-void distance(std::filesystem::path sequence_file, urng_t input_view, urng_t2 compare_view, std::string method_name)
-{
-    std::vector<uint64_t> distances{};
-    seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_file};
-    for (auto & [seq] : fin)
-    {
-        int distance = 0;
-        auto representative = seq | input_view;
-        auto rep_it = representative.begin();
-        auto compare = seq | compare_view;
-        auto comp_it = compare.begin();
-        while((rep_it != representative.end()) & (comp_it != compare.end()))
-        {
-            if (*rep_it == *comp_it)
-            {
-                if (comp_it != compare.begin())
-                {
-                    distances.push_back(distance);
-                    distance = 0;
-                }
-                rep_it++;
-            }
-            distance++;
-            comp_it++;
-        }
+    //!\brief Whether all representatives have been consumed.
+    bool empty() const
+    {
+        return at_end;
     }
 
-    std::ofstream outfile;
-    outfile.open(method_name + "_"+ std::string{sequence_file.stem()} + "_distances.out");
-    for (int i = *std::min_element(distances.begin(), distances.end()); i <= *std::max_element(distances.begin(), distances.end()); i++)
+    //!\brief The current representative.
+    uint64_t hash() const
     {
-        auto count = std::count(distances.begin(), distances.end(), i);
-        if (count > 0)
-            outfile << i << "\t" << count << "\n";
+        return current_hash;
     }
-    outfile.close();
-}
 
-template <typename urng_t, typename urng_t2>
-void distance_strobemer(std::filesystem::path sequence_file, urng_t input_view, urng_t2 compare_view, std::string method_name)
-{
-    std::vector<uint64_t> distances{};
-    int distance = 0;
-    int it_1 = 0;
-    int it_2 = 0;
-
-    std::vector<uint64_t> vector{};
-    seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_file};
-    for (auto & [seq] : fin)
-    {
-        int distance = 0;
-
-        auto rep1 = seq | compare_view;
-        auto representative = rep1 | input_view;
-        auto rep_it = representative.begin();
-        auto compare = seq | compare_view;
-        auto comp_it = compare.begin();
-        do
+    //!\brief The position of the current representative.
+    uint64_t position() const
+    {
+        return offset + current_position;
+    }
+
+    //!\brief Moves to the next representative.
+    void pop()
+    {
+        ++consumed;
+        ++index;
+        ++*it;
+        load();
+    }
+
+    //!\brief Consumes all remaining representatives and returns the number of all representatives.
+    uint64_t drain()
+    {
+        while (!empty())
+            pop();
+        return consumed;
+    }
+
+    //!\brief The number of k-mers, or strobemers, of all records read so far.
+    uint64_t length() const
+    {
+        return offset + record_length;
+    }
+
+private:
+    using sequence_t = std::remove_reference_t<decltype(std::declval<sequence_records<text> &>().sequence())>;
+    using result_t = std::invoke_result_t<record_representatives_t &, sequence_t &>;
+    //!\brief Whether the callable returns the positions and the number of k-mers, or strobemers, of a record.
+    static constexpr bool with_positions = is_pair_v<result_t>;
+    using range_t = typename std::conditional_t<with_positions,
+                                                std::tuple_element<0, result_t>,
+                                                std::type_identity<result_t>>::type;
+
+    //!\brief The records, the next one is read when the representatives of the current one are consumed.
+    sequence_records<text> records;
+    record_representatives_t record_representatives;
+    //!\brief The representatives of the current record.
+    std::optional<range_t> range{};
+    //!\brief The current representative in range.
+    std::optional<std::ranges::iterator_t<range_t>> it{};
+    bool at_end{false};
+    uint64_t current_hash{0};
+    uint64_t current_position{0};
+    //!\brief The index of the current representative in the current record.
+    uint64_t index{0};
+    uint64_t consumed{0};
+    //!\brief The number of k-mers, or strobemers, of the records before the current one.
+    uint64_t offset{0};
+    //!\brief The number of k-mers, or strobemers, of the current record.
+    uint64_t record_length{0};
+
+    //!\brief Reads records until the current one has a representative left or the file ends.
+    void load()
+    {
+        while (!it || *it == std::ranges::end(*range))
         {
-            if (*rep_it == *comp_it)
+            if (it)
             {
-                if (comp_it != compare.begin())
-                {
-                    distances.push_back(distance);
-                    distance = 0;
-                }
-                rep_it++;
+                // Without positions, the number of hash values is the number of k-mers, or strobemers.
+                if constexpr (!with_positions)
+                    record_length = index;
+                it.reset();
+                range.reset();
+            }
+
+            if (!records.next())
+            {
+                at_end = true;
+                return;
+            }
+
+            offset += record_length;
+            record_length = 0;
+            index = 0;
+            auto && seq = records.sequence();
+            if constexpr (with_positions)
+            {
+                result_t result = record_representatives(seq);
+                record_length = result.second;
+                range.emplace(std::move(result.first));
             }
             else
             {
-                distance++;
+                range.emplace(record_representatives(seq));
             }
-            comp_it++;
+            it.emplace(std::ranges::begin(*range));
+        }
+
+        if constexpr (with_positions)
+        {
+            auto && [hash, position] = **it;
+            current_hash = hash;
+            current_position = position;
+        }
+        else
+        {
+            current_hash = **it;
+            current_position = index;
         }
-        while((rep_it != representative.end()) & (comp_it != compare.end()));
     }
+};
+
+/*! \brief Collects the distances of all records of a sequence file in a histogram and stores it.
+ *  \param sequence_file The sequence file.
+ *  \param record_distances Callable `record_distances(seq, histogram)`, which adds the distances of one record.
+ *  \param method_name Name of the tested method.
+ *  \param threads The number of threads, that process batches of records.
+ */
+template <typename record_distances_t>
+void distance_file(std::filesystem::path const & sequence_file,
+                   record_distances_t const & record_distances,
+                   std::string const & method_name,
+                   size_t const threads)
+{
+    minions::histogram distances{};
+    std::mutex distances_mutex{};
+    for_each_record_batch(sequence_file, std::max<size_t>(threads, 1u), [&] (uint64_t, auto & records)
+    {
+        minions::histogram local_distances{};
+        for (auto & seq : records)
+            record_distances(seq, local_distances);
+
+        std::lock_guard<std::mutex> lock{distances_mutex};
+        distances.merge(local_distances);
+    });
 
     std::ofstream outfile;
     outfile.open(method_name + "_"+ std::string{sequence_file.stem()} + "_distances.out");
-    for (int i = *std::min_element(distances.begin(), distances.end()); i <= *std::max_element(distances.begin(), distances.end()); i++)
-    {
-        auto count = std::count(distances.begin(), distances.end(), i);
-        if (count > 0)
-            outfile << i << "\t" << count << "\n";
-    }
+    outfile << distances;
     outfile.close();
 }
 
+/*! \brief Stores the distances between consecutive representatives of a sequence file.
+ *  \param sequence_file The sequence file.
+ *  \param input_view View that should be tested, must yield positions (see minions::views::with_position).
+ *  \param method_name Name of the tested method.
+ *  \param args The arguments, needed for the number of threads.
+ */
+template <typename urng_t>
+void distance(std::filesystem::path sequence_file, urng_t input_view, std::string method_name, range_arguments & args)
+{
+    distance_file(sequence_file, [input_view] (auto & seq, minions::histogram & distances)
+    {
+        uint64_t previous{0};
+        for (auto && [hash, position] : seq | input_view | minions::views::with_position)
+        {
+            if (position != 0)
+                distances.add(position - previous);
+            previous = position;
+        }
+    }, method_name, args.threads);
+}
+
+/*! \brief Stores the number of strobemers between consecutive representatives of a sequence file.
+ *  \param sequence_file The sequence file.
+ *  \param input_view View that should be tested, is applied to the strobemers and must yield positions.
+ *  \param strobemer_view The strobemer view.
+ *  \param method_name Name of the tested method.
+ *  \param args The arguments, needed for the number of threads.
+ */
+template <typename urng_t, typename urng_t2>
+void distance_strobemer(std::filesystem::path sequence_file, urng_t input_view, urng_t2 strobemer_view, std::string method_name, range_arguments & args)
+{
+    distance_file(sequence_file, [input_view, strobemer_view] (auto & seq, minions::histogram & distances)
+    {
+        std::vector<uint64_t> strobemers{};
+        std::ranges::copy(seq | strobemer_view, std::back_inserter(strobemers));
+
+        int64_t previous{-1};
+        for (auto && [hash, position] : strobemers | input_view | minions::views::with_position)
+        {
+            if (position != 0)
+                distances.add(position - previous - 1);
+            previous = position;
+        }
+    }, method_name, args.threads);
+}
+
+/*! \brief Stores the number of strobemers between consecutive syncmers of a sequence file.
+ *  \param sequence_file The sequence file.
+ *  \param input_view The strobemer view.
+ *  \param args The arguments about the syncmers.
+ *  \param method_name Name of the tested method.
+ */
 template <typename urng_t>
 void distance_syncmer(std::filesystem::path sequence_file, urng_t input_view, range_arguments & args, std::string method_name)
 {
-    std::vector<uint64_t> distances{};
-    int distance = 0;
-    int it_1 = 0;
-    int it_2 = 0;
-
-    std::vector<uint64_t> vector{};
-    seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_file};
-    for (auto & [seq] : fin)
-    {
-        int distance = 0;
-        auto representative = seq | input_view;
-        auto rep_it = representative.begin();
-        do
+    minions::syncmer_classifier const classifier{args.w_size.get(),
+                                                 args.k_size * args.order,
+                                                 args.positions,
+                                                 args.seed_se.get()};
+    distance_file(sequence_file, [input_view, &classifier] (auto & seq, minions::histogram & distances)
+    {
+        uint64_t distance{0};
+        bool first{true};
+        for (auto && hash : seq | input_view)
         {
-            if (syncmer_filter(*rep_it, args.w_size.get(), (args.k_size *args.order),  args.positions, args.seed_se.get()))
-            {
-                if (rep_it != representative.begin())
-                {
-                    distances.push_back(distance);
-                    distance = 0;
-                }
-            }
-            else
+            if (!classifier(hash))
+                ++distance;
+            else if (!first)
             {
-                distance++;
+                distances.add(distance);
+                distance = 0;
             }
-            rep_it++;
+            first = false;
         }
-        while(rep_it != representative.end());
-    }
-
-    std::ofstream outfile;
-    outfile.open(method_name + "_"+ std::string{sequence_file.stem()} + "_distances.out");
-    for (int i = *std::min_element(distances.begin(), distances.end()); i <= *std::max_element(distances.begin(), distances.end()); i++)
-    {
-        auto count = std::count(distances.begin(), distances.end(), i);
-        if (count > 0)
-            outfile << i << "\t" << count << "\n";
-    }
-    outfile.close();
+    }, method_name, args.threads);
 }
 
-void fill_positions(std::vector<bool> & positions, int pos, int match_length)
+/*! \brief Prints the number of matches, the match coverage and the island statistics.
+ *  \param matches The number of matches.
+ *  \param missed The number of missed matches.
+ *  \param coverage The coverage, finish() must have been called.
+ */
+void print_match_results(uint64_t matches, uint64_t missed, minions::match_coverage const & coverage)
 {
-    for(int j = pos; j < pos+match_length; j++)
-        positions[j] = true;
+    minions::histogram const & islands = coverage.islands();
+    std::cout << "Matches: " << matches << "\t" << "Missed: " << missed << "\n";
+    std::cout << "Match Coverage: " << coverage.percentage() << "\n";
+    std::cout << "Islands: " << islands.min() << "\t" << islands.mean() << "\t" << islands.standard_deviation() << "\t" << islands.max() << "\n";
+    std::cout << "Expected Island Size: " << islands.mean_square() << "\n";
 }
 
 /*! \brief Count the number of matches and the match coverage found in two sequence files.
@@ -472,288 +1094,457 @@ void fill_positions(std::vector<bool> & positions, int pos, int match_length)
 template <typename urng_t, int strobemers = 0>
 void match(std::filesystem::path sequence_file1, std::filesystem::path sequence_file2, urng_t input_view, std::string method_name, range_arguments & args)
 {
-    std::vector<uint64_t> seq1_vector{};
-    std::vector<uint64_t> seq2_vector{};
-    uint64_t matches{0};
-    uint64_t missed{0};
-    if constexpr (strobemers > 0)
-    {
-        seq1_vector = read_seq_file<strobemers>(sequence_file1, args);
-        seq2_vector = read_seq_file<strobemers>(sequence_file2, args);
-    }
-    else
-    {
-        seq1_vector = read_seq_file(sequence_file1, input_view, args);
-        seq2_vector = read_seq_file(sequence_file2, input_view, args);
-    }
-
-    std::size_t length{0};
-    switch(args.name)
-    {
-        case kmer: length = seq1_vector.size()+args.shape.size()-1;
-                        break;
-        case strobemer: length = seq1_vector.size()+(args.k_size * args.order)-1;
-    }
-    std::vector<bool> positions(length, false);
-    std::vector<uint64_t> islands{};
-    uint64_t current_island{0};
-    bool new_island{false};
-
-    for(int i = 0; i < seq1_vector.size(); ++i)
+    // The strobemers of the library are computed for a whole record.
+    auto record_hashes = [input_view, &args, strobes_vector = std::vector<std::tuple<uint64_t, unsigned int, unsigned int, unsigned int, unsigned int>>{}] (auto & seq) mutable
     {
-        if (seq1_vector[i] == seq2_vector[i])
+        if constexpr (strobemers > 0)
         {
-            matches++;
-            switch(args.name)
-            {
-                case kmer: fill_positions(positions, i, args.shape.size());
-                                break;
-                case strobemer: fill_positions(positions, i, (args.k_size * args.order));
-            }
+            get_strobemers<strobemers>(seq, args, strobes_vector);
+            return strobes_vector | std::views::transform([] (auto const & t) { return std::get<0>(t); });
         }
         else
         {
-            missed++;
+            return seq | input_view;
         }
-    }
+    };
+    representative_stream<(strobemers > 0), decltype(record_hashes)> stream1{sequence_file1, record_hashes};
+    representative_stream<(strobemers > 0), decltype(record_hashes)> stream2{sequence_file2, record_hashes};
 
-    for (int i = 0; i < positions.size(); ++i)
+    uint64_t const match_length = (args.name == strobemer) ? args.k_size * args.order : args.shape.size();
+    uint64_t matches{0};
+    uint64_t missed{0};
+    minions::match_coverage coverage{};
+
+    for (uint64_t i = 0; !stream1.empty(); ++i, stream1.pop())
     {
-        if (!positions[i])
+        if (!stream2.empty() && (stream1.hash() == stream2.hash()))
         {
-            current_island++;
+            matches++;
+            coverage.add(i, i + match_length);
         }
-        else if (i > 0)
+        else
         {
-            islands.push_back(current_island);
-            current_island = 0;
+            missed++;
         }
-    }
-    islands.push_back(current_island);
 
+        if (!stream2.empty())
+            stream2.pop();
+    }
 
-    double mean_island, stdev_island;
-    get_mean_and_var(islands, mean_island, stdev_island);
-
-    std::cout << "Matches: " << matches << "\t" << "Missed: " << missed << "\n";
-    std::cout << "Match Coverage: " << std::count(positions.begin(), positions.end(), true)*100.0/positions.size() << "\n";
-    std::cout << "Islands: " << *std::min_element(islands.begin(), islands.end()) << "\t" << mean_island << "\t" << stdev_island << "\t" << *std::max_element(islands.begin(), islands.end()) << "\n";
-    std::cout << "Expected Island Size: " << get_expected(islands) << "\n";
+    coverage.finish(stream1.length() + match_length - 1);
+    print_match_results(matches, missed, coverage);
 }
 
 /*! \brief Do the actual matching for repesentative methods.
- *  \param seq1_vector The first vector based on the first file.
- *  \param seq2_vector The second vector based on the second file.
- *  \param all1_vector The first vector containig all submers (kmers or strobmers) of the first file.
- *  \param all2_vector The second vector containig all submers (kmers or strobmers) of the second file.
+ *  \param rep1 The representatives of the first file and their positions.
+ *  \param rep2 The representatives of the second file and their positions.
  *  \param method_name Name of the tested method.
  *  \param args The arguments about the view to be used, needed for strobemers.
+ *  \details A position i is a match, if the next representatives at or after i in both files are the same. Between
+ *           two representatives this does not change, so the positions are handled in intervals.
  */
-void match_vectors(std::vector<uint64_t> & seq1_vector,
-                   std::vector<uint64_t> & seq2_vector,
-                   std::vector<uint64_t> & all1_vector,
-                   std::vector<uint64_t> & all2_vector,
-                   std::string method_name,
-                   range_arguments & args)
+template <typename stream1_t, typename stream2_t>
+void match_vectors(stream1_t & rep1, stream2_t & rep2, std::string method_name, range_arguments & args)
 {
     uint64_t matches{0};
-    uint64_t missed{0};
-    int it_1{0};
-    int it_2{0};
-    bool changed{true};
-    int i{0};
+    minions::match_coverage coverage{};
 
-    std::size_t length{0};
-    length = all1_vector.size()+args.shape.size()-1;
-    std::vector<bool> positions(length, false);
-    std::vector<uint64_t> islands{};
-    uint64_t current_island{0};
-    bool new_island{false};
-
-    while((it_1 < seq1_vector.size()) & (it_2 < seq2_vector.size()) & (i < all1_vector.size()))
+    for (uint64_t i = 0; !rep1.empty() && !rep2.empty();)
     {
-        if ((seq1_vector[it_1] == seq2_vector[it_2]) & changed)
+        uint64_t const next = std::min(rep1.position(), rep2.position());
+        if (rep1.hash() == rep2.hash())
         {
-            matches++;
-            fill_positions(positions, i, args.k_size);
+            matches += next - i + 1;
+            coverage.add(i, next + args.k_size);
         }
 
-        if (seq1_vector[it_1] == all1_vector[i])
-        {
-            it_1++;
-        }
-        if (seq2_vector[it_2] == all2_vector[i])
-        {
-            it_2++;
-        }
-        i++;
+        if (rep1.position() == next)
+            rep1.pop();
+        if (rep2.position() == next)
+            rep2.pop();
+        i = next + 1;
     }
 
-    for (int i = 0; i < positions.size(); ++i)
-    {
-        if (!positions[i])
-        {
-            current_island++;
-        }
-        else if (i > 0)
-        {
-            islands.push_back(current_island);
-            current_island = 0;
-        }
-    }
-    islands.push_back(current_island);
-
-    double mean_island, stdev_island;
-    get_mean_and_var(islands, mean_island, stdev_island);
-
-    missed = std::min(seq1_vector.size(), seq2_vector.size()) - matches;
-    std::cout << "Matches: " << matches << "\t" << "Missed: " << missed << "\n";
-    std::cout << "Match Coverage: " << std::count(positions.begin(), positions.end(), true)*100.0/positions.size() << "\n";
-    std::cout << "Islands: " << *std::min_element(islands.begin(), islands.end()) << "\t" << mean_island << "\t" << stdev_island << "\t" << *std::max_element(islands.begin(), islands.end()) << "\n";
-    std::cout << "Expected Island Size: " << get_expected(islands) << "\n";
+    uint64_t const missed = std::min(rep1.drain(), rep2.drain()) - matches;
+    coverage.finish(rep1.length() + args.shape.size() - 1);
+    print_match_results(matches, missed, coverage);
 }
 
 /*! \brief Count the number of matches and match coverage found in two sequence files.
  *  \param sequence_file1 The first sequence file.
  *  \param sequence_file2 The second sequence file.
- *  \param input_view View that should be tested.
- *  \param compare_view View for comparison, should be kmer_hash view.
+ *  \param input_view View that should be tested, must yield positions (see minions::views::with_position).
  *  \param method_name Name of the tested method.
  *  \param args The arguments about the view to be used, needed for strobemers.
  */
-template <typename urng_t, typename urng2_t>
-void match(std::filesystem::path sequence_file1, std::filesystem::path sequence_file2, urng_t input_view, urng2_t compare_view, std::string method_name, range_arguments & args)
+template <typename urng_t>
+void match_representatives(std::filesystem::path sequence_file1, std::filesystem::path sequence_file2, urng_t input_view, std::string method_name, range_arguments & args)
 {
-    std::vector<uint64_t> seq1_vector = read_seq_file(sequence_file1, input_view, args);
-    std::vector<uint64_t> seq2_vector = read_seq_file(sequence_file2, input_view, args);
-    std::vector<uint64_t> all1_vector = read_seq_file(sequence_file1, compare_view, args);
-    std::vector<uint64_t> all2_vector = read_seq_file(sequence_file2, compare_view, args);
+    size_t const kmer_size = args.shape.size();
+    auto record_representatives = [input_view, kmer_size] (auto & seq)
+    {
+        uint64_t const length = (seq.size() >= kmer_size) ? seq.size() - kmer_size + 1 : 0;
+        return std::pair{seq | input_view | minions::views::with_position, length};
+    };
+    representative_stream<false, decltype(record_representatives)> rep1{sequence_file1, record_representatives};
+    representative_stream<false, decltype(record_representatives)> rep2{sequence_file2, record_representatives};
+
+    match_vectors(rep1, rep2, method_name, args);
+}
 
-    match_vectors(seq1_vector, seq2_vector, all1_vector, all2_vector, method_name, args);
+/*! \brief Returns the number of strobemers of a sequence, without computing them.
+ *  \param sequence_length The length of the sequence.
+ *  \param args The arguments about the strobemers.
+ *  \details A strobemer spans the k-mers from its first strobe to the end of the window of its last strobe, see
+ *           minions::canonical_strobemer_window::span(), and every further k-mer adds one strobemer.
+ */
+uint64_t strobemer_count(uint64_t const sequence_length, range_arguments const & args)
+{
+    uint64_t const kmer_size = args.shape.size();
+    uint64_t const kmers = (sequence_length >= kmer_size) ? sequence_length - kmer_size + 1 : 0;
+    uint64_t const span = (args.order == 3) ? 2 * args.w_min + 2 * args.w_max - 1 : args.w_min + args.w_max;
+    return (kmers >= span) ? kmers - span + 1 : 0;
 }
 
 /*! \brief Count the number of matches and match coverage found in two sequence files.
  *  \param sequence_file1 The first sequence file.
  *  \param sequence_file2 The second sequence file.
- *  \param input_view View that should be tested.
- *  \param compare_view View for comparison, should be kmer_hash view.
+ *  \param input_view View that should be tested, is applied to the strobemers.
+ *  \param strobemer_view The strobemer view.
  *  \param method_name Name of the tested method.
  *  \param args The arguments about the view to be used, needed for strobemers.
  */
 template <typename urng_t, typename urng2_t>
-void match_strobemer(std::filesystem::path sequence_file1, std::filesystem::path sequence_file2, urng_t input_view, urng2_t compare_view, std::string method_name, range_arguments & args)
+void match_strobemer(std::filesystem::path sequence_file1, std::filesystem::path sequence_file2, urng_t input_view, urng2_t strobemer_view, std::string method_name, range_arguments & args)
 {
-    std::vector<uint64_t> seq1_vector = read_seq_file(sequence_file1, compare_view, input_view);
-    std::vector<uint64_t> seq2_vector = read_seq_file(sequence_file2, compare_view, input_view);
-    std::vector<uint64_t> all1_vector = read_seq_file(sequence_file1, compare_view, args);
-    std::vector<uint64_t> all2_vector = read_seq_file(sequence_file2, compare_view, args);
+    auto record_representatives = [input_view, strobemer_view, &args] (auto & seq)
+    {
+        return std::pair{seq | strobemer_view | input_view | minions::views::with_position,
+                         strobemer_count(seq.size(), args)};
+    };
+    representative_stream<false, decltype(record_representatives)> rep1{sequence_file1, record_representatives};
+    representative_stream<false, decltype(record_representatives)> rep2{sequence_file2, record_representatives};
 
-    match_vectors(seq1_vector, seq2_vector, all1_vector, all2_vector, method_name, args);
+    match_vectors(rep1, rep2, method_name, args);
 }
 
 /*! \brief Count the number of matches and match coverage found in two sequence files for syncmers bases on strobemers.
  *  \param sequence_file1 The first sequence file.
  *  \param sequence_file2 The second sequence file.
- *  \param input_view View that should be tested.
+ *  \param input_view The strobemer view.
  *  \param method_name Name of the tested method.
  *  \param args The arguments about the view to be used, needed for strobemers.
  */
 template <typename urng_t>
 void match_syncmer(std::filesystem::path sequence_file1, std::filesystem::path sequence_file2, urng_t input_view, std::string method_name, range_arguments & args)
 {
-    std::vector<uint64_t> seq1_vector = read_seq_file<urng_t, true>(sequence_file1, input_view, args);
-    std::vector<uint64_t> seq2_vector = read_seq_file<urng_t, true>(sequence_file2, input_view, args);
-    std::vector<uint64_t> all1_vector = read_seq_file(sequence_file1, input_view, args);
-    std::vector<uint64_t> all2_vector = read_seq_file(sequence_file2, input_view, args);
+    minions::syncmer_classifier const classifier{args.w_size.get(),
+                                                 args.k_size * args.order,
+                                                 args.positions,
+                                                 args.seed_se.get()};
+    // The position of a strobemer is its index.
+    auto record_representatives = [input_view, &classifier, &args] (auto & seq)
+    {
+        return std::pair{seq | input_view | minions::views::with_position
+                             | std::views::filter([&classifier] (auto const & representative)
+                               {
+                                   return classifier(representative.first);
+                               }), strobemer_count(seq.size(), args)};
+    };
+    representative_stream<false, decltype(record_representatives)> rep1{sequence_file1, record_representatives};
+    representative_stream<false, decltype(record_representatives)> rep2{sequence_file2, record_representatives};
+
+    match_vectors(rep1, rep2, method_name, args);
+}
+
+/*! \brief Writes a number to a JSON file, non-finite numbers as null.
+ *  \param outfile The output stream.
+ *  \param value The number.
+ */
+void write_json_number(std::ofstream & outfile, double const value)
+{
+    if (std::isfinite(value))
+        outfile << value;
+    else
+        outfile << "null";
+}
 
-    match_vectors(seq1_vector, seq2_vector, all1_vector, all2_vector, method_name, args);
+/*! \brief Writes an interval estimate as JSON object.
+ *  \param outfile The output stream.
+ *  \param estimate The estimate.
+ */
+void write_json_estimate(std::ofstream & outfile, minions::interval_estimate const & estimate)
+{
+    outfile << "{\"mean\": ";
+    write_json_number(outfile, estimate.mean);
+    outfile << ", \"lower\": ";
+    write_json_number(outfile, estimate.lower);
+    outfile << ", \"upper\": ";
+    write_json_number(outfile, estimate.upper);
+    outfile << "}";
 }
 
+/*! \brief The records of the sequence files, read once for all methods whose speed is measured.
+ *  \details The records are read on first use, as dna4 sequences for the views and as strings for the strobemer
+ *           library.
+ */
+class speed_input
+{
+public:
+    /*! \brief Stores the sequence files, which are read on first use.
+     *  \param sequence_files A vector of sequence files.
+     */
+    explicit speed_input(std::vector<std::filesystem::path> sequence_files) : sequence_files{std::move(sequence_files)}
+    {}
+
+    //!\brief The records, as strings if `text` is true.
+    template <bool text>
+    auto & sequences()
+    {
+        if constexpr (text)
+            return read<true>(text_sequences, text_read);
+        else
+            return read<false>(dna4_sequences, dna4_read);
+    }
+
+    //!\brief The number of bases of all records.
+    uint64_t bases() const noexcept
+    {
+        return total_bases;
+    }
+
+private:
+    //!\brief The sequence files.
+    std::vector<std::filesystem::path> sequence_files{};
+    //!\brief The records as dna4 sequences.
+    std::vector<std::vector<seqan3::dna4>> dna4_sequences{};
+    //!\brief The records as strings.
+    std::vector<std::string> text_sequences{};
+    //!\brief Whether the records were read as dna4 sequences.
+    bool dna4_read{false};
+    //!\brief Whether the records were read as strings.
+    bool text_read{false};
+    //!\brief The number of bases of all records.
+    uint64_t total_bases{0};
+
+    //!\brief Reads all records into the sequences, if they were not read yet.
+    template <bool text, typename sequences_t>
+    sequences_t & read(sequences_t & sequences, bool & is_read)
+    {
+        if (!is_read)
+        {
+            total_bases = 0;
+            for (auto & sequence_file : sequence_files)
+            {
+                for_each_sequence<text>(sequence_file, [&] (auto & seq)
+                {
+                    total_bases += seq.size();
+                    sequences.emplace_back(seq.begin(), seq.end());
+                });
+            }
+            is_read = true;
+        }
+        return sequences;
+    }
+};
+
 /*! \brief Function, that measures the speed of a method.
- *  \param sequence_files A vector of sequence files.
+ *  \param input The records of the sequence files.
  *  \param input_view View that should be tested.
  *  \param method_name Name of the tested method.
- *  \param args The arguments about the view to be used, needed for strobemers.
+ *  \param args The arguments about the view to be used, needed for strobemers, and the number of repetitions.
+ *  \throws std::invalid_argument if the sequence files contain no bases.
+ *  \details All records are read before the time is taken, so only the hashing is measured. After `args.warmup`
+ *           untimed passes over all records, `args.repetitions` passes are timed. With `args.perf_counters`, the
+ *           hardware events of the timed passes are counted as well.
  */
 template <typename urng_t, int strobemers = 0>
-void speed(std::vector<std::filesystem::path> sequence_files, urng_t input_view, std::string method_name, range_arguments & args)
+void speed(speed_input & input, urng_t input_view, std::string method_name, speed_arguments & args)
 {
-   std::vector<int> speed_results{};
-   std::ofstream outfile;
-   int count{};
-   for (int i = 0; i < sequence_files.size(); ++i)
-   {
-       robin_hood::unordered_node_map<uint64_t, uint16_t> hash_table{};
-       auto start = std::chrono::high_resolution_clock::now();
-       auto end = std::chrono::high_resolution_clock::now();
-       auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-       if constexpr (strobemers > 0)
-       {
-           seqan3::sequence_file_input<my_traits2, seqan3::fields<seqan3::field::seq>> fin{sequence_files[i]};
-           for (auto & [seq] : fin)
-           {
-               std::vector<std::tuple<uint64_t, unsigned int, unsigned int, unsigned int, unsigned int>> strobes_vector;
-               start = std::chrono::high_resolution_clock::now();
-               get_strobemers<strobemers>(seq, args, strobes_vector);
-               for (auto & t : strobes_vector) // iterate over the strobemer tuples
+    auto & sequences = input.template sequences<(strobemers > 0)>();
+    uint64_t const bases = input.bases();
+    // The times are given per sequence and per base.
+    if (bases == 0)
+        throw std::invalid_argument{"The sequence files contain no bases."};
+
+    // The sum of all hash values is stored, so the compiler can not optimize the speed by not calculating them.
+    uint64_t count{0};
+    auto hash_all = [&] ()
+    {
+        uint64_t hashes{0};
+        for (auto & seq : sequences)
+        {
+            if constexpr (strobemers > 0)
+            {
+                std::vector<std::tuple<uint64_t, unsigned int, unsigned int, unsigned int, unsigned int>> strobes_vector;
+                get_strobemers<strobemers>(seq, args, strobes_vector);
+                for (auto & t : strobes_vector) // iterate over the strobemer tuples
                     count += std::get<0>(t);
-               end = std::chrono::high_resolution_clock::now();
-               duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-               speed_results.push_back(duration.count());
-           }
-       }
-       else
-       {
-           seqan3::sequence_file_input<my_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_files[i]};
-           for (auto & [seq] : fin)
-           {
-               start = std::chrono::high_resolution_clock::now();
-               for (auto && hash : seq | input_view)
-                   count += hash; // Store hash value to enforce evaluation of it
-               end = std::chrono::high_resolution_clock::now();
-               duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
-               speed_results.push_back(duration.count());
-
-           }
-       }
-   }
+                hashes += strobes_vector.size();
+            }
+            else
+            {
+                for (auto && hash : seq | input_view)
+                {
+                    count += hash;
+                    ++hashes;
+                }
+            }
+        }
+        return hashes;
+    };
 
-   double mean_speed, stdev_speed;
-   get_mean_and_var(speed_results, mean_speed, stdev_speed);
+    for (size_t i = 0; i < args.warmup; ++i)
+        hash_all();
 
-   // Store speed, the count value is stored so the compiler can not optimize the speed by not calculating the hash values
-   outfile.open(std::string{args.path_out} + method_name + "_speed.out");
-   outfile << method_name << "\t" << *std::min_element(speed_results.begin(), speed_results.end()) << "\t" << mean_speed << "\t" << stdev_speed << "\t" << *std::max_element(speed_results.begin(), speed_results.end()) << "\t" << count << "\n";
-   outfile.close();
+    std::optional<minions::perf_counters> counters{};
+    if (args.perf_counters)
+    {
+        counters.emplace();
+        if (!counters->any_available())
+            std::cerr << "Warning: Hardware performance counters are not available, only the time is measured.\n";
+    }
+
+    uint64_t hashes{0};
+    std::vector<double> seconds{};
+    if (counters)
+        counters->start();
+    for (size_t i = 0; i < args.repetitions; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        hashes = hash_all();
+        auto end = std::chrono::steady_clock::now();
+        seconds.push_back(std::chrono::duration<double>(end - start).count());
+    }
+    if (counters)
+        counters->stop();
+
+    std::vector<double> micros_per_sequence{};
+    std::vector<double> bases_per_second{};
+    std::vector<double> hashes_per_second{};
+    std::vector<double> ns_per_base{};
+    for (double const time : seconds)
+    {
+        micros_per_sequence.push_back(time * 1e6 / sequences.size());
+        bases_per_second.push_back(bases / time);
+        hashes_per_second.push_back(hashes / time);
+        ns_per_base.push_back(time * 1e9 / bases);
+    }
+    minions::interval_estimate const per_sequence = minions::estimate_mean(micros_per_sequence);
+
+    std::ofstream outfile;
+    outfile.open(std::string{args.path_out} + method_name + "_speed.out");
+    outfile << method_name << "\t" << *std::min_element(micros_per_sequence.begin(), micros_per_sequence.end()) << "\t" << per_sequence.mean << "\t" << per_sequence.stdev << "\t" << *std::max_element(micros_per_sequence.begin(), micros_per_sequence.end()) << "\t" << count << "\n";
+    outfile.close();
+
+    outfile.open(std::string{args.path_out} + method_name + "_speed.json");
+    outfile << "{\n";
+    outfile << "  \"method\": \"" << method_name << "\",\n";
+    outfile << "  \"sequences\": " << sequences.size() << ",\n";
+    outfile << "  \"bases\": " << bases << ",\n";
+    outfile << "  \"hashes\": " << hashes << ",\n";
+    outfile << "  \"warmup\": " << args.warmup << ",\n";
+    outfile << "  \"repetitions\": " << args.repetitions << ",\n";
+    outfile << "  \"seconds\": [";
+    for (size_t i = 0; i < seconds.size(); ++i)
+        outfile << (i > 0 ? ", " : "") << seconds[i];
+    outfile << "],\n";
+    outfile << "  \"bases_per_second\": ";
+    write_json_estimate(outfile, minions::estimate_mean(bases_per_second));
+    outfile << ",\n  \"hashes_per_second\": ";
+    write_json_estimate(outfile, minions::estimate_mean(hashes_per_second));
+    outfile << ",\n  \"ns_per_base\": ";
+    write_json_estimate(outfile, minions::estimate_mean(ns_per_base));
+    if (counters)
+    {
+        // The events of all repetitions, per base.
+        outfile << ",\n  \"perf_counters_per_base\": {";
+        for (size_t e = 0; e < minions::perf_counters::event_count; ++e)
+        {
+            std::optional<uint64_t> const value = counters->value(static_cast<minions::perf_counters::event>(e));
+            outfile << (e > 0 ? ", " : "") << "\"" << minions::perf_counters::names[e] << "\": ";
+            write_json_number(outfile, value ? static_cast<double>(*value) / (bases * args.repetitions) : NAN);
+        }
+        outfile << "}";
+    }
+    outfile << "\n}\n";
+}
+
+/*! \brief Calculates the uniqueness of submers within every count file and across all count files.
+ *  \param input_files The count files, the hash values of legacy count files are sorted first.
+ *  \param oname The name of the output file.
+ *  \param threads The number of threads to use.
+ *  \throws std::invalid_argument for sample files, count files of different methods and unsorted hash values.
+ *  \details Every row has the percentage of submers with a count of 1 in the file and of submers, that no other file
+ *  has. The last row `all_files` has the percentages of all distinct submers, that occur once in total and that occur
+ *  in one file only.
+ */
+void unique_across_files(std::vector<std::filesystem::path> const & input_files, std::filesystem::path const & oname, size_t const threads)
+{
+    std::vector<minions::count_file_reader> files(input_files.size());
+    size_t const sort_threads = std::max<size_t>(1u, threads / std::max<size_t>(input_files.size(), 1u));
+    minions::parallel_for(input_files.size(), threads, [&] (size_t const i)
+    {
+        if (minions::approximate_counts::is_sample_file(input_files[i]))
+            throw std::invalid_argument{"The sample file " + input_files[i].string() + " cannot be compared across files."};
+        files[i] = minions::count_file_reader{input_files[i]};
+        files[i].sort(sort_threads);
+    });
+
+    for (size_t i = 1; i < files.size(); ++i)
+        if (!files[0].is_legacy() && !files[i].is_legacy() && files[0].parameters() != files[i].parameters())
+            throw std::invalid_argument{"The count files " + input_files[0].string() + " and " + input_files[i].string() + " were counted with different methods."};
+
+    minions::cross_file_uniqueness_result const result = minions::cross_file_uniqueness(files, threads);
+
+    auto percentage = [] (uint64_t const part, uint64_t const all)
+    {
+        return all == 0 ? 0.0 : (part * 100.0) / all;
+    };
+
+    std::ofstream outfile{oname};
+    for (size_t i = 0; i < files.size(); ++i)
+        outfile << input_files[i].stem() << "\t" << percentage(result.files[i].singletons, result.files[i].distinct)
+                << "\t" << percentage(result.files[i].exclusive, result.files[i].distinct) << "\n";
+    outfile << "all_files\t" << percentage(result.all.singletons, result.all.distinct) << "\t"
+            << percentage(result.all.exclusive, result.all.distinct) << "\n";
 }
 
 // Input files should be the output files from count
-void unique(std::vector<std::filesystem::path> input_files, std::filesystem::path oname)
+void unique(std::vector<std::filesystem::path> input_files, std::filesystem::path oname, size_t threads, bool cross_file)
 {
-   std::ifstream infile;
-   std::ofstream outfile;
-   outfile.open(oname);
+   if (cross_file)
+   {
+       unique_across_files(input_files, oname, threads);
+       return;
+   }
 
-   for (int i = 0; i < input_files.size(); ++i)
+   // The files are read in parallel, the rows are written in the order of the input files.
+   std::vector<std::string> rows(input_files.size());
+   minions::parallel_for(input_files.size(), threads, [&] (size_t const i)
    {
-       //robin_hood::unordered_node_map<uint64_t, uint16_t> hash_table{};
-       infile.open(input_files[i], std::ios::binary);
-       uint64_t submer;
-       uint16_t submer_count;
-       uint64_t singletons{0};
-       uint64_t all_counts{0};
-       while(infile.read((char*)&submer, sizeof(submer)))
+       std::ostringstream row{};
+       // Samples of counts --approximate give an estimate and its standard error.
+       if (minions::approximate_counts::is_sample_file(input_files[i]))
        {
-            infile.read((char*)&submer_count, sizeof(submer_count));
-	    if (submer_count == 1)
-            	++singletons;
-	    all_counts++;
+           minions::approximate_counts const sample = minions::approximate_counts::read(input_files[i]).first;
+           row << input_files[i].stem() << "\t" << sample.unique_fraction() * 100.0 << "\t" << sample.unique_fraction_error() * 100.0 << "\n";
+           rows[i] = row.str();
+           return;
        }
-       infile.close();
 
-       outfile << input_files[i].stem() << "\t" << (singletons * 100.0)/all_counts << "\n";
+       minions::count_file_reader const infile{input_files[i]};
+       uint64_t const singletons = std::ranges::count(infile.counts(), uint16_t{1});
+       uint64_t const all_counts = infile.size();
 
-   }
+       row << input_files[i].stem() << "\t" << (singletons * 100.0)/all_counts << "\n";
+       rows[i] = row.str();
+   });
+
+   std::ofstream outfile;
+   outfile.open(oname);
+   for (std::string const & row : rows)
+       outfile << row;
    outfile.close();
 }
 
@@ -879,8 +1670,11 @@ void do_counts(std::vector<std::filesystem::path> sequence_files, range_argument
                             }
                             break;
             case syncmer:  {
-                                auto syncmer = std::views::filter([args] (uint64_t i)
-                                                     {return syncmer_filter(i,args.w_size.get(), (args.k_size *args.order),  args.positions, args.seed_se.get());});
+                                minions::syncmer_classifier classifier{args.w_size.get(),
+                                                                       args.k_size * args.order,
+                                                                       args.positions,
+                                                                       args.seed_se.get()};
+                                auto syncmer = std::views::filter([classifier] (uint64_t i) {return classifier(i);});
                                 if (args.hybrid & (args.order == 2))
                                     counts_strobemer(sequence_files, hybridstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), syncmer, create_name(args, true), args);
                                 if (args.hybrid & (args.order == 3))
@@ -930,6 +1724,67 @@ void do_counts(std::vector<std::filesystem::path> sequence_files, range_argument
     }
 }
 
+/*! \brief Returns the minions::sketch_spec of a method.
+ *  \param args The arguments about the view to be used.
+ */
+minions::sketch_spec sketch_spec_of(range_arguments const & args)
+{
+    minions::sketch_spec spec{};
+    spec.shape = args.shape;
+    spec.window = args.w_size.get();
+    spec.seed = args.seed_se;
+    switch(args.name)
+    {
+        case kmer: spec.method = minions::sketch_method::kmer;
+                   break;
+        case minimiser: spec.method = minions::sketch_method::minimiser;
+                        break;
+        case modmers: spec.method = minions::sketch_method::modmer;
+                      break;
+        case syncmer: spec.method = minions::sketch_method::syncmer;
+                      spec.shape = seqan3::ungapped{args.k_size};
+                      spec.positions = args.positions;
+                      break;
+        case strobemer: {
+                            spec.method = minions::sketch_method::strobemer;
+                            spec.order = args.order;
+                            spec.window_min = args.w_min;
+                            spec.window_max = args.w_max;
+                            // The same precedence as do_counts.
+                            if (args.hybrid)
+                                spec.strobemer = minions::strobemer_method::hybridstrobe;
+                            else if (args.minstrobers)
+                                spec.strobemer = minions::strobemer_method::minstrobe;
+                            else if (args.rand)
+                                spec.strobemer = minions::strobemer_method::randstrobe;
+                            else
+                                throw std::invalid_argument{"Please choose rand, min or hybrid for strobemers."};
+                        }
+                        break;
+    }
+    return spec;
+}
+
+void do_counts(std::vector<std::filesystem::path> sequence_files, std::vector<range_arguments> & specs, size_t const threads)
+{
+    if (specs.empty())
+        return;
+
+    std::vector<minions::sketch_spec> sketch_specs{};
+    std::vector<std::string> method_names{};
+    std::vector<minions::count_file_parameters> parameters{};
+    for (range_arguments & args : specs)
+    {
+        sketch_specs.push_back(sketch_spec_of(args));
+        method_names.push_back(create_name(args));
+        parameters.push_back(count_parameters(args, false));
+    }
+
+    range_arguments args{specs[0]};
+    args.threads = threads;
+    count_files(sequence_files, minions::multi_sketch{std::move(sketch_specs)}, method_names, parameters, args);
+}
+
 void do_distance(std::filesystem::path sequence_file, range_arguments & args, bool underlying_strobemer)
 {
     if (underlying_strobemer)
@@ -938,32 +1793,32 @@ void do_distance(std::filesystem::path sequence_file, range_arguments & args, bo
         {
             case minimiser: {
                                 if (args.hybrid & (args.order == 2))
-                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),hybridstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),hybridstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.hybrid & (args.order == 3))
-                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),hybridstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),hybridstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.minstrobers & (args.order == 2))
-                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),minstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),minstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.minstrobers & (args.order == 3))
-                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),minstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),minstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.rand & (args.order == 2))
-                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),randstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),randstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.rand & (args.order == 3))
-                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),randstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, minions::views::minimiser(args.w_size.get()-(args.shape.size()*2)+1),randstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                             }
                             break;
             case modmers: {
                                 if (args.hybrid & (args.order == 2))
-                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), hybridstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), hybridstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.hybrid & (args.order == 3))
-                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), hybridstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), hybridstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.minstrobers & (args.order == 2))
-                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), minstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), minstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.minstrobers & (args.order == 3))
-                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), minstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), minstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.rand & (args.order == 2))
-                                    distance_strobemer(sequence_file, modmer(args.w_size.get()),randstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, modmer(args.w_size.get()),randstrobe2_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                                 if (args.rand & (args.order == 3))
-                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), randstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true));
+                                    distance_strobemer(sequence_file, modmer(args.w_size.get()), randstrobe3_hash(args.shape, args.w_min, args.w_max, args.seed_se), std::string{args.path_out} + create_name(args, true), args);
                             }
                             break;
             case syncmer:  {
@@ -987,14 +1842,14 @@ void do_distance(std::filesystem::path sequence_file, range_arguments & args, bo
     {
         switch(args.name)
         {
-            case minimiser: distance(sequence_file, seqan3::views::minimiser_hash(args.shape, args.w_size, args.seed_se),
-                                                    seqan3::views::minimiser_hash(args.shape, seqan3::window_size{args.shape.size()}, args.seed_se), std::string{args.path_out} + create_name(args));
+            case minimiser: distance(sequence_file, minions::views::minimiser_hash(args.shape, args.w_size, args.seed_se),
+                                     std::string{args.path_out} + create_name(args), args);
                             break;
             case modmers: distance(sequence_file, modmer_hash(args.shape, args.w_size.get(), args.seed_se),
-                                                  modmer_hash(args.shape, 1, args.seed_se), std::string{args.path_out} + create_name(args));
+                                   std::string{args.path_out} + create_name(args), args);
                             break;
             case syncmer: distance(sequence_file, syncmer_hash(args.w_size.get(), args.k_size, args.positions, args.seed_se),
-                                                  seqan3::views::minimiser_hash(args.shape, seqan3::window_size{args.shape.size()}, args.seed_se), std::string{args.path_out} + create_name(args));
+                                   std::string{args.path_out} + create_name(args), args);
                           break;
         }
     }
@@ -1061,15 +1916,14 @@ void do_match(std::filesystem::path sequence_file1, std::filesystem::path sequen
         {
             case kmer: match(sequence_file1, sequence_file2, seqan3::views::kmer_hash(args.shape), create_name(args), args);
                        break;
-            case minimiser: match(sequence_file1, sequence_file2, seqan3::views::minimiser_hash(args.shape,
-                                    args.w_size, args.seed_se),seqan3::views::minimiser_hash(args.shape,
-                                                            seqan3::window_size{args.shape.size()}, args.seed_se), create_name(args), args);
+            case minimiser: match_representatives(sequence_file1, sequence_file2, minions::views::minimiser_hash(args.shape,
+                                    args.w_size, args.seed_se), create_name(args), args);
                             break;
-            case modmers: match(sequence_file1, sequence_file2, modmer_hash(args.shape,
-                                    args.w_size.get(), args.seed_se), modmer_hash(args.shape, 1, args.seed_se), create_name(args), args);
+            case modmers: match_representatives(sequence_file1, sequence_file2, modmer_hash(args.shape,
+                                    args.w_size.get(), args.seed_se), create_name(args), args);
                             break;
-            case syncmer: match(sequence_file1, sequence_file2, syncmer_hash(args.w_size.get(), args.k_size, args.positions, args.seed_se), seqan3::views::minimiser_hash(args.shape,
-                                                            seqan3::window_size{args.shape.size()}, args.seed_se), create_name(args), args);
+            case syncmer: match_representatives(sequence_file1, sequence_file2, syncmer_hash(args.w_size.get(), args.k_size,
+                                    args.positions, args.seed_se), create_name(args), args);
                             break;
             case strobemer: std::ranges::empty_view<seqan3::detail::empty_type> empty{};
                             if (args.lib_implementation)
@@ -1104,44 +1958,62 @@ void do_match(std::filesystem::path sequence_file1, std::filesystem::path sequen
 }
 
 // Note: Speed is based on non-canonical version!
-void do_speed(std::vector<std::filesystem::path> sequence_files, range_arguments & args)
+/*! \brief Measures the speed of the method of the arguments.
+ *  \param input The records of the sequence files.
+ *  \param args The arguments about the view to be used.
+ */
+void speed_method(speed_input & input, speed_arguments & args)
 {
     switch(args.name)
     {
-        case kmer: speed(sequence_files, seqan3::views::kmer_hash(args.shape), create_name(args), args);
+        case kmer: speed(input, seqan3::views::kmer_hash(args.shape), create_name(args), args);
                    break;
-        case minimiser: speed(sequence_files, seqan3::views::kmer_hash(args.shape) | seqan3::views::minimiser(args.w_size.get()-args.shape.size()+1), create_name(args), args);
+        case minimiser: speed(input, seqan3::views::kmer_hash(args.shape) | seqan3::views::minimiser(args.w_size.get()-args.shape.size()+1), create_name(args), args);
                         break;
-        case modmers: speed(sequence_files, seqan3::views::kmer_hash(args.shape) | modmer(args.w_size.get()), create_name(args), args);
+        case modmers: speed(input, seqan3::views::kmer_hash(args.shape) | modmer(args.w_size.get()), create_name(args), args);
                         break;
         case strobemer: {std::ranges::empty_view<seqan3::detail::empty_type> empty{};
                         if (args.lib_implementation)
                         {
                             if (args.rand & (args.order == 2))
-                                speed<std::ranges::empty_view<seqan3::detail::empty_type>, 1>(sequence_files, empty, create_name(args), args);
+                                speed<std::ranges::empty_view<seqan3::detail::empty_type>, 1>(input, empty, create_name(args), args);
                             else if (args.rand & (args.order == 3))
-                                speed<std::ranges::empty_view<seqan3::detail::empty_type>, 2>(sequence_files, empty, create_name(args), args);
+                                speed<std::ranges::empty_view<seqan3::detail::empty_type>, 2>(input, empty, create_name(args), args);
                             else if (args.hybrid)
-                                speed<std::ranges::empty_view<seqan3::detail::empty_type>, 3>(sequence_files, empty, create_name(args), args);
+                                speed<std::ranges::empty_view<seqan3::detail::empty_type>, 3>(input, empty, create_name(args), args);
                             else if (args.minstrobers & (args.order == 2))
-                                speed<std::ranges::empty_view<seqan3::detail::empty_type>, 4>(sequence_files, empty, create_name(args), args);
+                                speed<std::ranges::empty_view<seqan3::detail::empty_type>, 4>(input, empty, create_name(args), args);
                         }
                         else
                         {
                             if (args.hybrid & (args.order == 2))
-                                speed(sequence_files, seqan3::views::kmer_hash(args.shape) | seqan3::views::hybridstrobe(args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
+                                speed(input, seqan3::views::kmer_hash(args.shape) | seqan3::views::hybridstrobe(args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
                             else if (args.hybrid & (args.order == 3))
-                                speed(sequence_files, seqan3::views::kmer_hash(args.shape) | seqan3::views::hybridstrobe(true, args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
+                                speed(input, seqan3::views::kmer_hash(args.shape) | seqan3::views::hybridstrobe(true, args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
                             else if (args.minstrobers & (args.order == 2))
-                                speed(sequence_files, seqan3::views::kmer_hash(args.shape) | seqan3::views::minstrobe(args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
+                                speed(input, seqan3::views::kmer_hash(args.shape) | seqan3::views::minstrobe(args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
                             else if (args.minstrobers & (args.order == 3))
-                                speed(sequence_files, seqan3::views::kmer_hash(args.shape) | seqan3::views::minstrobe(true, args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
+                                speed(input, seqan3::views::kmer_hash(args.shape) | seqan3::views::minstrobe(true, args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
                             else if (args.rand & (args.order == 2))
-                                speed(sequence_files, seqan3::views::kmer_hash(args.shape) | seqan3::views::randstrobe(args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
+                                speed(input, seqan3::views::kmer_hash(args.shape) | seqan3::views::randstrobe(args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
                             else if (args.rand & (args.order == 3))
-                                speed(sequence_files, seqan3::views::kmer_hash(args.shape) | seqan3::views::randstrobe(true, args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
+                                speed(input, seqan3::views::kmer_hash(args.shape) | seqan3::views::randstrobe(true, args.w_min + args.shape.size() - 1, args.w_max - args.shape.size() + 1, args.shape.count()), create_name(args), args);
                     }
                     break;}
-        case syncmer: speed(sequence_files, syncmer_hash_no_reverse(args.w_size.get(), args.k_size, args.positions), create_name(args), args);
+        case syncmer: speed(input, syncmer_hash_no_reverse(args.w_size.get(), args.k_size, args.positions), create_name(args), args);
     }
 }
+
+void do_speed(std::vector<std::filesystem::path> sequence_files, speed_arguments & args)
+{
+    speed_input input{std::move(sequence_files)};
+    speed_method(input, args);
+}
+
+void do_speed(std::vector<std::filesystem::path> sequence_files, std::vector<speed_arguments> & configurations)
+{
+    // One after another, concurrent measurements would slow each other down.
+    speed_input input{std::move(sequence_files)};
+    for (speed_arguments & args : configurations)
+        speed_method(input, args);
+}
@@ -1,14 +1,30 @@
+#include <limits>
 #include <sstream>
 
 #include <seqan3/argument_parser/all.hpp>
 #include <seqan3/core/debug_stream.hpp>
 
 #include "compare.h"
+#include "parameter_sweep.hpp"
 
 uint32_t w_size;
 uint64_t shape{};
 uint64_t se;
 
+// The values of the options counts and speed accept as lists and ranges, empty if an option is not given.
+struct sweep_options
+{
+    std::string k{};
+    std::string w{};
+    std::string w_min{};
+    std::string w_max{};
+    std::vector<std::string> positions{};
+} sweep;
+
+// The help text of options that accept lists and ranges.
+std::string const sweep_help{" Accepts a comma separated list of values and ranges first-last or first-last:step, "
+                             "e.g. 15,19 or 15-31:2, every combination of the values is run."};
+
 void string_to_methods(std::string name, methods & m)
 {
     if (name == "kmer")
@@ -23,45 +39,228 @@ void string_to_methods(std::string name, methods & m)
         m = syncmer;
 };
 
-void all_arguments(seqan3::argument_parser & parser, range_arguments & args)
+void all_arguments(seqan3::argument_parser & parser, range_arguments & args, bool const sweep_syntax = false)
 {
     parser.add_option(args.path_out, 'o', "out",
                       "Directory, where output files should be saved.");
-    parser.add_option(args.k_size, 'k', "kmer-size", "Define kmer size. For strobemer, this should be the size for one strobe.");
+    std::string const k_help{"Define kmer size. For strobemer, this should be the size for one strobe."};
+    if (sweep_syntax)
+        parser.add_option(sweep.k, 'k', "kmer-size", k_help + sweep_help);
+    else
+        parser.add_option(args.k_size, 'k', "kmer-size", k_help);
 }
 
-void read_range_arguments_strobemers(seqan3::argument_parser & parser, range_arguments & args)
+void read_range_arguments_strobemers(seqan3::argument_parser & parser, range_arguments & args, bool const sweep_syntax = false)
 {
-    parser.add_option(args.w_min, '\0', "w-min", "Define w-min for strobemers.");
-    parser.add_option(args.w_max, '\0', "w-max", "Define w-max for strobemers.");
+    if (sweep_syntax)
+    {
+        parser.add_option(sweep.w_min, '\0', "w-min", "Define w-min for strobemers." + sweep_help);
+        parser.add_option(sweep.w_max, '\0', "w-max", "Define w-max for strobemers." + sweep_help);
+    }
+    else
+    {
+        parser.add_option(args.w_min, '\0', "w-min", "Define w-min for strobemers.");
+        parser.add_option(args.w_max, '\0', "w-max", "Define w-max for strobemers.");
+    }
     parser.add_option(args.order, '\0', "order", "Define order for strobemers.", seqan3::option_spec::standard, seqan3::arithmetic_range_validator{2,3});
     parser.add_flag(args.rand, '\0', "rand", "If randstrobemers should be calculated.");
     parser.add_flag(args.hybrid, '\0', "hybrid", "If hybridstrobemers should be calculated.");
     parser.add_flag(args.minstrobers, '\0', "min", "If minstrobemers should be calculated.");
 }
 
-void read_range_arguments_syncmers(seqan3::argument_parser & parser, range_arguments & args)
+void read_range_arguments_syncmers(seqan3::argument_parser & parser, range_arguments & args, bool const sweep_syntax = false)
 {
-    parser.add_option(args.positions, 'p', "pos", "The positions that determine, if a submer is a syncmer.");
+    std::string const positions_help{"The positions that determine, if a submer is a syncmer."};
+    if (sweep_syntax)
+        parser.add_option(sweep.positions, 'p', "pos", positions_help + " Every occurrence adds one position." + sweep_help);
+    else
+        parser.add_option(args.positions, 'p', "pos", positions_help, seqan3::option_spec::standard,
+                          seqan3::arithmetic_range_validator{0, 63});
 }
 
-void read_range_arguments_minimiser(seqan3::argument_parser & parser, range_arguments & args)
+void read_range_arguments_minimiser(seqan3::argument_parser & parser, range_arguments & args, bool const sweep_syntax = false)
 {
-    parser.add_option(w_size, 'w', "window", "Define window size for minimiser. For syncmers, use this parameter for "
-                                             "the s-mer size, which should be smaller than the k-mer size in that case. Default: 60.");
+    std::string const window_help{"Define window size for minimiser. For syncmers, use this parameter for "
+                                  "the s-mer size, which should be smaller than the k-mer size in that case. Default: 60."};
+    if (sweep_syntax)
+        parser.add_option(sweep.w, 'w', "window", window_help + sweep_help);
+    else
+        parser.add_option(w_size, 'w', "window", window_help);
     parser.add_option(shape, '\0', "shape", "Define a shape by the decimal of a bitvector, where 0 symbolizes a "
                                            "position to be ignored, 1 a position considered. Default: ungapped.");
     parser.add_option(se, '\0', "seed", "Define seed.");
 }
 
-void parsing(range_arguments & args)
+void parsing(range_arguments & args, uint32_t const window, uint64_t const shape_value, uint64_t const seed_value)
 {
-    args.w_size = seqan3::window_size{w_size};
-    if (shape == 0)
+    args.w_size = seqan3::window_size{window};
+    if (shape_value == 0)
         args.shape = seqan3::ungapped{args.k_size};
     else
-        args.shape = seqan3::bin_literal{shape};
-    args.seed_se = seqan3::seed{adjust_seed(args.k_size, se)};
+        args.shape = seqan3::bin_literal{shape_value};
+    args.seed_se = seqan3::seed{adjust_seed(args.k_size, seed_value)};
+}
+
+void parsing(range_arguments & args)
+{
+    parsing(args, w_size, shape, se);
+}
+
+// Parses a number of a spec, which must not be larger than max_value.
+template <typename value_t = uint64_t>
+value_t spec_number(std::string const & spec,
+                    std::string const & value,
+                    uint64_t const max_value = std::numeric_limits<value_t>::max())
+{
+    size_t parsed{0};
+    uint64_t number{0};
+    try
+    {
+        number = std::stoull(value, &parsed);
+    }
+    catch (std::exception const &)
+    {
+        parsed = 0;
+    }
+    if (parsed == 0 || parsed != value.size())
+        throw seqan3::validation_error{"Invalid spec " + spec + ": " + value + " is not a number."};
+    if (number > max_value)
+        throw seqan3::validation_error{"Invalid spec " + spec + ": " + value + " is not in range [0," +
+                                       std::to_string(max_value) + "]."};
+    return static_cast<value_t>(number);
+}
+
+/*! \brief Parses a method spec of the form `method[:key=value]...`, e.g. `minimiser:k=19:w=25`.
+ *  \param spec The spec. The keys are the names of the options k, w, shape, seed, pos, w-min, w-max and order, pos
+ *              takes a comma separated list. The flags rand, min and hybrid are given without value.
+ *  \param args The arguments, parameters not given in the spec keep the values of the command line options.
+ */
+void string_to_spec(std::string const & spec, range_arguments & args)
+{
+    std::vector<std::string> fields{};
+    std::stringstream spec_stream{spec};
+    for (std::string field; std::getline(spec_stream, field, ':');)
+        fields.push_back(field);
+
+    std::string const & method = fields.empty() ? spec : fields[0];
+    if (method != "kmer" && method != "minimiser" && method != "modmer" && method != "strobemer" && method != "syncmer")
+        throw seqan3::validation_error{"Invalid spec " + spec + ": Method " + method + " is not one of "
+                                       "[kmer,minimiser,modmer,strobemer,syncmer]."};
+    string_to_methods(method, args.name);
+
+    uint32_t window{args.w_size.get()};
+    uint64_t shape_value{shape};
+    uint64_t seed_value{se};
+    for (size_t i = 1; i < fields.size(); ++i)
+    {
+        size_t const separator = fields[i].find('=');
+        std::string const key = fields[i].substr(0, separator);
+        std::string const value = (separator == std::string::npos) ? "" : fields[i].substr(separator + 1);
+
+        if (key == "rand" || key == "min" || key == "hybrid")
+        {
+            if (separator != std::string::npos)
+                throw seqan3::validation_error{"Invalid spec " + spec + ": " + key + " does not take a value."};
+            args.rand = key == "rand";
+            args.minstrobers = key == "min";
+            args.hybrid = key == "hybrid";
+        }
+        else if (key == "pos")
+        {
+            args.positions.clear();
+            std::stringstream positions{value};
+            for (std::string position; std::getline(positions, position, ',');)
+                args.positions.push_back(spec_number<int>(spec, position, 63));
+        }
+        else if (key == "k")
+            args.k_size = spec_number<uint8_t>(spec, value);
+        else if (key == "w")
+            window = spec_number<uint32_t>(spec, value);
+        else if (key == "shape")
+            shape_value = spec_number(spec, value);
+        else if (key == "seed")
+            seed_value = spec_number(spec, value);
+        else if (key == "w-min")
+            args.w_min = spec_number<unsigned int>(spec, value);
+        else if (key == "w-max")
+            args.w_max = spec_number<unsigned int>(spec, value);
+        else if (key == "order")
+            args.order = spec_number<unsigned int>(spec, value);
+        else
+            throw seqan3::validation_error{"Invalid spec " + spec + ": Unknown parameter " + key + "."};
+    }
+
+    parsing(args, window, shape_value, seed_value);
+}
+
+template <typename value_t>
+value_t sweep_value(uint64_t const value,
+                    std::string const & option,
+                    uint64_t const max_value = std::numeric_limits<value_t>::max())
+{
+    if (value > max_value)
+        throw seqan3::validation_error{"Value " + std::to_string(value) + " of option " + option + " is not in range [0," +
+                                       std::to_string(max_value) + "]."};
+    return static_cast<value_t>(value);
+}
+
+/*! \brief Returns a configuration for every combination of the values of -k, -w, --w-min, --w-max and --pos.
+ *  \param args The arguments, options that are not given keep their values.
+ */
+template <typename arguments_t>
+std::vector<arguments_t> sweep_configurations(arguments_t const & args)
+{
+    auto values = [] (std::string const & value, uint64_t const default_value)
+    {
+        return value.empty() ? std::vector<uint64_t>{default_value} : minions::parse_sweep(value);
+    };
+
+    std::vector<std::vector<uint64_t>> dimensions{};
+    try
+    {
+        dimensions = {values(sweep.k, args.k_size),
+                      values(sweep.w, w_size),
+                      values(sweep.w_min, args.w_min),
+                      values(sweep.w_max, args.w_max)};
+        for (std::string const & position : sweep.positions)
+            dimensions.push_back(minions::parse_sweep(position));
+    }
+    catch (std::invalid_argument const & error)
+    {
+        throw seqan3::validation_error{error.what()};
+    }
+
+    std::vector<arguments_t> configurations{};
+    for (std::vector<uint64_t> const & combination : minions::sweep_product(dimensions))
+    {
+        arguments_t & configuration = configurations.emplace_back(args);
+        configuration.k_size = sweep_value<uint8_t>(combination[0], "-k");
+        configuration.w_min = sweep_value<unsigned int>(combination[2], "--w-min");
+        configuration.w_max = sweep_value<unsigned int>(combination[3], "--w-max");
+        if (!sweep.positions.empty())
+        {
+            configuration.positions.clear();
+            for (size_t i = 4; i < combination.size(); ++i)
+                configuration.positions.push_back(sweep_value<int>(combination[i], "--pos", 63));
+        }
+        parsing(configuration, sweep_value<uint32_t>(combination[1], "-w"), shape, se);
+    }
+    return configurations;
+}
+
+// Removes configurations with the same name as an earlier one, e.g. k-mers with different window sizes.
+template <typename arguments_t>
+void unique_names(std::vector<arguments_t> & configurations, bool const underlying_strobemer)
+{
+    std::vector<std::string> names{};
+    std::erase_if(configurations, [&] (arguments_t & configuration)
+    {
+        std::string name = create_name(configuration, underlying_strobemer);
+        if (std::ranges::find(names, name) != names.end())
+            return true;
+        names.push_back(std::move(name));
+        return false;
+    });
 }
 
 int accuracy(seqan3::argument_parser & parser)
@@ -92,6 +291,12 @@ int accuracy(seqan3::argument_parser & parser)
     parser.add_option(args.threshold, '\0', "threshold",
                       "The threshold to use for the search.",
                       seqan3::option_spec::advanced);
+    parser.add_option(args.threads, 't', "threads", "The number of threads to use. The input files are hashed into "
+                                                    "the interleaved Bloom filter and the sequences of the search file "
+                                                    "are searched in parallel.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 1024});
+    parser.add_flag(args.skip_ibf_output, '\0', "skip-ibf-output", "Do not store the interleaved Bloom filter built "
+                                                                   "from the input files.");
 
     read_range_arguments_minimiser(parser, args);
     read_range_arguments_strobemers(parser, args);
@@ -125,14 +330,36 @@ int counts(seqan3::argument_parser & parser)
                                  "Please provide at least one sequence file.");
     parser.add_flag(underlying_strobemer,'\0', "strobemer", "If strobemers should be used as base for representative "
                                                             "methods like minimizers. Default: False.");
-    all_arguments(parser, args);
+    all_arguments(parser, args, true);
     std::string method{};
-    parser.add_option(method, '\0', "method", "Pick your method.",
-                      seqan3::option_spec::required, seqan3::value_list_validator{"kmer", "minimiser", "modmer", "strobemer", "syncmer"});
-
-    read_range_arguments_minimiser(parser, args);
-    read_range_arguments_strobemers(parser, args);
-    read_range_arguments_syncmers(parser, args);
+    parser.add_option(method, '\0', "method", "Pick your method. Required, unless --spec is given.",
+                      seqan3::option_spec::standard, seqan3::value_list_validator{"kmer", "minimiser", "modmer", "strobemer", "syncmer"});
+    std::vector<std::string> specs{};
+    parser.add_option(specs, '\0', "spec", "Count the submers of several methods in one pass over the sequence files, "
+                                           "given as method[:key=value]..., e.g. minimiser:k=19:w=25 or "
+                                           "syncmer:k=15:w=5:pos=0,10. The keys are k, w, shape, seed, pos, w-min, "
+                                           "w-max and order, and rand, min or hybrid for strobemers. Parameters not "
+                                           "given take the values of the options. Can be given multiple times.");
+    parser.add_option(args.threads, 't', "threads", "The number of threads to use. Files and batches of records of "
+                                                    "one file are processed in parallel, the output does not depend "
+                                                    "on the number of threads.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 1024});
+    parser.add_option(args.max_memory, '\0', "max-memory", "The memory in MiB for counting. The hash values are "
+                                                           "partitioned into temporary files next to the output "
+                                                           "files and counted one partition at a time, the output "
+                                                           "is the same. Default: 0, i.e. count in memory.");
+    parser.add_flag(args.approximate, '\0', "approximate", "Estimate the number of distinct submers and the fraction of "
+                                                           "unique submers from a fixed size sample instead of "
+                                                           "counting all submers. Writes {method}_{file}_sample.out "
+                                                           "files, that unique accepts, instead of count files.");
+    parser.add_flag(args.estimate, '\0', "estimate", "Only estimate the number of distinct submers with HyperLogLog "
+                                                     "sketches of 4 KiB per file and method, without writing count "
+                                                     "files. The summary gets the relative error and the estimate for "
+                                                     "all files together as additional columns.");
+
+    read_range_arguments_minimiser(parser, args, true);
+    read_range_arguments_strobemers(parser, args, true);
+    read_range_arguments_syncmers(parser, args, true);
 
     try
     {
@@ -145,8 +372,43 @@ int counts(seqan3::argument_parser & parser)
         return -1;
     }
 
-    string_to_methods(method, args.name);
-    do_counts(sequence_files, args, underlying_strobemer);
+    std::vector<range_arguments> runs{};
+    try
+    {
+        if (specs.empty() && method.empty())
+            throw seqan3::validation_error{"Option --method is required but not set."};
+        if (!specs.empty() && underlying_strobemer)
+            throw seqan3::validation_error{"Option --strobemer cannot be combined with --spec."};
+        if (args.estimate && args.approximate)
+            throw seqan3::validation_error{"Option --estimate cannot be combined with --approximate."};
+
+        string_to_methods(method, args.name);
+        for (range_arguments const & configuration : sweep_configurations(args))
+        {
+            if (specs.empty())
+                runs.push_back(configuration);
+            for (std::string const & spec : specs)
+            {
+                runs.push_back(configuration);
+                string_to_spec(spec, runs.back());
+            }
+        }
+        unique_names(runs, underlying_strobemer);
+    }
+    catch (seqan3::argument_parser_error const & ext)
+    {
+        seqan3::debug_stream << "Error. Incorrect command line input for counts. " << ext.what() << "\n";
+        return -1;
+    }
+
+    // Several methods are counted in one pass, but strobemers as base of representative methods are not supported.
+    if (specs.empty() && runs.size() == 1)
+        do_counts(sequence_files, runs[0], underlying_strobemer);
+    else if (underlying_strobemer)
+        for (range_arguments & run : runs)
+            do_counts(sequence_files, run, true);
+    else
+        do_counts(sequence_files, runs, args.threads);
 
     return 0;
 }
@@ -166,6 +428,10 @@ int distance(seqan3::argument_parser & parser)
     parser.add_flag(underlying_strobemer,'\0', "strobemer", "If strobemers should be used as base for representative "
                                                             "methods like minimizers. Default: False.");
 
+    parser.add_option(args.threads, 't', "threads", "The number of threads to use. Batches of records are processed "
+                                                    "in parallel, the output does not depend on the number of threads.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 1024});
+
     read_range_arguments_minimiser(parser, args);
     read_range_arguments_strobemers(parser, args);
     read_range_arguments_syncmers(parser, args);
@@ -227,25 +493,35 @@ int match(seqan3::argument_parser & parser)
 
 int speed(seqan3::argument_parser & parser)
 {
-    range_arguments args{};
+    speed_arguments args{};
     std::vector<std::filesystem::path> sequence_files{};
     parser.info.short_description = "Estimates the speed of a method for the given sequence files.";
     parser.add_positional_option(sequence_files,
                                  "Please provide at least one sequence file.");
-    all_arguments(parser, args);
+    all_arguments(parser, args, true);
     std::string method{};
     parser.add_option(method, '\0', "method", "Pick your method.",
                       seqan3::option_spec::required, seqan3::value_list_validator{"kmer", "minimiser", "modmer", "strobemer","syncmer"});
     parser.add_flag(args.lib_implementation, '\0', "original", "Set, if you want to use the strobemer implementation from Sahlin.");
-
-    read_range_arguments_minimiser(parser, args);
-    read_range_arguments_strobemers(parser, args);
-    read_range_arguments_syncmers(parser, args);
-
+    parser.add_option(args.warmup, '\0', "warmup", "The number of passes over all sequences before the time is taken.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{0, 1000});
+    parser.add_option(args.repetitions, '\0', "repetitions", "The number of timed passes over all sequences.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 1000});
+    parser.add_flag(args.perf_counters, '\0', "perf-counters", "Count cycles, instructions, branch misses and cache "
+                                                              "misses per base with the Linux perf_event_open interface.");
+
+    read_range_arguments_minimiser(parser, args, true);
+    read_range_arguments_strobemers(parser, args, true);
+    read_range_arguments_syncmers(parser, args, true);
+
+    std::vector<speed_arguments> configurations{};
     try
     {
         parser.parse();
         parsing(args);
+        string_to_methods(method, args.name);
+        configurations = sweep_configurations(args);
+        unique_names(configurations, false);
     }
     catch (seqan3::argument_parser_error const & ext)                     // catch user errors
     {
@@ -253,8 +529,15 @@ int speed(seqan3::argument_parser & parser)
         return -1;
     }
 
-    string_to_methods(method, args.name);
-    do_speed(sequence_files, args);
+    try
+    {
+        do_speed(sequence_files, configurations);
+    }
+    catch (std::invalid_argument const & ext)
+    {
+        seqan3::debug_stream << "Error. Incorrect command line input for speed. " << ext.what() << "\n";
+        return -1;
+    }
 
     return 0;
 }
@@ -265,8 +548,18 @@ int unique(seqan3::argument_parser & parser)
     std::vector<std::filesystem::path> input_files{};
     parser.info.short_description = "Calculates the percentage of unique submers of a method for the given files.";
     parser.add_positional_option(input_files,
-                                 "Please provide at least one input file. An input file is a count file obtained by minions count.");
+                                 "Please provide at least one input file. An input file is a count file or a sample file "
+                                 "obtained by minions counts.");
     parser.add_option(oname, 'o', "out", "Name of the output file.");
+    size_t threads{1};
+    parser.add_option(threads, 't', "threads", "The number of threads to use. The input files are read and merged in "
+                                               "parallel, the output does not depend on the number of threads.",
+                      seqan3::option_spec::standard, seqan3::arithmetic_range_validator{1, 1024});
+    bool cross_file{false};
+    parser.add_flag(cross_file, '\0', "cross-file", "Also report the percentage of submers, that no other input file "
+                                                    "has, by merging the sorted count files. The last row gives both "
+                                                    "percentages for all input files together. Sample files are not "
+                                                    "accepted.");
 
     try
     {
@@ -278,7 +571,15 @@ int unique(seqan3::argument_parser & parser)
         return -1;
     }
 
-    unique(input_files, oname);
+    try
+    {
+        unique(input_files, oname, threads, cross_file);
+    }
+    catch (std::invalid_argument const & ext)
+    {
+        seqan3::debug_stream << "Error. Incorrect command line input for unique. " << ext.what() << "\n";
+        return -1;
+    }
 
     return 0;
 }
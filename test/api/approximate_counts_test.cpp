@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "approximate_counts.hpp"
+#include "flat_count_table.hpp"
+
+std::filesystem::path temporary_file(std::string const & name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+TEST(approximate_counts, exact)
+{
+    // Fewer distinct hash values than the sample size.
+    minions::approximate_counts counts{100};
+    for (uint64_t hash : {42u, 7u, 42u, 0u, 3u})
+        counts.add(hash);
+    EXPECT_TRUE(counts.is_exact());
+    EXPECT_EQ(5u, counts.size());
+    EXPECT_EQ(4u, counts.distinct());
+    EXPECT_EQ(0.75, counts.unique_fraction());
+    EXPECT_EQ(0.0, counts.distinct_error());
+    EXPECT_EQ(0.0, counts.unique_fraction_error());
+}
+
+TEST(approximate_counts, estimate)
+{
+    std::mt19937_64 engine{42};
+    minions::approximate_counts counts{4096};
+    minions::flat_count_table table{};
+    for (size_t i = 0; i < 1000000; ++i)
+    {
+        // Consecutive values, like k-mer hashes.
+        uint64_t const hash = engine() % 300000;
+        counts.add(hash);
+        table.add(hash);
+    }
+    size_t singletons{0};
+    table.for_each([&] (uint64_t, uint16_t const count) { singletons += count == 1; });
+    double const fraction = static_cast<double>(singletons) / table.size();
+
+    EXPECT_FALSE(counts.is_exact());
+    // Within four standard errors.
+    EXPECT_LE(std::abs(static_cast<double>(counts.distinct()) - table.size()),
+              4 * counts.distinct_error() * table.size());
+    EXPECT_LE(std::abs(counts.unique_fraction() - fraction), 4 * counts.unique_fraction_error());
+}
+
+TEST(approximate_counts, merge)
+{
+    // Merging samples of parts gives the same sample as adding all hash values.
+    minions::approximate_counts all{64};
+    minions::approximate_counts first{64};
+    minions::approximate_counts second{64};
+    for (uint64_t hash = 0; hash < 5000; ++hash)
+    {
+        all.add(hash % 3000);
+        if (hash < 2500)
+            first.add(hash % 3000);
+        else
+            second.add(hash % 3000);
+    }
+    first.merge(second);
+    EXPECT_EQ(all.size(), first.size());
+    EXPECT_EQ(all.distinct(), first.distinct());
+    EXPECT_EQ(all.unique_fraction(), first.unique_fraction());
+}
+
+TEST(approximate_counts, skip_larger)
+{
+    minions::approximate_counts all{64};
+    minions::approximate_counts first{64};
+    for (uint64_t hash = 0; hash < 5000; ++hash)
+    {
+        all.add(hash % 3000);
+        if (hash < 2500)
+            first.add(hash % 3000);
+    }
+    minions::approximate_counts second{64};
+    second.skip_larger(first);
+    for (uint64_t hash = 2500; hash < 5000; ++hash)
+        second.add(hash % 3000);
+
+    first.merge(second);
+    EXPECT_EQ(all.distinct(), first.distinct());
+    EXPECT_EQ(all.unique_fraction(), first.unique_fraction());
+}
+
+TEST(approximate_counts, file)
+{
+    minions::approximate_counts counts{64};
+    for (uint64_t hash = 0; hash < 1000; ++hash)
+        counts.add(hash / 3);
+    minions::count_file_parameters parameters{};
+    parameters.kmer_size = 19;
+    std::filesystem::path const path = temporary_file("approximate_counts_file.out");
+    counts.write(path, parameters);
+
+    EXPECT_TRUE(minions::approximate_counts::is_sample_file(path));
+    auto const [read, read_parameters] = minions::approximate_counts::read(path);
+    EXPECT_EQ(parameters, read_parameters);
+    EXPECT_EQ(64u, read.sample_size());
+    EXPECT_EQ(1000u, read.size());
+    EXPECT_EQ(counts.distinct(), read.distinct());
+    EXPECT_EQ(counts.unique_fraction(), read.unique_fraction());
+
+    // A count file is not a sample file.
+    minions::write_count_file(path, {}, minions::flat_count_table{});
+    EXPECT_FALSE(minions::approximate_counts::is_sample_file(path));
+    EXPECT_THROW(minions::approximate_counts::read(path), std::invalid_argument);
+    std::filesystem::remove(path);
+    EXPECT_THROW(minions::approximate_counts::read(path), std::runtime_error);
+}
@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <seqan3/alphabet/container/bitpacked_sequence.hpp>
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/search/views/kmer_hash.hpp>
+#include <seqan3/std/algorithm>
+
+#include "batch.hpp"
+#include "hybridstrobe_hash.hpp"
+#include "minions_minimiser_hash.hpp"
+#include "minstrobe_hash.hpp"
+#include "modmer_hash.hpp"
+#include "randstrobe_hash.hpp"
+#include "syncmer_hash.hpp"
+
+using seqan3::operator""_dna4;
+using seqan3::operator""_shape;
+
+static constexpr seqan3::seed seed{0x8F3F73B5CF1C9ADE};
+
+// Random sequences, including ones shorter than a k-mer and low complexity ones with many equal hashes.
+std::vector<std::vector<seqan3::dna4>> random_sequences()
+{
+    std::mt19937_64 engine{42};
+    std::vector<std::vector<seqan3::dna4>> sequences{};
+    for (size_t length : {0u, 3u, 12u, 40u, 97u, 500u})
+    {
+        for (size_t alphabet : {2u, 4u})
+        {
+            std::vector<seqan3::dna4> sequence(length);
+            for (auto & symbol : sequence)
+                seqan3::assign_rank_to(static_cast<uint8_t>(engine() % alphabet), symbol);
+            sequences.push_back(std::move(sequence));
+        }
+    }
+    return sequences;
+}
+
+template <typename view_t>
+std::vector<uint64_t> to_vector(view_t && view)
+{
+    std::vector<uint64_t> result{};
+    std::ranges::copy(view, std::back_inserter(result));
+    return result;
+}
+
+TEST(batch, kernels)
+{
+    std::mt19937_64 engine{7};
+    std::vector<uint64_t> forward(103), reverse(103);
+    std::ranges::generate(forward, engine);
+    std::ranges::generate(reverse, engine);
+    // Values, that only differ in the sign bit.
+    forward[5] = 1;
+    reverse[5] = (1ULL << 63) | 1;
+
+    std::vector<uint64_t> expected_xor{forward};
+    minions::detail::xor_seed_scalar(expected_xor.data(), expected_xor.size(), seed.get());
+    std::vector<uint64_t> expected_min(forward.size());
+    minions::detail::canonical_min_scalar(forward.data(), reverse.data(), expected_min.data(), forward.size(), 3);
+
+    for (auto level : {minions::detail::simd_level::sse4_2, minions::detail::simd_level::avx2})
+    {
+        if (level > minions::detail::supported_simd_level())
+            continue;
+
+        std::vector<uint64_t> values{forward};
+        minions::detail::xor_seed(values.data(), values.size(), seed.get(), level);
+        EXPECT_EQ(expected_xor, values);
+
+        values = forward;
+        minions::detail::canonical_min(values.data(), reverse.data(), values.data(), values.size(), 3, level);
+        EXPECT_EQ(expected_min, values);
+    }
+}
+
+TEST(batch, kmer)
+{
+    minions::batch_buffer buffer{};
+    buffer.store_positions = true;
+    for (auto & sequence : random_sequences())
+    {
+        for (seqan3::shape shape : {seqan3::shape{seqan3::ungapped{5}}, 0b1001_shape, 0b1101_shape})
+        {
+            buffer.clear();
+            minions::kmer_batch(sequence, shape, buffer);
+            EXPECT_EQ(to_vector(sequence | seqan3::views::kmer_hash(shape)), buffer.hashes);
+            ASSERT_EQ(buffer.hashes.size(), buffer.positions.size());
+            for (size_t i = 0; i < buffer.positions.size(); ++i)
+                EXPECT_EQ(i, buffer.positions[i]);
+        }
+    }
+}
+
+// The k-mer sizes and window sizes around the bounds of the specialised kernels.
+TEST(batch, specialised_kernels)
+{
+    minions::batch_buffer buffer{};
+    buffer.store_positions = true;
+    for (auto & sequence : random_sequences())
+    {
+        for (uint8_t k : {15u, 19u, 20u, 31u})
+        {
+            seqan3::shape const shape{seqan3::ungapped{k}};
+            buffer.clear();
+            minions::kmer_batch(sequence, shape, buffer);
+            EXPECT_EQ(to_vector(sequence | seqan3::views::kmer_hash(shape)), buffer.hashes);
+
+            size_t const largest_specialised = k + minions::specialised_window_values - 1;
+            for (uint32_t window : {size_t{k}, largest_specialised, largest_specialised + 1, largest_specialised + 50})
+            {
+                buffer.clear();
+                minions::minimiser_batch(sequence, shape, seqan3::window_size{window}, seed, buffer);
+                EXPECT_EQ(to_vector(sequence | minions::views::minimiser_hash(shape,
+                                                                               seqan3::window_size{window},
+                                                                               seed)),
+                          buffer.hashes);
+                ASSERT_EQ(buffer.hashes.size(), buffer.positions.size());
+            }
+        }
+    }
+}
+
+TEST(batch, input)
+{
+    std::vector<seqan3::dna4> text{"ACGGCGACGTTTAGACGT"_dna4};
+    seqan3::bitpacked_sequence<seqan3::dna4> packed{text};
+    std::vector<uint8_t> ranks{};
+    for (auto symbol : text)
+        ranks.push_back(seqan3::to_rank(symbol));
+
+    minions::batch_buffer expected{};
+    minions::minimiser_batch(std::span<seqan3::dna4 const>{text}, seqan3::ungapped{4}, seqan3::window_size{6}, seed,
+                             expected);
+
+    minions::batch_buffer buffer{};
+    minions::minimiser_batch(packed, seqan3::ungapped{4}, seqan3::window_size{6}, seed, buffer);
+    EXPECT_EQ(expected.hashes, buffer.hashes);
+
+    buffer.clear();
+    minions::minimiser_batch(std::span<uint8_t const>{ranks}, seqan3::ungapped{4}, seqan3::window_size{6}, seed,
+                             buffer);
+    EXPECT_EQ(expected.hashes, buffer.hashes);
+
+    // Hashes are appended.
+    minions::minimiser_batch(ranks, seqan3::ungapped{4}, seqan3::window_size{6}, seed, buffer);
+    EXPECT_EQ(2 * expected.hashes.size(), buffer.hashes.size());
+    EXPECT_TRUE(buffer.positions.empty());
+}
+
+TEST(batch, minimiser)
+{
+    minions::batch_buffer buffer{};
+    buffer.store_positions = true;
+    for (auto & sequence : random_sequences())
+    {
+        for (seqan3::shape shape : {seqan3::shape{seqan3::ungapped{5}}, 0b1101_shape})
+        {
+            for (uint32_t window : {5u, 8u, 20u})
+            {
+                buffer.clear();
+                minions::minimiser_batch(sequence, shape, seqan3::window_size{window}, seed, buffer);
+                EXPECT_EQ(to_vector(sequence | minions::views::minimiser_hash(shape,
+                                                                               seqan3::window_size{window},
+                                                                               seed)),
+                          buffer.hashes);
+                ASSERT_EQ(buffer.hashes.size(), buffer.positions.size());
+                EXPECT_TRUE(std::ranges::is_sorted(buffer.positions));
+            }
+        }
+    }
+
+    EXPECT_THROW(minions::minimiser_batch("ACGT"_dna4, seqan3::ungapped{5}, seqan3::window_size{4}, seed, buffer),
+                 std::invalid_argument);
+}
+
+TEST(batch, modmer)
+{
+    minions::batch_buffer buffer{};
+    for (auto & sequence : random_sequences())
+    {
+        for (uint32_t mod : {1u, 2u, 5u})
+        {
+            buffer.clear();
+            minions::modmer_batch(sequence, seqan3::ungapped{5}, mod, seed, buffer);
+            EXPECT_EQ(to_vector(sequence | modmer_hash(seqan3::ungapped{5}, mod, seed)), buffer.hashes);
+
+            buffer.clear();
+            minions::modmer_batch(sequence, 0b1001_shape, mod, seqan3::seed{0}, buffer);
+            EXPECT_EQ(to_vector(sequence | modmer_hash(0b1001_shape, mod, seqan3::seed{0})), buffer.hashes);
+        }
+    }
+}
+
+TEST(batch, syncmer)
+{
+    minions::batch_buffer buffer{};
+    buffer.store_positions = true;
+    for (auto & sequence : random_sequences())
+    {
+        if (sequence.size() < 10)
+        {
+            EXPECT_THROW(minions::syncmer_batch(sequence, 2, 10, {0}, seed, buffer), std::invalid_argument);
+            continue;
+        }
+
+        for (std::vector<int> positions : {std::vector<int>{0}, std::vector<int>{0, 8}, std::vector<int>{3}})
+        {
+            buffer.clear();
+            minions::syncmer_batch(sequence, 2, 10, positions, seed, buffer);
+            EXPECT_EQ(to_vector(sequence | syncmer_hash(2, 10, positions, seed)), buffer.hashes);
+            EXPECT_TRUE(std::ranges::is_sorted(buffer.positions));
+        }
+    }
+
+    EXPECT_THROW(minions::syncmer_batch("ACGTACGT"_dna4, 4, 4, {0}, seed, buffer), std::invalid_argument);
+}
+
+template <minions::strobemer_method method, uint16_t order, typename adaptor_t>
+void compare_strobemers(adaptor_t const & adaptor, uint32_t const window_min, uint32_t const window_len)
+{
+    minions::batch_buffer buffer{};
+    buffer.store_positions = true;
+    for (auto & sequence : random_sequences())
+    {
+        buffer.clear();
+        auto view = sequence | adaptor(seqan3::ungapped{4}, window_min, window_len, seed);
+        bool view_throws{false};
+        std::vector<uint64_t> expected{};
+        try
+        {
+            expected = to_vector(view);
+        }
+        catch (std::invalid_argument const &)
+        {
+            view_throws = true;
+        }
+
+        if (view_throws)
+        {
+            EXPECT_THROW((minions::strobemer_batch<method, order>(sequence,
+                                                                  seqan3::ungapped{4},
+                                                                  window_min,
+                                                                  window_len,
+                                                                  seed,
+                                                                  buffer)),
+                         std::invalid_argument);
+            continue;
+        }
+
+        minions::strobemer_batch<method, order>(sequence, seqan3::ungapped{4}, window_min, window_len, seed, buffer);
+        EXPECT_EQ(expected, buffer.hashes);
+        for (size_t i = 0; i < buffer.positions.size(); ++i)
+            EXPECT_EQ(i, buffer.positions[i]);
+    }
+}
+
+TEST(batch, strobemer)
+{
+    using minions::strobemer_method;
+    compare_strobemers<strobemer_method::randstrobe, 2>(randstrobe2_hash, 2, 6);
+    compare_strobemers<strobemer_method::randstrobe, 3>(randstrobe3_hash, 2, 6);
+    compare_strobemers<strobemer_method::minstrobe, 2>(minstrobe2_hash, 2, 6);
+    compare_strobemers<strobemer_method::minstrobe, 3>(minstrobe3_hash, 2, 6);
+    compare_strobemers<strobemer_method::hybridstrobe, 2>(hybridstrobe2_hash, 1, 9);
+    compare_strobemers<strobemer_method::hybridstrobe, 3>(hybridstrobe3_hash, 1, 9);
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/std/algorithm>
+#include <seqan3/test/expect_range_eq.hpp>
+
+#include "canonical_strobemer.hpp"
+#include "hybridstrobe_hash.hpp"
+#include "minstrobe_hash.hpp"
+#include "randstrobe_hash.hpp"
+
+using seqan3::operator""_dna4;
+
+using minions::strobemer_method;
+
+// Returns the strobemers of one strand by scanning every window, i.e. the definition of the strobemer views.
+template <strobemer_method method, uint16_t order>
+std::vector<uint64_t> expected_strobemers(std::vector<uint64_t> const & values,
+                                          size_t const window_dist,
+                                          size_t const window_size,
+                                          uint64_t const multi)
+{
+    size_t const third_offset = 2 * window_dist + window_size - 1;
+    size_t const span = (order == 3) ? third_offset + window_size : window_dist + window_size;
+    size_t const elem_r = (window_size + 2) / 3;
+
+    // Returns the selected strobe of the window starting at begin.
+    auto select = [&] (uint64_t const first, uint64_t const second, auto begin)
+    {
+        if constexpr (method == strobemer_method::randstrobe)
+        {
+            uint64_t strobe = *begin;
+            for (auto it = begin; it != begin + window_size; ++it)
+                if (((first + second + *it) & 0x1C5C4AE) <= ((first + second + strobe) & 0x1C5C4AE))
+                    strobe = *it;
+            return strobe;
+        }
+        else if constexpr (method == strobemer_method::minstrobe)
+        {
+            return *std::min_element(begin, begin + window_size);
+        }
+        else
+        {
+            return *std::min_element(begin + (first % 3) * elem_r,
+                                     begin + std::min((first % 3 + 1) * elem_r, window_size));
+        }
+    };
+
+    std::vector<uint64_t> result{};
+    for (size_t i = 0; i + span <= values.size(); ++i)
+    {
+        uint64_t const first = values[i];
+        uint64_t const second = select(first, 0, values.begin() + i + window_dist);
+        if constexpr (order == 3)
+        {
+            uint64_t const third = select(first, second, values.begin() + i + third_offset);
+            result.push_back(first * my_pow(4, multi * 2) + second * my_pow(4, multi) + third);
+        }
+        else
+        {
+            result.push_back(first * my_pow(4, multi) + second);
+        }
+    }
+    return result;
+}
+
+// Computes the strobemers of both strands separately and combines them, like the former strobemer hash views did.
+template <strobemer_method method, uint16_t order>
+void compare_with_both_strands(size_t const window_dist, size_t const window_size)
+{
+    std::mt19937_64 engine{window_dist * 100 + window_size};
+
+    for (size_t length : {1u, 10u, 20u, 50u, 200u})
+    {
+        std::vector<uint64_t> forward(length), reverse(length);
+        std::ranges::generate(forward, [&engine] () { return engine() % 64; });
+        std::ranges::generate(reverse, [&engine] () { return engine() % 64; });
+
+        std::vector<uint64_t> reverse_sequence(reverse.rbegin(), reverse.rend());
+        std::vector<uint64_t> forward_strobemers = expected_strobemers<method, order>(forward, window_dist, window_size, 3);
+        std::vector<uint64_t> reverse_strobemers = expected_strobemers<method, order>(reverse_sequence,
+                                                                                      window_dist,
+                                                                                      window_size,
+                                                                                      3);
+        std::ranges::reverse(reverse_strobemers);
+
+        std::vector<uint64_t> expected{};
+        for (size_t i = 0; i < forward_strobemers.size(); ++i)
+            expected.push_back(std::min(forward_strobemers[i], reverse_strobemers[i]));
+
+        minions::canonical_strobemer_window<method, order> window{window_dist, window_size, 3};
+        std::vector<uint64_t> result{};
+        for (size_t i = 0; i < length; ++i)
+        {
+            window.push(forward[i], reverse[i]);
+            if (window.full())
+                result.push_back(window.value());
+        }
+
+        EXPECT_EQ(expected, result) << "length " << length;
+    }
+}
+
+TEST(canonical_strobemer, randstrobe)
+{
+    for (size_t window_dist : {1u, 4u, 9u})
+    {
+        for (size_t window_size : {1u, 3u, 8u})
+        {
+            compare_with_both_strands<strobemer_method::randstrobe, 2>(window_dist, window_size);
+            compare_with_both_strands<strobemer_method::randstrobe, 3>(window_dist, window_size);
+        }
+    }
+}
+
+TEST(canonical_strobemer, minstrobe)
+{
+    for (size_t window_dist : {1u, 4u, 9u})
+    {
+        for (size_t window_size : {1u, 3u, 8u})
+        {
+            compare_with_both_strands<strobemer_method::minstrobe, 2>(window_dist, window_size);
+            compare_with_both_strands<strobemer_method::minstrobe, 3>(window_dist, window_size);
+        }
+    }
+}
+
+TEST(canonical_strobemer, hybridstrobe)
+{
+    for (size_t window_dist : {1u, 4u, 9u})
+    {
+        for (size_t window_size : {3u, 5u, 9u})
+        {
+            compare_with_both_strands<strobemer_method::hybridstrobe, 2>(window_dist, window_size);
+            compare_with_both_strands<strobemer_method::hybridstrobe, 3>(window_dist, window_size);
+        }
+    }
+
+    EXPECT_THROW((minions::canonical_strobemer_window<strobemer_method::hybridstrobe, 2>{4, 4, 3}),
+                 std::invalid_argument);
+    EXPECT_THROW((minions::canonical_strobemer_window<strobemer_method::randstrobe, 2>{4, 0, 3}),
+                 std::invalid_argument);
+}
+
+TEST(canonical_strobemer, view)
+{
+    std::vector<seqan3::dna4> text{"ACGGCGACGTTTAG"_dna4};
+    auto view = text | randstrobe2_hash(seqan3::ungapped{4}, 1, 6, seqan3::seed{0});
+
+    // The view is lazy, every traversal computes the same strobemers.
+    EXPECT_RANGE_EQ((std::vector<uint64_t>{6683, 1637, 357, 39103, 25074}), view);
+    EXPECT_RANGE_EQ((std::vector<uint64_t>{6683, 1637, 357, 39103, 25074}), view);
+    EXPECT_EQ(5, std::ranges::distance(view));
+
+    // The range is longer than one window, but shorter than one strobemer.
+    EXPECT_TRUE(std::ranges::empty(text | minstrobe3_hash(seqan3::ungapped{4}, 1, 6, seqan3::seed{0})));
+
+    // The range is too short.
+    std::vector<seqan3::dna4> short_text{"ACGGCG"_dna4};
+    auto short_view = short_text | hybridstrobe2_hash(seqan3::ungapped{4}, 1, 6, seqan3::seed{0});
+    EXPECT_THROW(std::ranges::begin(short_view), std::invalid_argument);
+}
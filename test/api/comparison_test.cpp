@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <fstream>
+#include <random>
+
 #include <seqan3/test/expect_range_eq.hpp>
 
 #include "compare.h"
@@ -33,6 +36,56 @@ TEST(minions, small_example)
     std::filesystem::remove(std::string{args.path_out} + "kmer_hash_19_example1.out");
 }
 
+// Writes records of random bases, every record occurs twice, `records / 2` records apart.
+void write_random_fasta(std::filesystem::path const & path, size_t const records, size_t const length)
+{
+    std::mt19937_64 engine{42};
+    std::vector<std::string> sequences(records / 2, std::string(length, 'A'));
+    for (std::string & sequence : sequences)
+        for (char & base : sequence)
+            base = "ACGT"[engine() % 4];
+
+    std::ofstream outfile{path};
+    for (size_t i = 0; i < records; ++i)
+        outfile << ">record" << i << "\n" << sequences[i % sequences.size()] << "\n";
+}
+
+TEST(minions, counts_threads)
+{
+    range_arguments args{};
+    args.name = minimiser;
+    args.k_size = 19;
+    args.shape = seqan3::ungapped{19};
+    args.w_size = seqan3::window_size{23};
+    std::string const tmp{std::filesystem::temp_directory_path()};
+
+    // 6 MB of bases give several batches of records for every thread, repeated records are counted in different
+    // batches.
+    std::filesystem::path const random_file{tmp + "/counts_threads.fasta"};
+    write_random_fasta(random_file, 600, 10000);
+
+    args.path_out = std::filesystem::path{tmp + "/serial_"};
+    do_counts({DATADIR"example1.fasta", random_file}, args);
+    args.threads = 4;
+    args.path_out = std::filesystem::path{tmp + "/parallel_"};
+    do_counts({DATADIR"example1.fasta", random_file}, args);
+
+    for (std::string const file : {"minimiser_hash_19_23_example1_counts.out",
+                                   "minimiser_hash_19_23_counts_threads_counts.out",
+                                   "minimiser_hash_19_23_counts.out"})
+    {
+        std::ifstream serial{tmp + "/serial_" + file, std::ios::binary};
+        std::ifstream parallel{tmp + "/parallel_" + file, std::ios::binary};
+        std::string const serial_content{std::istreambuf_iterator<char>{serial}, std::istreambuf_iterator<char>{}};
+        std::string const parallel_content{std::istreambuf_iterator<char>{parallel}, std::istreambuf_iterator<char>{}};
+        EXPECT_FALSE(serial_content.empty());
+        EXPECT_EQ(serial_content, parallel_content);
+        std::filesystem::remove(tmp + "/serial_" + file);
+        std::filesystem::remove(tmp + "/parallel_" + file);
+    }
+    std::filesystem::remove(random_file);
+}
+
 TEST(minions, accuracy_binary_file)
 {
     accuracy_arguments args{};
@@ -184,3 +237,108 @@ TEST(minions, accuracy_sequence_file)
     //std::filesystem::remove(std::string{args.path_out} + "minimiser_hash_19_19_" + std::string{args.search_file.stem()} + ".search_out");
     //std::filesystem::remove(std::string{args.path_out} + "minimiser_hash_19_19_" + std::string{args.search_file.stem()} + "_accuracy.out");
 }
+
+TEST(minions, accuracy_count_file)
+{
+    accuracy_arguments args{};
+    args.name = minimiser;
+    args.k_size = 19;
+    args.w_size = seqan3::window_size{19};
+    args.shape = seqan3::ungapped{19};
+    args.seed_se = seqan3::seed{adjust_seed(args.k_size)};
+    args.path_out = std::filesystem::path{std::string{std::filesystem::temp_directory_path()} + "/count_file_"};
+    do_counts({DATADIR"example1.fasta"}, args);
+
+    args.input_file = {std::string{args.path_out} + "minimiser_hash_19_19_example1_counts.out"};
+    args.ibfsize = 1000000;
+    args.search_file = DATADIR"search.fasta";
+    args.solution_file = DATADIR"expected_search_result.out";
+    do_accuracy(args);
+
+    std::string line;
+    std::ifstream infile{std::string{args.path_out} + "minimiser_hash_19_19_" + std::string{args.search_file.stem()} + "_accuracy.out"};
+    std::getline(infile, line);
+    EXPECT_EQ("minimiser_hash_19_19\t2\t0\t0\t0", line);
+
+    // The count file was created with another window size.
+    args.w_size = seqan3::window_size{23};
+    EXPECT_THROW(do_accuracy(args), std::invalid_argument);
+
+    for (std::string const file : {"minimiser_hash_19_19_example1_counts.out", "minimiser_hash_19_19_counts.out",
+                                   "minimiser_hash_19_19.ibf", "minimiser_hash_19_19_search.search_out",
+                                   "minimiser_hash_19_19_search_accuracy.out"})
+        std::filesystem::remove(std::string{args.path_out} + file);
+}
+
+TEST(minions, accuracy_threads)
+{
+    accuracy_arguments args{};
+    args.name = minimiser;
+    args.k_size = 19;
+    args.w_size = seqan3::window_size{19};
+    args.shape = seqan3::ungapped{19};
+    args.seed_se = seqan3::seed{adjust_seed(args.k_size)};
+    args.input_file = {DATADIR"example1.fasta", DATADIR"search.fasta", DATADIR"example1.fasta"};
+    args.ibfsize = 1000000;
+    std::string const tmp{std::filesystem::temp_directory_path()};
+
+    // The records of search.fasta, repeated 20 times under different names, the first one belongs to the second bin.
+    args.search_file = tmp + "/search_threads.fasta";
+    args.solution_file = tmp + "/search_threads_solution.out";
+    {
+        std::ifstream search{DATADIR"search.fasta"};
+        std::string line{};
+        std::vector<std::string> lines{};
+        while (std::getline(search, line))
+            lines.push_back(line);
+        ASSERT_EQ(4u, lines.size());
+
+        std::ofstream search_file{args.search_file};
+        std::ofstream solution_file{args.solution_file};
+        for (size_t i = 0; i < 20; ++i)
+        {
+            search_file << ">test" << i << "\n" << lines[1] << "\n>poly" << i << "\n" << lines[3] << "\n";
+            solution_file << "test" << i << "\t1\n" << "poly" << i << "\t0\n";
+        }
+    }
+
+    args.path_out = std::filesystem::path{tmp + "/serial_"};
+    do_accuracy(args);
+    // Every search sequence is a chunk of its own, so the chunks are searched in parallel and merged in order. A batch
+    // holds 4 chunks per thread, so the 40 sequences are read in 4 batches, which pass the bounded queues.
+    args.threads = 3;
+    args.chunk_size = 1;
+    args.path_out = std::filesystem::path{tmp + "/parallel_"};
+    do_accuracy(args);
+
+    seqan3::interleaved_bloom_filter serial{};
+    seqan3::interleaved_bloom_filter parallel{};
+    load_ibf(serial, tmp + "/serial_minimiser_hash_19_19.ibf");
+    load_ibf(parallel, tmp + "/parallel_minimiser_hash_19_19.ibf");
+    EXPECT_TRUE(serial == parallel);
+
+    for (std::string const file : {"minimiser_hash_19_19_search_threads.search_out",
+                                   "minimiser_hash_19_19_search_threads_accuracy.out"})
+    {
+        std::ifstream serial_file{tmp + "/serial_" + file};
+        std::ifstream parallel_file{tmp + "/parallel_" + file};
+        std::string const serial_content{std::istreambuf_iterator<char>{serial_file}, std::istreambuf_iterator<char>{}};
+        std::string const parallel_content{std::istreambuf_iterator<char>{parallel_file},
+                                           std::istreambuf_iterator<char>{}};
+        EXPECT_FALSE(serial_content.empty());
+        EXPECT_EQ(serial_content, parallel_content);
+    }
+
+    // Without output, the ibf is only kept in memory.
+    args.skip_ibf_output = true;
+    args.path_out = std::filesystem::path{tmp + "/skipped_"};
+    do_accuracy(args);
+    EXPECT_FALSE(std::filesystem::exists(tmp + "/skipped_minimiser_hash_19_19.ibf"));
+
+    for (std::string const prefix : {"/serial_", "/parallel_", "/skipped_"})
+        for (std::string const file : {"minimiser_hash_19_19.ibf", "minimiser_hash_19_19_search_threads.search_out",
+                                       "minimiser_hash_19_19_search_threads_accuracy.out"})
+            std::filesystem::remove(tmp + prefix + file);
+    std::filesystem::remove(args.search_file);
+    std::filesystem::remove(args.solution_file);
+}
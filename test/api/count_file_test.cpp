@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <robin_hood.h>
+
+#include "count_file.hpp"
+
+std::filesystem::path temporary_file(std::string const & name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+TEST(count_file, round_trip)
+{
+    robin_hood::unordered_node_map<uint64_t, uint16_t> table{{42, 1}, {7, 3}, {1ULL << 63, 65534}, {0, 2}};
+    minions::count_file_parameters parameters{};
+    parameters.method = 1;
+    parameters.kmer_size = 19;
+    parameters.window_size = 23;
+    parameters.seed = 0x8F3F73B5CF1C9ADE;
+    std::filesystem::path const path = temporary_file("count_file_round_trip.out");
+    minions::write_count_file(path, parameters, table);
+
+    // Header, hash values, counts.
+    EXPECT_EQ(64u + 4 * 8 + 4 * 2, std::filesystem::file_size(path));
+
+    minions::count_file_reader reader{path};
+    EXPECT_FALSE(reader.is_legacy());
+    EXPECT_EQ(parameters, reader.parameters());
+    EXPECT_EQ(4u, reader.size());
+    EXPECT_EQ((std::vector<uint64_t>{0, 7, 42, 1ULL << 63}),
+              (std::vector<uint64_t>{reader.hashes().begin(), reader.hashes().end()}));
+    EXPECT_EQ((std::vector<uint16_t>{2, 3, 1, 65534}),
+              (std::vector<uint16_t>{reader.counts().begin(), reader.counts().end()}));
+
+    // The spans stay valid when the reader is moved.
+    minions::count_file_reader moved{std::move(reader)};
+    EXPECT_EQ(42u, moved.hashes()[2]);
+    std::filesystem::remove(path);
+}
+
+TEST(count_file, empty)
+{
+    robin_hood::unordered_node_map<uint64_t, uint16_t> table{};
+    std::filesystem::path const path = temporary_file("count_file_empty.out");
+    minions::write_count_file(path, {}, table);
+    minions::count_file_reader reader{path};
+    EXPECT_FALSE(reader.is_legacy());
+    EXPECT_EQ(0u, reader.size());
+    std::filesystem::remove(path);
+}
+
+TEST(count_file, legacy)
+{
+    std::filesystem::path const path = temporary_file("count_file_legacy.out");
+    {
+        std::ofstream outfile{path, std::ios::binary};
+        for (auto [hash, count] : {std::pair<uint64_t, uint16_t>{42, 1}, std::pair<uint64_t, uint16_t>{7, 3}})
+        {
+            outfile.write(reinterpret_cast<char const *>(&hash), sizeof(hash));
+            outfile.write(reinterpret_cast<char const *>(&count), sizeof(count));
+        }
+    }
+
+    minions::count_file_reader reader{path};
+    EXPECT_TRUE(reader.is_legacy());
+    EXPECT_EQ(minions::count_file_parameters{}, reader.parameters());
+    EXPECT_EQ((std::vector<uint64_t>{42, 7}), (std::vector<uint64_t>{reader.hashes().begin(), reader.hashes().end()}));
+    EXPECT_EQ((std::vector<uint16_t>{1, 3}), (std::vector<uint16_t>{reader.counts().begin(), reader.counts().end()}));
+
+    // Sorting keeps the counts with their hash values.
+    reader.sort(2);
+    EXPECT_EQ((std::vector<uint64_t>{7, 42}), (std::vector<uint64_t>{reader.hashes().begin(), reader.hashes().end()}));
+    EXPECT_EQ((std::vector<uint16_t>{3, 1}), (std::vector<uint16_t>{reader.counts().begin(), reader.counts().end()}));
+
+    // Neither a count file nor a legacy count file.
+    std::ofstream{path, std::ios::binary} << "invalid";
+    EXPECT_THROW(minions::count_file_reader{path}, std::invalid_argument);
+    std::filesystem::remove(path);
+}
+
+TEST(count_file, invalid_header)
+{
+    std::filesystem::path const path = temporary_file("count_file_invalid.out");
+    robin_hood::unordered_node_map<uint64_t, uint16_t> table{{42, 1}};
+    minions::write_count_file(path, {}, table);
+
+    // Truncated.
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_THROW(minions::count_file_reader{path}, std::invalid_argument);
+
+    // Unknown version.
+    minions::write_count_file(path, {}, table);
+    {
+        std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+        uint32_t const version{2};
+        file.seekp(8);
+        file.write(reinterpret_cast<char const *>(&version), sizeof(version));
+    }
+    EXPECT_THROW(minions::count_file_reader{path}, std::invalid_argument);
+    EXPECT_THROW(minions::count_file_reader{temporary_file("count_file_missing.out")}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(count_file, flat_count_table)
+{
+    minions::flat_count_table table{};
+    for (uint64_t hash : {42u, 7u, 42u, 0u})
+        table.add(hash);
+    std::filesystem::path const path = temporary_file("count_file_flat_count_table.out");
+    minions::write_count_file(path, {}, table);
+
+    minions::count_file_reader reader{path};
+    EXPECT_EQ((std::vector<uint64_t>{0, 7, 42}), (std::vector<uint64_t>{reader.hashes().begin(), reader.hashes().end()}));
+    EXPECT_EQ((std::vector<uint16_t>{1, 1, 2}), (std::vector<uint16_t>{reader.counts().begin(), reader.counts().end()}));
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include <robin_hood.h>
+
+#include "cross_file_uniqueness.hpp"
+
+std::filesystem::path temporary_file(std::string const & name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+minions::count_file_reader write_and_read(std::string const & name,
+                                          robin_hood::unordered_flat_map<uint64_t, uint16_t> const & table)
+{
+    std::filesystem::path const path = temporary_file(name);
+    minions::write_count_file(path, {}, table);
+    minions::count_file_reader reader{path};
+    std::filesystem::remove(path);
+    return reader;
+}
+
+TEST(cross_file_uniqueness, small)
+{
+    std::vector<minions::count_file_reader> files{};
+    files.push_back(write_and_read("cross_file_1.out", {{1, 1}, {2, 1}, {3, 2}}));
+    files.push_back(write_and_read("cross_file_2.out", {{2, 1}, {4, 3}}));
+    files.push_back(write_and_read("cross_file_3.out", {}));
+
+    minions::cross_file_uniqueness_result const result = minions::cross_file_uniqueness(files);
+    ASSERT_EQ(3u, result.files.size());
+    EXPECT_EQ((minions::uniqueness_counts{3, 2, 2}), result.files[0]);
+    EXPECT_EQ((minions::uniqueness_counts{2, 1, 1}), result.files[1]);
+    EXPECT_EQ((minions::uniqueness_counts{0, 0, 0}), result.files[2]);
+    // 2 occurs in both files, only 1 occurs once in total.
+    EXPECT_EQ((minions::uniqueness_counts{4, 1, 3}), result.all);
+}
+
+TEST(cross_file_uniqueness, threads)
+{
+    std::mt19937_64 engine{42};
+    std::vector<robin_hood::unordered_flat_map<uint64_t, uint16_t>> tables(5);
+    for (auto & table : tables)
+        for (size_t i = 0; i < 20000; ++i)
+            table[engine() % 50000] += engine() % 2 + 1;
+
+    std::vector<minions::count_file_reader> files{};
+    for (size_t f = 0; f < tables.size(); ++f)
+        files.push_back(write_and_read("cross_file_threads.out", tables[f]));
+
+    // Compare with counting in a map.
+    minions::cross_file_uniqueness_result expected{};
+    expected.files.resize(tables.size());
+    robin_hood::unordered_flat_map<uint64_t, std::pair<size_t, uint64_t>> all{};
+    for (auto & table : tables)
+        for (auto && [hash, count] : table)
+        {
+            ++all[hash].first;
+            all[hash].second += count;
+        }
+    for (size_t f = 0; f < tables.size(); ++f)
+        for (auto && [hash, count] : tables[f])
+            expected.files[f] += {1, count == 1u, all[hash].first == 1u};
+    for (auto && [hash, value] : all)
+        expected.all += {1, value.second == 1u, value.first == 1u};
+
+    for (size_t threads : {1u, 4u})
+    {
+        minions::cross_file_uniqueness_result const result = minions::cross_file_uniqueness(files, threads);
+        EXPECT_EQ(expected.files, result.files);
+        EXPECT_EQ(expected.all, result.all);
+    }
+}
+
+TEST(cross_file_uniqueness, unsorted)
+{
+    std::filesystem::path const path = temporary_file("cross_file_legacy.out");
+    {
+        std::ofstream outfile{path, std::ios::binary};
+        for (auto [hash, count] : {std::pair<uint64_t, uint16_t>{42, 1}, std::pair<uint64_t, uint16_t>{7, 3}})
+        {
+            outfile.write(reinterpret_cast<char const *>(&hash), sizeof(hash));
+            outfile.write(reinterpret_cast<char const *>(&count), sizeof(count));
+        }
+    }
+
+    std::vector<minions::count_file_reader> files{};
+    files.emplace_back(path);
+    std::filesystem::remove(path);
+    EXPECT_THROW(minions::cross_file_uniqueness(files), std::invalid_argument);
+
+    files[0].sort();
+    EXPECT_EQ((minions::uniqueness_counts{2, 1, 2}), minions::cross_file_uniqueness(files).files[0]);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <robin_hood.h>
+
+#include "flat_count_table.hpp"
+
+TEST(flat_count_table, add)
+{
+    minions::flat_count_table table{};
+    EXPECT_EQ(0u, table.size());
+    EXPECT_EQ(0u, table.count(42));
+
+    table.add(42);
+    table.add(0);
+    table.add(42);
+    table.add(7, 3);
+    table.add(8, 0);
+    EXPECT_EQ(3u, table.size());
+    EXPECT_EQ(2u, table.count(42));
+    EXPECT_EQ(1u, table.count(0));
+    EXPECT_EQ(3u, table.count(7));
+    EXPECT_FALSE(table.contains(8));
+    EXPECT_EQ((std::vector<uint64_t>{0, 7, 42}), table.sorted_hashes());
+
+    table.clear();
+    EXPECT_EQ(0u, table.size());
+    EXPECT_EQ(0u, table.capacity());
+}
+
+TEST(flat_count_table, saturates)
+{
+    minions::flat_count_table table{};
+    table.add(1, 65000);
+    table.add(1, 65000);
+    EXPECT_EQ(minions::flat_count_table::max_count, table.count(1));
+    table.add(1);
+    EXPECT_EQ(minions::flat_count_table::max_count, table.count(1));
+}
+
+TEST(flat_count_table, reserve)
+{
+    minions::flat_count_table table{1000};
+    size_t const capacity = table.capacity();
+    EXPECT_GE(minions::flat_count_table::max_size_for(capacity), 1000u);
+    for (uint64_t hash = 0; hash < 1000; ++hash)
+        table.add(hash << 40);
+    EXPECT_EQ(capacity, table.capacity());
+    EXPECT_EQ(1000u, table.size());
+}
+
+TEST(flat_count_table, full)
+{
+    // A full table does not grow for hash values it has.
+    minions::flat_count_table table{768};
+    EXPECT_EQ(1024u, table.capacity());
+    for (uint64_t hash = 0; hash < 768; ++hash)
+        table.add(hash);
+    table.add(5);
+    EXPECT_EQ(1024u, table.capacity());
+    EXPECT_EQ(2u, table.count(5));
+
+    table.add(768);
+    EXPECT_EQ(2048u, table.capacity());
+    EXPECT_EQ(769u, table.size());
+}
+
+TEST(flat_count_table, same_as_map)
+{
+    // Grows several times and agrees with a node based map.
+    std::mt19937_64 engine{42};
+    minions::flat_count_table table{};
+    robin_hood::unordered_node_map<uint64_t, uint16_t> expected{};
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        uint64_t const hash = engine() % 30000;
+        table.add(hash);
+        expected[hash] = std::min<uint16_t>(65534u, expected[hash] + 1);
+    }
+
+    EXPECT_EQ(expected.size(), table.size());
+    size_t visited{0};
+    table.for_each([&] (uint64_t const hash, uint16_t const count)
+    {
+        EXPECT_EQ(expected[hash], count);
+        ++visited;
+    });
+    EXPECT_EQ(expected.size(), visited);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <zlib.h>
+
+#include "gzip_input.hpp"
+
+std::filesystem::path temporary_file(std::string const & name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+// Text with a period that is not a divisor of the block or chunk sizes.
+std::string gzip_content(size_t const size)
+{
+    std::string content(size, ' ');
+    for (size_t i = 0; i < size; ++i)
+        content[i] = "ACGT\n>"[(i * 7 + i / 1001) % 6];
+    return content;
+}
+
+// Writes the content in BGZF blocks of at most 60000 bytes, followed by the empty end-of-file block.
+void write_bgzf(std::filesystem::path const & path, std::string const & content)
+{
+    std::ofstream outfile{path, std::ios::binary};
+    auto write_number = [&outfile] (uint32_t const value, size_t const size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            outfile.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    };
+
+    size_t begin{0};
+    size_t size{0};
+    do
+    {
+        size = std::min<size_t>(60000, content.size() - begin);
+        std::vector<char> compressed(compressBound(size) + 64);
+        z_stream stream{};
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(content.data() + begin));
+        stream.avail_in = size;
+        stream.next_out = reinterpret_cast<Bytef *>(compressed.data());
+        stream.avail_out = compressed.size();
+        deflate(&stream, Z_FINISH);
+        deflateEnd(&stream);
+        compressed.resize(stream.total_out);
+
+        outfile.write("\x1F\x8B\x08\x04\x00\x00\x00\x00\x00\xFF\x06\x00\x42\x43\x02\x00", 16);
+        write_number(compressed.size() + 25, 2);
+        outfile.write(compressed.data(), compressed.size());
+        write_number(crc32(0, reinterpret_cast<Bytef const *>(content.data() + begin), size), 4);
+        write_number(size, 4);
+        begin += size;
+    }
+    while (size > 0);
+}
+
+std::string read_all(minions::gzip_input & input)
+{
+    std::string content{};
+    while (std::optional<std::vector<char>> chunk = input.next())
+    {
+        EXPECT_FALSE(chunk->empty());
+        content.append(chunk->begin(), chunk->end());
+    }
+    return content;
+}
+
+TEST(gzip_input, gzip)
+{
+    // Two members, together larger than a chunk.
+    std::string const first = gzip_content(minions::gzip_input::chunk_size + 12345);
+    std::string const second = gzip_content(1000);
+    std::filesystem::path const path = temporary_file("gzip_input.gz");
+    for (std::string const * member : {&first, &second})
+    {
+        gzFile outfile = gzopen(path.c_str(), member == &first ? "wb" : "ab");
+        gzwrite(outfile, member->data(), member->size());
+        gzclose(outfile);
+    }
+
+    minions::mapped_file file{path};
+    EXPECT_TRUE(minions::gzip_input::is_gzip(file.data()));
+    minions::gzip_input input{std::move(file), path, 4};
+    EXPECT_FALSE(input.is_bgzf());
+    EXPECT_EQ(first + second, read_all(input));
+    std::filesystem::remove(path);
+}
+
+TEST(gzip_input, bgzf)
+{
+    std::string const content = gzip_content(5'000'000);
+    std::filesystem::path const path = temporary_file("gzip_input.bgzf.gz");
+    write_bgzf(path, content);
+
+    // The content does not depend on the number of threads.
+    for (size_t threads : {1u, 3u})
+    {
+        minions::gzip_input input{minions::mapped_file{path}, path, threads};
+        EXPECT_TRUE(input.is_bgzf());
+        EXPECT_EQ(content, read_all(input));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(gzip_input, bgzf_empty_blocks)
+{
+    // Only the end-of-file block.
+    std::filesystem::path const path = temporary_file("gzip_input_empty.bgzf.gz");
+    write_bgzf(path, "");
+    minions::gzip_input empty{minions::mapped_file{path}, path, 1};
+    EXPECT_TRUE(empty.is_bgzf());
+    EXPECT_EQ("", read_all(empty));
+
+    // The groups of one thread end with the last block with data, so the end-of-file block forms a group of its own.
+    size_t const blocks_per_group = (minions::gzip_input::bgzf_bytes_per_thread + 59999) / 60000;
+    std::string const content = gzip_content(2 * blocks_per_group * 60000);
+    write_bgzf(path, content);
+    minions::gzip_input input{minions::mapped_file{path}, path, 1};
+    EXPECT_EQ(content, read_all(input));
+    std::filesystem::remove(path);
+}
+
+TEST(gzip_input, stop_early)
+{
+    std::filesystem::path const path = temporary_file("gzip_input_stop.gz");
+    write_bgzf(path, gzip_content(20'000'000));
+    minions::gzip_input input{minions::mapped_file{path}, path, 2};
+    EXPECT_TRUE(input.next().has_value());
+    std::filesystem::remove(path);
+}
+
+TEST(gzip_input, invalid)
+{
+    std::filesystem::path const path = temporary_file("gzip_input_invalid.gz");
+    write_bgzf(path, gzip_content(100'000));
+    {
+        // Change a byte of the compressed data of the second block.
+        std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+        file.seekg(0);
+        std::string content(std::istreambuf_iterator<char>{file}, {});
+        size_t const second_block = 1 + static_cast<uint8_t>(content[16]) + (static_cast<uint8_t>(content[17]) << 8);
+        file.seekp(second_block + 30);
+        file.put(static_cast<char>(content[second_block + 30] ^ 0x55));
+    }
+    minions::gzip_input bgzf{minions::mapped_file{path}, path, 2};
+    EXPECT_THROW(read_all(bgzf), std::runtime_error);
+
+    // A truncated gzip file.
+    std::string const content = gzip_content(100'000);
+    gzFile outfile = gzopen(path.c_str(), "wb");
+    gzwrite(outfile, content.data(), content.size());
+    gzclose(outfile);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    minions::gzip_input gzip{minions::mapped_file{path}, path, 2};
+    EXPECT_THROW(read_all(gzip), std::runtime_error);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/test/expect_range_eq.hpp>
+
+#include "hash_policy.hpp"
+#include "minions_minimiser_hash.hpp"
+#include "modmer_hash.hpp"
+#include "shared.hpp"
+
+using seqan3::operator""_dna4;
+
+static constexpr uint64_t default_seed{0x8F3F73B5CF1C9ADE};
+
+TEST(hash_policy, fnv_compatibility)
+{
+    // Values of the former, string based fnv_hash.
+    EXPECT_EQ(48ULL, minions::fnv_hash_policy{}(0ULL, default_seed));
+    EXPECT_EQ(7696581397458ULL, minions::fnv_hash_policy{}(7ULL, default_seed));
+    EXPECT_EQ(8586808071044080262ULL, minions::fnv_hash_policy{}(12345ULL, default_seed));
+    EXPECT_EQ(12384885314899457588ULL, minions::fnv_hash_policy{}(18446744073709551615ULL, default_seed));
+    EXPECT_EQ(12345ULL, minions::fnv_hash_policy{}(12345ULL, 0));
+    EXPECT_EQ(fnv_hash(12345ULL, default_seed), minions::fnv_hash_policy{}(12345ULL, default_seed));
+}
+
+TEST(hash_policy, constexpr_policies)
+{
+    static_assert(minions::xor_hash_policy{}(5ULL, 3ULL) == 6ULL);
+    static_assert(minions::fnv_hash_policy{}(0ULL, default_seed) == 48ULL);
+    static_assert(minions::splitmix_hash_policy{}(0ULL, 0ULL) == 16294208416658607535ULL);
+    static_assert(minions::murmur_hash_policy{}(1ULL, 0ULL) == 12994781566227106604ULL);
+    static_assert(minions::wyhash_hash_policy{}(1ULL, 2ULL) == 17835814974728543209ULL);
+}
+
+TEST(hash_policy, bijective_policies)
+{
+    std::vector<uint64_t> splitmix{}, murmur{};
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        splitmix.push_back(minions::splitmix_hash_policy{}(i, default_seed));
+        murmur.push_back(minions::murmur_hash_policy{}(i, default_seed));
+    }
+    std::ranges::sort(splitmix);
+    std::ranges::sort(murmur);
+    EXPECT_EQ(std::ranges::end(splitmix), std::ranges::adjacent_find(splitmix));
+    EXPECT_EQ(std::ranges::end(murmur), std::ranges::adjacent_find(murmur));
+}
+
+TEST(hash_policy, default_policies)
+{
+    auto text = "ACGGCGACGTTTAGTTACGATGCCAGCTAGTACG"_dna4;
+    seqan3::shape const shape = seqan3::ungapped{4};
+
+    EXPECT_RANGE_EQ(text | modmer_hash(shape, 2, seqan3::seed{default_seed}),
+                    text | modmer_hash(shape, 2, seqan3::seed{default_seed}, minions::fnv_hash_policy{}));
+    EXPECT_RANGE_EQ(text | minions::views::minimiser_hash(shape, seqan3::window_size{8}, seqan3::seed{default_seed}),
+                    text | minions::views::minimiser_hash(shape,
+                                                          seqan3::window_size{8},
+                                                          seqan3::seed{default_seed},
+                                                          minions::xor_hash_policy{}));
+}
+
+TEST(hash_policy, other_policies)
+{
+    auto text = "ACGGCGACGTTTAGTTACGATGCCAGCTAGTACG"_dna4;
+    seqan3::shape const shape = seqan3::ungapped{4};
+
+    // Every modmer is the smaller of both strands and fulfills the modmer condition for the used policy.
+    for (auto && hash : text | modmer_hash(shape, 2, seqan3::seed{default_seed}, minions::murmur_hash_policy{}))
+        EXPECT_EQ(0u, minions::murmur_hash_policy{}(hash, default_seed) % 2);
+
+    // The policy is applied to the k-mer hashes before the minimum is taken.
+    auto expected = text | seqan3::views::kmer_hash(shape)
+                         | std::views::transform([] (uint64_t i)
+                                                 {return minions::splitmix_hash_policy{}(i, default_seed);});
+    uint64_t minimum = std::ranges::min(expected);
+    uint64_t rev_minimum = std::ranges::min(text | seqan3::views::complement
+                                                 | std::views::reverse
+                                                 | seqan3::views::kmer_hash(shape)
+                                                 | std::views::transform([] (uint64_t i)
+                                                                {return minions::splitmix_hash_policy{}(i, default_seed);}));
+    auto result = text | minions::views::minimiser_hash(shape,
+                                                         seqan3::window_size{static_cast<uint32_t>(text.size())},
+                                                         seqan3::seed{default_seed},
+                                                         minions::splitmix_hash_policy{});
+    ASSERT_EQ(1, std::ranges::distance(result));
+    EXPECT_EQ(std::min(minimum, rev_minimum), *result.begin());
+}
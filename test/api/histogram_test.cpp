@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "histogram.hpp"
+
+std::string to_string(minions::histogram const & hist)
+{
+    std::ostringstream stream{};
+    stream << hist;
+    return stream.str();
+}
+
+TEST(histogram, add)
+{
+    minions::histogram hist{};
+    EXPECT_EQ("", to_string(hist));
+
+    for (uint64_t value : {3u, 1u, 3u, 0u})
+        hist.add(value);
+    hist.add(minions::histogram::dense_size + 5, 2);
+    hist.add(minions::histogram::dense_size);
+    EXPECT_EQ("0\t1\n1\t1\n3\t2\n65536\t1\n65541\t2\n", to_string(hist));
+
+    std::vector<std::pair<uint64_t, uint64_t>> visited{};
+    hist.for_each([&] (uint64_t const value, uint64_t const count) { visited.emplace_back(value, count); });
+    EXPECT_EQ((std::vector<std::pair<uint64_t, uint64_t>>{{0, 1}, {1, 1}, {3, 2}, {65536, 1}, {65541, 2}}), visited);
+}
+
+TEST(histogram, merge)
+{
+    minions::histogram expected{};
+    minions::histogram first{};
+    minions::histogram second{};
+    for (uint64_t value = 0; value < 100; ++value)
+    {
+        uint64_t const distance = (value * 7919) % 131;
+        expected.add(distance);
+        (value % 2 ? first : second).add(distance);
+    }
+    first.add(1ULL << 40);
+    expected.add(1ULL << 40);
+
+    minions::histogram merged{first};
+    merged.merge(second);
+    EXPECT_EQ(to_string(expected), to_string(merged));
+
+    // The order of the merges does not matter.
+    minions::histogram reversed{second};
+    reversed.merge(first);
+    EXPECT_EQ(to_string(merged), to_string(reversed));
+}
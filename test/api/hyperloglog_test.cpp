@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include "hyperloglog.hpp"
+
+TEST(hyperloglog, empty)
+{
+    minions::hyperloglog sketch{};
+    EXPECT_EQ(minions::hyperloglog::default_precision, sketch.precision());
+    EXPECT_EQ(4096u, sketch.registers().size());
+    EXPECT_EQ(0.0, sketch.estimate());
+}
+
+TEST(hyperloglog, invalid_precision)
+{
+    EXPECT_THROW(minions::hyperloglog{3}, std::invalid_argument);
+    EXPECT_THROW(minions::hyperloglog{19}, std::invalid_argument);
+}
+
+TEST(hyperloglog, estimate)
+{
+    // Consecutive values, like k-mer hashes, and every value several times.
+    for (uint64_t const distinct : {100u, 5000u, 1000000u})
+    {
+        minions::hyperloglog sketch{};
+        for (size_t repetition = 0; repetition < 3; ++repetition)
+            for (uint64_t hash = 0; hash < distinct; ++hash)
+                sketch.add(hash);
+        EXPECT_LE(std::abs(sketch.estimate() - distinct), 4 * sketch.relative_error() * distinct);
+    }
+}
+
+TEST(hyperloglog, merge)
+{
+    // The merged sketch is the sketch of the union.
+    minions::hyperloglog all{10};
+    minions::hyperloglog first{10};
+    minions::hyperloglog second{10};
+    std::mt19937_64 engine{42};
+    for (size_t i = 0; i < 100000; ++i)
+    {
+        uint64_t const hash = engine();
+        all.add(hash);
+        (i % 3 == 0 ? first : second).add(hash);
+    }
+    first.merge(second);
+    EXPECT_TRUE(std::ranges::equal(all.registers(), first.registers()));
+    EXPECT_EQ(all.estimate(), first.estimate());
+
+    EXPECT_THROW(first.merge(minions::hyperloglog{11}), std::invalid_argument);
+}
+
+TEST(hyperloglog, max_registers)
+{
+    // Sizes that are no multiple of the vector width.
+    std::mt19937 engine{7};
+    std::vector<uint8_t> target(1000);
+    std::vector<uint8_t> source(1000);
+    for (size_t i = 0; i < target.size(); ++i)
+    {
+        target[i] = engine() % 64;
+        source[i] = engine() % 64;
+    }
+
+    std::vector<uint8_t> expected{target};
+    minions::detail::max_registers_scalar(expected.data(), source.data(), 999);
+    for (auto level : {minions::detail::simd_level::scalar,
+                       minions::detail::simd_level::sse4_2,
+                       minions::detail::simd_level::avx2})
+    {
+        if (level > minions::detail::supported_simd_level())
+            continue;
+        std::vector<uint8_t> result{target};
+        minions::detail::max_registers(result.data(), source.data(), 999, level);
+        EXPECT_EQ(expected, result);
+    }
+}
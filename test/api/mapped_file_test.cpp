@@ -0,0 +1,33 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include "mapped_file.hpp"
+
+TEST(mapped_file, content)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "mapped_file.txt";
+    {
+        std::ofstream outfile{path};
+        outfile << "ACGT\n";
+    }
+
+    minions::mapped_file file{path};
+    EXPECT_EQ("ACGT\n", std::string(file.data().begin(), file.data().end()));
+
+    // The mapping is moved with the object.
+    minions::mapped_file moved{std::move(file)};
+    EXPECT_EQ(0u, file.data().size());
+    EXPECT_EQ(5u, moved.data().size());
+    std::filesystem::remove(path);
+}
+
+TEST(mapped_file, empty)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "mapped_file_empty.txt";
+    std::ofstream{path};
+    EXPECT_EQ(0u, minions::mapped_file{path}.data().size());
+    std::filesystem::remove(path);
+
+    EXPECT_THROW(minions::mapped_file{path}, std::runtime_error);
+}
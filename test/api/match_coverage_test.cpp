@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "match_coverage.hpp"
+
+// The islands of a scan over all positions, like `minions match` computed them before.
+std::vector<uint64_t> scan_islands(std::vector<bool> const & positions)
+{
+    std::vector<uint64_t> islands{};
+    uint64_t current_island{0};
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        if (!positions[i])
+        {
+            current_island++;
+        }
+        else if (i > 0)
+        {
+            islands.push_back(current_island);
+            current_island = 0;
+        }
+    }
+    islands.push_back(current_island);
+    return islands;
+}
+
+std::vector<uint64_t> to_vector(minions::histogram const & hist)
+{
+    std::vector<uint64_t> values{};
+    hist.for_each([&] (uint64_t const value, uint64_t const count) { values.insert(values.end(), count, value); });
+    return values;
+}
+
+TEST(match_coverage, example)
+{
+    minions::match_coverage coverage{};
+    coverage.add(2, 5);
+    coverage.add(3, 6);
+    coverage.add(9, 10);
+    coverage.finish(12);
+
+    // Covered: 2, 3, 4, 5, 9.
+    EXPECT_EQ(5u, coverage.covered());
+    EXPECT_EQ(5 * 100.0 / 12, coverage.percentage());
+    EXPECT_EQ((std::vector<uint64_t>{0, 0, 0, 2, 2, 3}), to_vector(coverage.islands()));
+    EXPECT_EQ(0u, coverage.islands().min());
+    EXPECT_EQ(3u, coverage.islands().max());
+}
+
+TEST(match_coverage, empty)
+{
+    minions::match_coverage coverage{};
+    coverage.finish(7);
+    EXPECT_EQ(0u, coverage.covered());
+    EXPECT_EQ((std::vector<uint64_t>{7}), to_vector(coverage.islands()));
+}
+
+TEST(match_coverage, random)
+{
+    std::mt19937_64 engine{3};
+    for (size_t run = 0; run < 100; ++run)
+    {
+        size_t const length = 1 + engine() % 200;
+        uint64_t const match_length = 1 + engine() % 10;
+        std::vector<bool> positions(length, false);
+        minions::match_coverage coverage{};
+
+        for (uint64_t begin = 0; begin < length; ++begin)
+        {
+            if (engine() % 3 != 0)
+                continue;
+            // Intervals may reach behind the sequence.
+            for (uint64_t j = begin; j < std::min<uint64_t>(length, begin + match_length); ++j)
+                positions[j] = true;
+            coverage.add(begin, begin + match_length);
+        }
+        coverage.finish(length);
+
+        std::vector<uint64_t> expected = scan_islands(positions);
+        std::sort(expected.begin(), expected.end());
+        EXPECT_EQ(expected, to_vector(coverage.islands()));
+        EXPECT_EQ(static_cast<uint64_t>(std::count(positions.begin(), positions.end(), true)), coverage.covered());
+    }
+}
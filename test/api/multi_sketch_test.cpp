@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+
+#include "multi_sketch.hpp"
+
+using seqan3::operator""_dna4;
+using seqan3::operator""_shape;
+
+static constexpr seqan3::seed seed{0x8F3F73B5CF1C9ADE};
+
+// Random sequences, including low complexity ones with many equal hashes.
+std::vector<std::vector<seqan3::dna4>> sketch_sequences()
+{
+    std::mt19937_64 engine{42};
+    std::vector<std::vector<seqan3::dna4>> sequences{};
+    for (size_t length : {40u, 97u, 500u})
+    {
+        for (size_t alphabet : {2u, 4u})
+        {
+            std::vector<seqan3::dna4> sequence(length);
+            for (auto & symbol : sequence)
+                seqan3::assign_rank_to(static_cast<uint8_t>(engine() % alphabet), symbol);
+            sequences.push_back(std::move(sequence));
+        }
+    }
+    return sequences;
+}
+
+minions::sketch_spec spec(minions::sketch_method const method, seqan3::shape const shape, uint32_t const window)
+{
+    minions::sketch_spec result{};
+    result.method = method;
+    result.shape = shape;
+    result.window = window;
+    result.seed = seed;
+    return result;
+}
+
+minions::sketch_spec strobemer_spec(minions::strobemer_method const method, uint16_t const order)
+{
+    minions::sketch_spec result = spec(minions::sketch_method::strobemer, seqan3::ungapped{5}, 0);
+    result.strobemer = method;
+    result.order = order;
+    result.window_min = 2;
+    result.window_max = 9;
+    return result;
+}
+
+TEST(multi_sketch, same_values_as_batch_functions)
+{
+    using minions::sketch_method;
+    using minions::strobemer_method;
+
+    minions::sketch_spec syncmer = spec(sketch_method::syncmer, seqan3::ungapped{5}, 2);
+    syncmer.positions = {0, 3};
+    minions::multi_sketch sketch{{spec(sketch_method::kmer, seqan3::ungapped{5}, 0),
+                                  spec(sketch_method::minimiser, seqan3::ungapped{5}, 8),
+                                  spec(sketch_method::minimiser, 0b1101_shape, 20),
+                                  spec(sketch_method::modmer, seqan3::ungapped{5}, 3),
+                                  syncmer,
+                                  strobemer_spec(strobemer_method::randstrobe, 2),
+                                  strobemer_spec(strobemer_method::minstrobe, 3),
+                                  strobemer_spec(strobemer_method::hybridstrobe, 2)}};
+    ASSERT_EQ(8u, sketch.size());
+    EXPECT_EQ(sketch_method::syncmer, sketch[4].method);
+
+    for (auto & sequence : sketch_sequences())
+    {
+        std::vector<std::vector<uint64_t>> values(sketch.size());
+        sketch(sequence, [&] (size_t const index, uint64_t const hash) { values[index].push_back(hash); });
+
+        std::vector<minions::batch_buffer> expected(sketch.size());
+        minions::kmer_batch(sequence, seqan3::ungapped{5}, expected[0]);
+        minions::minimiser_batch(sequence, seqan3::ungapped{5}, seqan3::window_size{8}, seed, expected[1]);
+        minions::minimiser_batch(sequence, 0b1101_shape, seqan3::window_size{20}, seed, expected[2]);
+        minions::modmer_batch(sequence, seqan3::ungapped{5}, 3, seed, expected[3]);
+        minions::syncmer_batch(sequence, 2, 5, std::vector<int>{0, 3}, seed, expected[4]);
+        minions::strobemer_batch<strobemer_method::randstrobe, 2>(sequence, seqan3::ungapped{5}, 2, 9, seed,
+                                                                  expected[5]);
+        minions::strobemer_batch<strobemer_method::minstrobe, 3>(sequence, seqan3::ungapped{5}, 2, 9, seed,
+                                                                 expected[6]);
+        minions::strobemer_batch<strobemer_method::hybridstrobe, 2>(sequence, seqan3::ungapped{5}, 2, 9, seed,
+                                                                    expected[7]);
+
+        for (size_t i = 0; i < sketch.size(); ++i)
+        {
+            EXPECT_FALSE(values[i].empty());
+            EXPECT_EQ(expected[i].hashes, values[i]);
+        }
+    }
+}
+
+TEST(multi_sketch, max_shapes)
+{
+    using minions::sketch_method;
+
+    // Seven distinct shapes, the syncmers need two of them.
+    minions::sketch_spec syncmer = spec(sketch_method::syncmer, seqan3::ungapped{6}, 2);
+    syncmer.positions = {0, 3};
+    std::vector<minions::sketch_spec> specs{spec(sketch_method::kmer, seqan3::ungapped{4}, 0),
+                                            spec(sketch_method::minimiser, seqan3::ungapped{5}, 8),
+                                            spec(sketch_method::minimiser, 0b1101_shape, 20),
+                                            syncmer,
+                                            spec(sketch_method::modmer, seqan3::ungapped{4}, 3),
+                                            spec(sketch_method::kmer, seqan3::ungapped{7}, 0),
+                                            strobemer_spec(minions::strobemer_method::randstrobe, 2)};
+
+    minions::multi_sketch all{specs, 7};
+    for (size_t const max_shapes : {2u, 3u, 4u})
+    {
+        minions::multi_sketch sketch{specs, max_shapes};
+        for (auto & sequence : sketch_sequences())
+        {
+            std::vector<std::pair<size_t, uint64_t>> expected{};
+            std::vector<std::pair<size_t, uint64_t>> values{};
+            all(sequence, [&] (size_t const index, uint64_t const hash) { expected.emplace_back(index, hash); });
+            sketch(sequence, [&] (size_t const index, uint64_t const hash) { values.emplace_back(index, hash); });
+            EXPECT_EQ(expected, values);
+        }
+    }
+
+    EXPECT_THROW(minions::multi_sketch(specs, 1), std::invalid_argument);
+}
+
+TEST(multi_sketch, copies)
+{
+    minions::multi_sketch sketch{{spec(minions::sketch_method::minimiser, seqan3::ungapped{4}, 6)}};
+    minions::multi_sketch copy{sketch};
+
+    std::vector<uint64_t> values{};
+    std::vector<uint64_t> copy_values{};
+    sketch("ACGTTGCAACGGTACCA"_dna4, [&] (size_t, uint64_t const hash) { values.push_back(hash); });
+    copy("ACGTTGCAACGGTACCA"_dna4, [&] (size_t, uint64_t const hash) { copy_values.push_back(hash); });
+    EXPECT_FALSE(values.empty());
+    EXPECT_EQ(values, copy_values);
+}
+
+TEST(multi_sketch, invalid)
+{
+    using minions::sketch_method;
+    EXPECT_THROW(minions::multi_sketch({spec(sketch_method::minimiser, seqan3::ungapped{5}, 4)}),
+                 std::invalid_argument);
+    EXPECT_THROW(minions::multi_sketch({spec(sketch_method::modmer, seqan3::ungapped{5}, 0)}), std::invalid_argument);
+    EXPECT_THROW(minions::multi_sketch({spec(sketch_method::syncmer, seqan3::ungapped{5}, 5)}), std::invalid_argument);
+
+    minions::sketch_spec strobemer = strobemer_spec(minions::strobemer_method::randstrobe, 4);
+    EXPECT_THROW(minions::multi_sketch({strobemer}), std::invalid_argument);
+    strobemer.order = 2;
+    strobemer.window_max = 1;
+    EXPECT_THROW(minions::multi_sketch({strobemer}), std::invalid_argument);
+
+    minions::multi_sketch sketch{{spec(sketch_method::syncmer, seqan3::ungapped{5}, 2)}};
+    EXPECT_THROW(sketch("ACG"_dna4, [] (size_t, uint64_t) {}), std::invalid_argument);
+}
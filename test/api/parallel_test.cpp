@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <future>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel.hpp"
+
+TEST(parallel_for, all_items)
+{
+    for (size_t threads : {1u, 4u})
+    {
+        std::vector<size_t> items(1000);
+        minions::parallel_for(items.size(), threads, [&] (size_t const i) { items[i] = i; });
+
+        std::vector<size_t> expected(1000);
+        std::iota(expected.begin(), expected.end(), 0u);
+        EXPECT_EQ(expected, items);
+    }
+}
+
+TEST(parallel_for, exception)
+{
+    EXPECT_THROW(minions::parallel_for(100, 4, [] (size_t const i)
+                 {
+                     if (i == 42)
+                         throw std::runtime_error{"42"};
+                 }),
+                 std::runtime_error);
+}
+
+TEST(parallel_sort, sorted)
+{
+    std::mt19937_64 engine{42};
+    for (size_t size : {0u, 1u, 5000u, 100000u})
+    {
+        std::vector<uint64_t> values(size);
+        for (auto & value : values)
+            value = engine() % 1000;
+        std::vector<uint64_t> expected{values};
+        std::ranges::sort(expected);
+
+        for (size_t threads : {1u, 3u, 8u})
+        {
+            std::vector<uint64_t> sorted{values};
+            minions::parallel_sort(std::span{sorted}, threads);
+            EXPECT_EQ(expected, sorted);
+        }
+    }
+}
+
+TEST(bounded_queue, order)
+{
+    minions::bounded_queue<size_t> queue{2};
+    std::future<void> producer = std::async(std::launch::async, [&] ()
+    {
+        for (size_t i = 0; i < 100; ++i)
+            EXPECT_TRUE(queue.push(i));
+        queue.close();
+    });
+
+    std::vector<size_t> values{};
+    while (std::optional<size_t> value = queue.pop())
+        values.push_back(*value);
+    producer.get();
+
+    std::vector<size_t> expected(100);
+    std::iota(expected.begin(), expected.end(), 0u);
+    EXPECT_EQ(expected, values);
+}
+
+TEST(bounded_queue, close)
+{
+    minions::bounded_queue<int> queue{1};
+    EXPECT_TRUE(queue.push(1));
+
+    // A producer waiting for a full queue is released by close().
+    std::future<bool> producer = std::async(std::launch::async, [&] () { return queue.push(2); });
+    queue.close();
+    EXPECT_FALSE(producer.get());
+
+    // Remaining values are still returned.
+    EXPECT_EQ(std::optional<int>{1}, queue.pop());
+    EXPECT_EQ(std::nullopt, queue.pop());
+    EXPECT_FALSE(queue.push(3));
+}
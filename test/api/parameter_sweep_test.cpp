@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+
+#include "parameter_sweep.hpp"
+
+using values_t = std::vector<uint64_t>;
+
+TEST(parameter_sweep, single_value)
+{
+    EXPECT_EQ((values_t{19}), minions::parse_sweep("19"));
+    EXPECT_EQ((values_t{0}), minions::parse_sweep("0"));
+}
+
+TEST(parameter_sweep, list)
+{
+    EXPECT_EQ((values_t{15, 19, 21}), minions::parse_sweep("15,19,21"));
+    EXPECT_EQ((values_t{21, 15, 21}), minions::parse_sweep("21,15,21"));
+}
+
+TEST(parameter_sweep, range)
+{
+    EXPECT_EQ((values_t{15, 16, 17}), minions::parse_sweep("15-17"));
+    EXPECT_EQ((values_t{15, 17, 19, 21}), minions::parse_sweep("15-21:2"));
+    EXPECT_EQ((values_t{15, 18, 21}), minions::parse_sweep("15-22:3"));
+    EXPECT_EQ((values_t{15}), minions::parse_sweep("15-15"));
+    EXPECT_EQ((values_t{15}), minions::parse_sweep("15-20:10"));
+    EXPECT_EQ((values_t{0, 5, 10, 25, 31}), minions::parse_sweep("0-10:5,25,31"));
+    EXPECT_EQ((values_t{18446744073709551614ULL, 18446744073709551615ULL}),
+              minions::parse_sweep("18446744073709551614-18446744073709551615"));
+}
+
+TEST(parameter_sweep, invalid)
+{
+    for (std::string_view value : {"", "a", "19,", ",19", "1.5", "-3", "5-", "5-3", "5-9:0", "5-9:", "5:2", "19 "})
+        EXPECT_THROW(minions::parse_sweep(value), std::invalid_argument);
+}
+
+TEST(parameter_sweep, product)
+{
+    std::vector<std::vector<uint64_t>> const expected{{15, 20, 0}, {15, 25, 0}, {19, 20, 0}, {19, 25, 0}};
+    EXPECT_EQ(expected, minions::sweep_product({{15, 19}, {20, 25}, {0}}));
+    EXPECT_EQ((std::vector<std::vector<uint64_t>>{{}}), minions::sweep_product({}));
+    EXPECT_TRUE(minions::sweep_product({{15, 19}, {}}).empty());
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <thread>
+
+#include "partitioned_count_table.hpp"
+
+std::filesystem::path temporary_file(std::string const & name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+//!\brief Reads a count file into vectors.
+std::pair<std::vector<uint64_t>, std::vector<uint16_t>> read_counts(std::filesystem::path const & path)
+{
+    minions::count_file_reader const reader{path};
+    return {{reader.hashes().begin(), reader.hashes().end()}, {reader.counts().begin(), reader.counts().end()}};
+}
+
+//!\brief Counts the hash values in memory and with a partitioned_count_table and compares the files.
+void expect_same_as_in_memory(std::vector<uint64_t> const & hashes, size_t const max_memory)
+{
+    minions::flat_count_table table{};
+    for (uint64_t const hash : hashes)
+        table.add(hash);
+    std::filesystem::path const expected_path = temporary_file("partitioned_count_table_expected.out");
+    minions::write_count_file(expected_path, {}, table);
+
+    std::filesystem::path const path = temporary_file("partitioned_count_table.out");
+    {
+        minions::partitioned_count_table partitioned{std::filesystem::temp_directory_path(), max_memory, 16u};
+        minions::partitioned_count_table::local_buffer_type local = partitioned.local_buffer();
+        for (uint64_t const hash : hashes)
+            partitioned.add(local, hash);
+        partitioned.flush(local);
+        EXPECT_EQ(table.size(), partitioned.write(path, {}));
+        EXPECT_LE(partitioned.largest_table_capacity(), partitioned.table_capacity());
+    }
+
+    EXPECT_EQ(read_counts(expected_path), read_counts(path));
+    std::filesystem::remove(expected_path);
+    std::filesystem::remove(path);
+}
+
+TEST(partitioned_count_table, small)
+{
+    expect_same_as_in_memory({42, 7, 42, 0, 1ULL << 63, 7, 42}, 1ULL << 20);
+}
+
+TEST(partitioned_count_table, empty)
+{
+    expect_same_as_in_memory({}, 1ULL << 20);
+}
+
+TEST(partitioned_count_table, split)
+{
+    // The minimal table of 1024 slots holds 768 hash values, the buckets are split twice and the runs do not fit
+    // into one merge.
+    std::mt19937_64 engine{42};
+    std::vector<uint64_t> hashes(1000000);
+    for (uint64_t & hash : hashes)
+        hash = engine() % 500000;
+    expect_same_as_in_memory(hashes, 0u);
+}
+
+TEST(partitioned_count_table, full_table)
+{
+    // Every hash value occurs twice in a row, so a full table sees a hash value again before the bucket is split.
+    std::vector<uint64_t> hashes{};
+    for (uint64_t hash = 0; hash < 20000; ++hash)
+        hashes.insert(hashes.end(), 2, hash);
+
+    minions::partitioned_count_table partitioned{std::filesystem::temp_directory_path(), 0u, 1u};
+    minions::partitioned_count_table::local_buffer_type local = partitioned.local_buffer();
+    for (uint64_t const hash : hashes)
+        partitioned.add(local, hash);
+    partitioned.flush(local);
+
+    std::filesystem::path const path = temporary_file("partitioned_count_table_full.out");
+    EXPECT_EQ(20000u, partitioned.write(path, {}));
+    EXPECT_EQ(partitioned.table_capacity(), partitioned.largest_table_capacity());
+    std::filesystem::remove(path);
+}
+
+TEST(partitioned_count_table, saturates)
+{
+    // A single hash value cannot be split.
+    expect_same_as_in_memory(std::vector<uint64_t>(70000, 5u), 0u);
+}
+
+TEST(partitioned_count_table, threads)
+{
+    std::filesystem::path const path = temporary_file("partitioned_count_table_threads.out");
+    {
+        minions::partitioned_count_table partitioned{std::filesystem::temp_directory_path(), 0u};
+        std::vector<std::thread> threads{};
+        for (size_t t = 0; t < 4; ++t)
+            threads.emplace_back([&partitioned] ()
+            {
+                minions::partitioned_count_table::local_buffer_type local = partitioned.local_buffer();
+                for (uint64_t hash = 0; hash < 10000; ++hash)
+                    partitioned.add(local, hash);
+                partitioned.flush(local);
+            });
+        for (std::thread & thread : threads)
+            thread.join();
+        EXPECT_EQ(10000u, partitioned.write(path, {}));
+    }
+
+    auto const [hashes, counts] = read_counts(path);
+    ASSERT_EQ(10000u, hashes.size());
+    EXPECT_TRUE(std::ranges::is_sorted(hashes));
+    EXPECT_TRUE(std::ranges::all_of(counts, [] (uint16_t const count) { return count == 4u; }));
+    std::filesystem::remove(path);
+}
+
+TEST(partitioned_count_table, removes_temporary_files)
+{
+    std::filesystem::path const directory = temporary_file("partitioned_count_table_directory");
+    std::filesystem::create_directories(directory);
+    {
+        minions::partitioned_count_table partitioned{directory, 0u};
+        minions::partitioned_count_table::local_buffer_type local = partitioned.local_buffer();
+        partitioned.add(local, 1);
+        partitioned.flush(local);
+        EXPECT_FALSE(std::filesystem::is_empty(directory));
+    }
+    EXPECT_TRUE(std::filesystem::is_empty(directory));
+    std::filesystem::remove(directory);
+}
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "perf_counters.hpp"
+
+// Hardware counters are often not available, e.g. in containers, so only the consistency is checked.
+TEST(perf_counters, values)
+{
+    minions::perf_counters counters{};
+
+    counters.start();
+    std::vector<uint64_t> values(100'000);
+    for (size_t i = 0; i < values.size(); ++i)
+        values[i] = i * i;
+    counters.stop();
+    EXPECT_EQ(99'999ULL * 99'999ULL, values.back());
+
+    bool any{false};
+    for (size_t e = 0; e < minions::perf_counters::event_count; ++e)
+    {
+        auto const event = static_cast<minions::perf_counters::event>(e);
+        EXPECT_EQ(counters.available(event), counters.value(event).has_value());
+        any = any || counters.available(event);
+    }
+    EXPECT_EQ(any, counters.any_available());
+
+    if (counters.available(minions::perf_counters::instructions))
+        EXPECT_TRUE(*counters.value(minions::perf_counters::instructions) > 0);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/std/algorithm>
+
+#include "batch.hpp"
+#include "minions_minimiser.hpp"
+#include "minions_minimiser_hash.hpp"
+#include "modmer.hpp"
+#include "modmer_hash.hpp"
+#include "position_view.hpp"
+#include "randstrobe_hash.hpp"
+#include "syncmer_hash.hpp"
+
+using seqan3::operator""_dna4;
+using seqan3::operator""_shape;
+
+static constexpr seqan3::seed seed{0x8F3F73B5CF1C9ADE};
+
+// A random sequence over two symbols, so equal hashes occur more than once.
+std::vector<seqan3::dna4> low_complexity_sequence()
+{
+    std::mt19937_64 engine{42};
+    std::vector<seqan3::dna4> sequence(300);
+    for (auto & symbol : sequence)
+        seqan3::assign_rank_to(static_cast<uint8_t>(engine() % 2), symbol);
+    return sequence;
+}
+
+// Splits the output of minions::views::with_position and compares it to the hashes and positions of a batch function.
+template <typename view_t>
+void compare(view_t && view, minions::batch_buffer const & expected)
+{
+    std::vector<uint64_t> hashes{};
+    std::vector<size_t> positions{};
+    for (auto && [hash, position] : view | minions::views::with_position)
+    {
+        hashes.push_back(hash);
+        positions.push_back(position);
+    }
+
+    EXPECT_EQ(expected.hashes, hashes);
+    EXPECT_EQ(expected.positions, positions);
+}
+
+TEST(position_view, minimiser_hash)
+{
+    auto sequence = low_complexity_sequence();
+    minions::batch_buffer buffer{};
+    buffer.store_positions = true;
+    for (seqan3::shape shape : {seqan3::shape{seqan3::ungapped{5}}, 0b1101_shape})
+    {
+        buffer.clear();
+        minions::minimiser_batch(sequence, shape, seqan3::window_size{8}, seed, buffer);
+        compare(sequence | minions::views::minimiser_hash(shape, seqan3::window_size{8}, seed), buffer);
+    }
+}
+
+TEST(position_view, modmer_hash)
+{
+    auto sequence = low_complexity_sequence();
+    minions::batch_buffer buffer{};
+    buffer.store_positions = true;
+    minions::modmer_batch(sequence, seqan3::ungapped{5}, 3, seed, buffer);
+    compare(sequence | modmer_hash(seqan3::ungapped{5}, 3, seed), buffer);
+}
+
+TEST(position_view, syncmer_hash)
+{
+    auto sequence = low_complexity_sequence();
+    minions::batch_buffer buffer{};
+    buffer.store_positions = true;
+    minions::syncmer_batch(sequence, 2, 10, {0}, seed, buffer);
+    compare(sequence | syncmer_hash(2, 10, std::vector<int>{0}, seed), buffer);
+}
+
+TEST(position_view, randstrobe_hash)
+{
+    auto sequence = low_complexity_sequence();
+    minions::batch_buffer buffer{};
+    buffer.store_positions = true;
+    minions::strobemer_batch<minions::strobemer_method::randstrobe, 2>(sequence, seqan3::ungapped{4}, 2, 6, seed,
+                                                                       buffer);
+    compare(sequence | randstrobe2_hash(seqan3::ungapped{4}, 2, 6, seed), buffer);
+}
+
+TEST(position_view, of_strobemers)
+{
+    // Positions of representatives of strobemers are positions in the strobemers.
+    std::vector<uint64_t> strobemers{};
+    std::ranges::copy(low_complexity_sequence() | randstrobe2_hash(seqan3::ungapped{4}, 2, 6, seed),
+                      std::back_inserter(strobemers));
+
+    for (auto && [hash, position] : strobemers | minions::views::minimiser(5) | minions::views::with_position)
+        EXPECT_EQ(strobemers[position], hash);
+    for (auto && [hash, position] : strobemers | modmer(3) | minions::views::with_position)
+        EXPECT_EQ(strobemers[position], hash);
+}
+
+TEST(position_view, empty)
+{
+    auto sequence = "ACG"_dna4;
+    auto view = sequence | minions::views::minimiser_hash(seqan3::ungapped{4}, seqan3::window_size{4}, seed)
+                         | minions::views::with_position;
+    EXPECT_TRUE(std::ranges::begin(view) == std::ranges::end(view));
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <zlib.h>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+
+#include "sequence_reader.hpp"
+
+using seqan3::operator""_dna4;
+
+std::filesystem::path write_sequence_file(std::string const & name, std::string const & content)
+{
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / name;
+    std::ofstream outfile{path, std::ios::binary};
+    outfile << content;
+    return path;
+}
+
+std::vector<seqan3::dna4> to_vector(std::span<seqan3::dna4 const> const sequence)
+{
+    return {sequence.begin(), sequence.end()};
+}
+
+TEST(sequence_reader, fasta)
+{
+    std::filesystem::path const path = write_sequence_file("sequence_reader.fasta",
+                                                           "\n>seq1 first\nACGTN\nacgtu\n\n>seq2\r\nGGCC\r\n>empty\n");
+    EXPECT_TRUE(minions::sequence_reader::can_read(path));
+
+    minions::sequence_reader reader{path};
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ("seq1 first", reader.id());
+    EXPECT_EQ(10u, reader.size());
+    EXPECT_EQ("ACGTAACGTT"_dna4, to_vector(reader.sequence()));
+    EXPECT_EQ("ACGTNacgtu", reader.text());
+
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ("seq2", reader.id());
+    EXPECT_EQ("GGCC", reader.text());
+    EXPECT_EQ("GGCC"_dna4, to_vector(reader.sequence()));
+
+    // The reader can be moved between records.
+    minions::sequence_reader moved{std::move(reader)};
+    ASSERT_TRUE(moved.next());
+    EXPECT_EQ("empty", moved.id());
+    EXPECT_EQ(0u, moved.sequence().size());
+    EXPECT_FALSE(moved.next());
+    EXPECT_FALSE(moved.next());
+    std::filesystem::remove(path);
+}
+
+TEST(sequence_reader, fastq)
+{
+    // The quality of the first record starts with @ and the one of the second record spans two lines.
+    std::filesystem::path const path = write_sequence_file("sequence_reader.fastq",
+                                                           "@read1\nACGT\n+\n@@@@\n@read2\nTTGCA\nAC\n+read2\n"
+                                                           "!!!!\n!!!\n");
+    minions::sequence_reader reader{path};
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ("read1", reader.id());
+    EXPECT_EQ("ACGT"_dna4, to_vector(reader.sequence()));
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ("read2", reader.id());
+    EXPECT_EQ("TTGCAAC"_dna4, to_vector(reader.sequence()));
+    EXPECT_FALSE(reader.next());
+    std::filesystem::remove(path);
+}
+
+TEST(sequence_reader, gzip)
+{
+    // Enough records for several decompressed chunks, so records span the end of chunks.
+    std::string content{};
+    for (size_t record = 0; record < 3000; ++record)
+    {
+        content += "@read" + std::to_string(record) + "\n";
+        std::string const sequence(record % 7 == 0 ? 20000 : 1000, "ACGT"[record % 4]);
+        content += sequence + "\n+\n" + std::string(sequence.size(), '!') + "\n";
+    }
+    std::filesystem::path const path = std::filesystem::temp_directory_path() / "sequence_reader.fastq.gz";
+    gzFile outfile = gzopen(path.c_str(), "wb");
+    gzwrite(outfile, content.data(), content.size());
+    gzclose(outfile);
+    ASSERT_TRUE(content.size() > 2 * minions::gzip_input::chunk_size);
+    EXPECT_TRUE(minions::sequence_reader::can_read(path));
+
+    minions::sequence_reader reader{path};
+    size_t records{0};
+    while (reader.next())
+    {
+        EXPECT_EQ("read" + std::to_string(records), reader.id());
+        EXPECT_EQ(std::string(records % 7 == 0 ? 20000 : 1000, "ACGT"[records % 4]), reader.text());
+        ++records;
+    }
+    EXPECT_EQ(3000u, records);
+    std::filesystem::remove(path);
+}
+
+TEST(sequence_reader, skipped_characters)
+{
+    // Whitespace is skipped, digits are skipped in FASTA files, like seqan3::sequence_file_input does.
+    std::filesystem::path const path = write_sequence_file("sequence_reader_skipped.fasta",
+                                                           ">seq1\nACGT \t\nAC GT\r\n  \n>seq2\n10 ACGT 60 ACGT\n");
+    minions::sequence_reader reader{path};
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(8u, reader.size());
+    EXPECT_EQ("ACGTACGT"_dna4, to_vector(reader.sequence()));
+    EXPECT_EQ("ACGTACGT", reader.text());
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ("ACGTACGT"_dna4, to_vector(reader.sequence()));
+    EXPECT_FALSE(reader.next());
+
+    write_sequence_file("sequence_reader_skipped.fasta", "@read\nACGT \n+\n!!!!\t\n");
+    minions::sequence_reader fastq_reader{path};
+    ASSERT_TRUE(fastq_reader.next());
+    EXPECT_EQ("ACGT"_dna4, to_vector(fastq_reader.sequence()));
+    std::filesystem::remove(path);
+}
+
+TEST(sequence_reader, empty)
+{
+    std::filesystem::path const path = write_sequence_file("sequence_reader_empty.fasta", "");
+    minions::sequence_reader reader{path};
+    EXPECT_FALSE(reader.next());
+    std::filesystem::remove(path);
+}
+
+TEST(sequence_reader, invalid)
+{
+    std::filesystem::path const path = write_sequence_file("sequence_reader_invalid.fasta", "ACGT\n");
+    EXPECT_THROW(minions::sequence_reader{path}, std::invalid_argument);
+
+    write_sequence_file("sequence_reader_invalid.fasta", "@read\nACGT\n+\n!!!\n");
+    minions::sequence_reader reader{path};
+    EXPECT_THROW(reader.next(), std::invalid_argument);
+
+    // Characters, that are not IUPAC codes, and digits in FASTQ files are rejected.
+    for (std::string const content : {">seq\nACXT\n", ">seq\nAC-T\n", ">seq\nACT*\n", "@read\nAC1T\n+\n!!!!\n"})
+    {
+        write_sequence_file("sequence_reader_invalid.fasta", content);
+        minions::sequence_reader invalid_reader{path};
+        EXPECT_THROW(invalid_reader.next(), std::invalid_argument);
+    }
+    write_sequence_file("sequence_reader_invalid.fasta", ">seq\nNRYSWKMBDHVnrysw\n");
+    minions::sequence_reader iupac_reader{path};
+    ASSERT_TRUE(iupac_reader.next());
+    EXPECT_EQ(16u, iupac_reader.size());
+
+    // Truncated gzip files are reported, bzip2 files cannot be read.
+    write_sequence_file("sequence_reader_invalid.fasta", std::string{"\x1F\x8B\x08\x00", 4});
+    EXPECT_TRUE(minions::sequence_reader::can_read(path));
+    EXPECT_THROW(minions::sequence_reader{path}, std::runtime_error);
+    write_sequence_file("sequence_reader_invalid.fasta", "BZh9");
+    EXPECT_FALSE(minions::sequence_reader::can_read(path));
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(minions::sequence_reader::can_read(path));
+    EXPECT_THROW(minions::sequence_reader{path}, std::runtime_error);
+}
+
+TEST(sequence_reader, ascii_to_rank)
+{
+    std::string characters{};
+    for (size_t repetition = 0; repetition < 3; ++repetition)
+        for (int character = 0; character < 256; ++character)
+            characters.push_back(static_cast<char>(character));
+
+    std::vector<uint8_t> expected(characters.size());
+    for (size_t i = 0; i < characters.size(); ++i)
+    {
+        seqan3::dna4 symbol{};
+        symbol.assign_char(characters[i]);
+        expected[i] = symbol.to_rank();
+    }
+
+    for (auto level : {minions::detail::simd_level::scalar,
+                       minions::detail::simd_level::sse4_2,
+                       minions::detail::simd_level::avx2})
+    {
+        if (level > minions::detail::supported_simd_level())
+            continue;
+        // Sizes that are no multiple of the vector size are completed by the scalar kernel.
+        for (size_t size : {0u, 7u, 31u, 100u, 768u})
+        {
+            std::vector<uint8_t> ranks(size);
+            minions::detail::ascii_to_rank(characters.data(), size, ranks.data(), level);
+            EXPECT_EQ(std::vector<uint8_t>(expected.begin(), expected.begin() + size), ranks);
+        }
+    }
+}
+
+TEST(sequence_reader, find_non_base)
+{
+    for (auto level : {minions::detail::simd_level::scalar,
+                       minions::detail::simd_level::sse4_2,
+                       minions::detail::simd_level::avx2})
+    {
+        if (level > minions::detail::supported_simd_level())
+            continue;
+        // Every character is placed behind a run of bases, that is no multiple of the vector size.
+        for (int character = 0; character < 256; ++character)
+        {
+            std::string const line = std::string(37, 'a') + static_cast<char>(character) + "ACGT";
+            bool const base = minions::detail::sequence_character_table[character] ==
+                              minions::detail::sequence_character::base;
+            EXPECT_EQ(base ? line.size() : 37u, minions::detail::find_non_base(line.data(), line.size(), level));
+        }
+        EXPECT_EQ(0u, minions::detail::find_non_base(nullptr, 0, level));
+    }
+}
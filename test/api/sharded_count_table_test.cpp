@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <thread>
+
+#include "sharded_count_table.hpp"
+
+std::filesystem::path temporary_file(std::string const & name)
+{
+    return std::filesystem::temp_directory_path() / name;
+}
+
+//!\brief Reads a count file into vectors.
+std::pair<std::vector<uint64_t>, std::vector<uint16_t>> read_counts(std::filesystem::path const & path)
+{
+    minions::count_file_reader const reader{path};
+    return {{reader.hashes().begin(), reader.hashes().end()}, {reader.counts().begin(), reader.counts().end()}};
+}
+
+//!\brief Counts the hash values in one table and with a sharded_count_table from several threads and compares the files.
+void expect_same_as_one_table(std::vector<uint64_t> const & hashes, size_t const threads)
+{
+    minions::flat_count_table table{};
+    for (uint64_t const hash : hashes)
+        table.add(hash);
+    std::filesystem::path const expected_path = temporary_file("sharded_count_table_expected.out");
+    minions::write_count_file(expected_path, {}, table);
+
+    std::filesystem::path const path = temporary_file("sharded_count_table.out");
+    minions::sharded_count_table sharded{16u};
+    {
+        // Every thread merges several local tables.
+        std::vector<std::thread> workers{};
+        for (size_t t = 0; t < threads; ++t)
+            workers.emplace_back([&, t] ()
+            {
+                minions::sharded_count_table::local_table_type local{};
+                for (size_t i = t; i < hashes.size(); i += threads)
+                {
+                    local.add(hashes[i]);
+                    if (local.size() == 1000)
+                        sharded.merge(std::exchange(local, minions::sharded_count_table::local_table_type{}));
+                }
+                sharded.merge(local);
+            });
+        for (std::thread & worker : workers)
+            worker.join();
+    }
+    EXPECT_EQ(table.size(), sharded.size());
+    EXPECT_EQ(table.size(), sharded.write(path, {}));
+    EXPECT_EQ(0u, sharded.size());
+
+    EXPECT_EQ(read_counts(expected_path), read_counts(path));
+    std::filesystem::remove(expected_path);
+    std::filesystem::remove(path);
+}
+
+TEST(sharded_count_table, small)
+{
+    expect_same_as_one_table({42, 7, 42, 0, 1ULL << 63, 7, 42}, 2u);
+}
+
+TEST(sharded_count_table, empty)
+{
+    expect_same_as_one_table({}, 2u);
+}
+
+TEST(sharded_count_table, threads)
+{
+    std::mt19937_64 engine{42};
+    std::vector<uint64_t> hashes(1000000);
+    for (uint64_t & hash : hashes)
+        hash = engine() % 500000;
+    // Some hash values saturate.
+    hashes.insert(hashes.end(), 70000, 3u);
+    expect_same_as_one_table(hashes, 4u);
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <span>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/std/algorithm>
+#include <seqan3/search/views/kmer_hash.hpp>
+
+#include "syncmer_classifier.hpp"
+
+using seqan3::operator""_dna4;
+
+// The former syncmer_filter, which decodes the k-mer into a sequence and hashes its s-mers.
+bool decoding_filter(uint64_t seq, uint64_t smer, uint64_t kmer, std::vector<int> const & positions, uint64_t seed)
+{
+    seq = seq ^ seed;
+    std::deque<seqan3::dna4> text{};
+    while (seq > 4)
+    {
+        text.push_front(seqan3::assign_rank_to(static_cast<uint8_t>(seq % 4), seqan3::dna4{}));
+        seq = seq / 4;
+    }
+    text.push_front(seqan3::assign_rank_to(static_cast<uint8_t>(seq % 4), seqan3::dna4{}));
+
+    while (text.size() < kmer)
+        text.push_front('A'_dna4);
+
+    size_t min_pos{};
+    uint64_t min = std::numeric_limits<uint64_t>::max();
+    size_t i{0};
+    for (auto && hash : text | seqan3::views::kmer_hash(seqan3::ungapped{static_cast<uint8_t>(smer)}))
+    {
+        if (hash < min)
+        {
+            min = hash;
+            min_pos = i;
+        }
+        ++i;
+    }
+
+    return std::find(positions.begin(), positions.end(), min_pos) != positions.end();
+}
+
+TEST(syncmer_classifier, small_example)
+{
+    // k = 4, s = 2, i.e. the k-mer has three 2-mers.
+    minions::syncmer_classifier classifier{2, 4, {0}, 0};
+    uint64_t const acgg{0b00011010}; // AC CG GG
+    EXPECT_EQ(0u, classifier.smallest_smer(acgg));
+    EXPECT_TRUE(classifier(acgg));
+
+    uint64_t const ggca{0b10100100}; // GG GC CA
+    EXPECT_EQ(2u, classifier.smallest_smer(ggca));
+    EXPECT_FALSE(classifier(ggca));
+    EXPECT_TRUE((minions::syncmer_classifier{2, 4, {1, 2}, 0}(ggca)));
+
+    // The first of several smallest s-mers is used.
+    uint64_t const acac{0b00010001}; // AC CA AC
+    EXPECT_EQ(0u, classifier.smallest_smer(acac));
+
+    // The seed is removed before the s-mers are compared.
+    EXPECT_EQ(2u, (minions::syncmer_classifier{2, 4, {0}, 0b11}.smallest_smer(ggca ^ 0b11)));
+}
+
+TEST(syncmer_classifier, same_as_decoding)
+{
+    std::mt19937_64 engine{42};
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        uint64_t const kmer = 2 + engine() % 30;
+        uint64_t const smer = 1 + engine() % (kmer - 1);
+        std::vector<int> positions{static_cast<int>(engine() % (kmer - smer + 1)),
+                                   static_cast<int>(engine() % (kmer - smer + 1))};
+        uint64_t const seed = engine() >> (64 - 2 * kmer);
+        // Values starting with the digits "10" are decoded differently, so these are tested more often.
+        uint64_t const hash = (i % 2) ? (engine() >> (64 - 2 * kmer)) : ((4ULL << (2 * (engine() % (kmer - 1)))) ^ seed);
+
+        minions::syncmer_classifier classifier{smer, kmer, positions, seed};
+        EXPECT_EQ(decoding_filter(hash, smer, kmer, positions, seed), classifier(hash));
+    }
+}
+
+TEST(syncmer_classifier, batch)
+{
+    std::mt19937_64 engine{7};
+    std::vector<uint64_t> hashes(1000);
+    std::ranges::generate(hashes, [&engine] () { return engine() >> (64 - 2 * 12); });
+
+    minions::syncmer_classifier classifier{4, 12, {0, 8}, 0x3F73B5};
+
+    std::vector<uint64_t> expected{};
+    for (uint64_t hash : hashes)
+        if (classifier(hash))
+            expected.push_back(hash);
+
+    auto is_syncmer = std::make_unique<bool[]>(hashes.size());
+    EXPECT_EQ(expected.size(), classifier.classify(hashes, std::span<bool>{is_syncmer.get(), hashes.size()}));
+    for (size_t i = 0; i < hashes.size(); ++i)
+        EXPECT_EQ(classifier(hashes[i]), is_syncmer[i]);
+
+    // Selecting in place.
+    hashes.resize(classifier.select(hashes, hashes));
+    EXPECT_EQ(expected, hashes);
+}
@@ -159,8 +159,8 @@ TEST_F(syncmer_test, filter)
     auto filter2 = [](uint64_t i) { return syncmer_filter(i, 2, 8, {0}, 0);};
     std::vector<seqan3::dna4> text11{"AAAAAAAAAAAA"_dna4};
     static constexpr auto randstrobe_view = randstrobe2_hash(seqan3::ungapped{4}, 1, 6, seqan3::seed{0});
-    std::vector<uint64_t> r1 = text11 | randstrobe_view;
-    std::vector<uint64_t> r3 = text3 | randstrobe_view;
+    auto r1 = text11 | randstrobe_view;
+    auto r3 = text3 | randstrobe_view;
 
     result_t result_r1{0,0,0};
     result_t result_r3{6683,1637,357,};
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "timing.hpp"
+
+TEST(timing, empty)
+{
+    minions::interval_estimate const estimate = minions::estimate_mean({});
+    EXPECT_EQ(0.0, estimate.mean);
+    EXPECT_EQ(0.0, estimate.lower);
+    EXPECT_EQ(0.0, estimate.upper);
+}
+
+TEST(timing, single)
+{
+    minions::interval_estimate const estimate = minions::estimate_mean({2.5});
+    EXPECT_EQ(2.5, estimate.mean);
+    EXPECT_EQ(0.0, estimate.stdev);
+    EXPECT_EQ(2.5, estimate.lower);
+    EXPECT_EQ(2.5, estimate.upper);
+}
+
+TEST(timing, interval)
+{
+    // mean 3, sample standard deviation sqrt(2.5), half width 2.776 * sqrt(2.5) / sqrt(5)
+    minions::interval_estimate const estimate = minions::estimate_mean({1.0, 2.0, 3.0, 4.0, 5.0});
+    EXPECT_DOUBLE_EQ(3.0, estimate.mean);
+    EXPECT_DOUBLE_EQ(std::sqrt(2.5), estimate.stdev);
+    EXPECT_DOUBLE_EQ(3.0 - 2.776 * std::sqrt(2.5) / std::sqrt(5.0), estimate.lower);
+    EXPECT_DOUBLE_EQ(3.0 + 2.776 * std::sqrt(2.5) / std::sqrt(5.0), estimate.upper);
+}
+
+TEST(timing, student_t_quantile)
+{
+    EXPECT_DOUBLE_EQ(12.706, minions::student_t_quantile(1));
+    EXPECT_DOUBLE_EQ(2.042, minions::student_t_quantile(30));
+    EXPECT_DOUBLE_EQ(1.960, minions::student_t_quantile(31));
+}
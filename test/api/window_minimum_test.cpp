@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <seqan3/std/algorithm>
+
+#include "window_minimum.hpp"
+
+// Returns the rightmost minimum of every window, calculated by scanning the whole window.
+std::vector<std::pair<uint64_t, size_t>> expected_minima(std::vector<uint64_t> const & values, size_t const window_size)
+{
+    std::vector<std::pair<uint64_t, size_t>> result{};
+    for (size_t end = 1; end <= values.size(); ++end)
+    {
+        auto begin = values.begin() + (end > window_size ? end - window_size : 0);
+        auto minimum = std::min_element(begin, values.begin() + end, std::less_equal<uint64_t>{});
+        result.emplace_back(*minimum, std::distance(values.begin(), minimum));
+    }
+    return result;
+}
+
+TEST(window_minimum, small_example)
+{
+    minions::window_minimum<uint64_t> window{3};
+    EXPECT_EQ(3u, window.window_size());
+
+    std::vector<uint64_t> values{5, 3, 3, 7, 8, 9, 1};
+    std::vector<std::pair<uint64_t, size_t>> result{};
+    for (uint64_t value : values)
+    {
+        window.push(value);
+        result.emplace_back(window.min(), window.min_position());
+    }
+    EXPECT_EQ(7u, window.pushed_values());
+    EXPECT_EQ(expected_minima(values, 3), result);
+
+    window.clear();
+    window.push(4);
+    EXPECT_EQ(4u, window.min());
+    EXPECT_EQ(0u, window.min_position());
+}
+
+TEST(window_minimum, random_values_with_ties)
+{
+    std::mt19937_64 generator{42};
+    for (size_t window_size : {1u, 2u, 3u, 4u, 7u, 8u, 31u, 100u})
+    {
+        for (uint64_t alphabet_size : {2u, 10u, 1000u})
+        {
+            std::vector<uint64_t> values(500);
+            for (auto & value : values)
+                value = generator() % alphabet_size;
+
+            minions::window_minimum<uint64_t> window{window_size};
+            std::vector<std::pair<uint64_t, size_t>> result{};
+            for (uint64_t value : values)
+            {
+                window.push(value);
+                result.emplace_back(window.min(), window.min_position());
+            }
+            EXPECT_EQ(expected_minima(values, window_size), result);
+        }
+    }
+}
@@ -1,3 +1,8 @@
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <vector>
+
 #include "cli_test.hpp"
 
 TEST_F(cli_test, no_options)
@@ -87,6 +92,135 @@ TEST_F(cli_test, opensyncmer)
     EXPECT_EQ(result.err, std::string{});
 }
 
+TEST_F(cli_test, wrong_syncmer_position)
+{
+    // Positions are stored as a bit mask in the count file.
+    cli_test_result result = execute_app("minions counts --method syncmer --pos 64 -k 19 -w 3", data("example1.fasta"));
+    std::string expected
+    {
+        "Error. Incorrect command line input for counts. Value 64 of option --pos is not in range [0,63].\n"
+    };
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected);
+    EXPECT_FALSE(std::filesystem::exists("syncmer_hash_19_3_64_counts.out"));
+}
+
+TEST_F(cli_test, specs)
+{
+    cli_test_result result = execute_app("minions counts -k 19 --spec minimiser:w=23 --spec modmer:w=2 "
+                                         "--spec syncmer:k=15:w=5:pos=0 --spec strobemer:w-min=16:w-max=30:rand "
+                                         "--spec kmer:k=21", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{});
+
+    // Every method writes the same files as a single run of counts.
+    std::vector<std::pair<std::string, std::string>> const single_runs
+    {
+        {"--method minimiser -k 19 -w 23", "minimiser_hash_19_23"},
+        {"--method modmer -k 19 -w 2", "modmer_hash_19_2"},
+        {"--method syncmer -k 15 -w 5 --pos 0", "syncmer_hash_15_5_0_0"},
+        {"--method strobemer -k 19 --w-min 16 --w-max 30 --rand", "randstrobemers_19_2_16_30"},
+        {"--method kmer -k 21", "kmer_hash_21"}
+    };
+    for (auto const & [options, name] : single_runs)
+    {
+        result = execute_app("minions counts " + options + " -o single_", data("example1.fasta"));
+        EXPECT_EQ(result.exit_code, 0);
+        for (std::string const file : {name + "_example1_counts.out", name + "_counts.out"})
+        {
+            std::ifstream multi{file, std::ios::binary};
+            std::ifstream single{"single_" + file, std::ios::binary};
+            std::string const multi_content{std::istreambuf_iterator<char>{multi}, std::istreambuf_iterator<char>{}};
+            std::string const single_content{std::istreambuf_iterator<char>{single}, std::istreambuf_iterator<char>{}};
+            EXPECT_FALSE(multi_content.empty()) << file;
+            EXPECT_EQ(single_content, multi_content) << file;
+        }
+    }
+}
+
+TEST_F(cli_test, max_memory)
+{
+    cli_test_result result = execute_app("minions counts --method kmer -k 19 -o memory_", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    result = execute_app("minions counts --method kmer -k 19 --max-memory 1 -o partitioned_", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{});
+
+    // Counting in temporary files writes the same files as counting in memory and removes the temporary files.
+    for (std::string const file : {"kmer_hash_19_example1_counts.out", "kmer_hash_19_counts.out"})
+    {
+        std::ifstream memory{"memory_" + file, std::ios::binary};
+        std::ifstream partitioned{"partitioned_" + file, std::ios::binary};
+        std::string const memory_content{std::istreambuf_iterator<char>{memory}, std::istreambuf_iterator<char>{}};
+        std::string const partitioned_content{std::istreambuf_iterator<char>{partitioned},
+                                              std::istreambuf_iterator<char>{}};
+        EXPECT_FALSE(memory_content.empty());
+        EXPECT_EQ(memory_content, partitioned_content);
+    }
+    for (auto const & entry : std::filesystem::directory_iterator{"."})
+        EXPECT_EQ(entry.path().filename().string().find("minions_tmp_"), std::string::npos);
+}
+
+TEST_F(cli_test, sweep)
+{
+    cli_test_result result = execute_app("minions counts --method minimiser -k 15-19:4 -w 23,25", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{});
+
+    for (std::string const name : {"minimiser_hash_15_23", "minimiser_hash_15_25", "minimiser_hash_19_23", "minimiser_hash_19_25"})
+    {
+        EXPECT_TRUE(std::filesystem::exists(name + "_counts.out"));
+        EXPECT_TRUE(std::filesystem::exists(name + "_example1_counts.out"));
+    }
+
+    result = execute_app("minions counts --method syncmer -k 15 -w 5 --pos 0 --pos 9-10", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.err, std::string{});
+    EXPECT_TRUE(std::filesystem::exists("syncmer_hash_15_5_0_9_counts.out"));
+    EXPECT_TRUE(std::filesystem::exists("syncmer_hash_15_5_0_10_counts.out"));
+}
+
+TEST_F(cli_test, wrong_sweep)
+{
+    cli_test_result result = execute_app("minions counts --method kmer -k 19-15", data("example1.fasta"));
+    std::string expected
+    {
+        "Error. Incorrect command line input for counts. Invalid value 19-15: The range 19-15 must not be empty and "
+        "the step must be at least 1.\n"
+    };
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected);
+}
+
+TEST_F(cli_test, wrong_spec)
+{
+    cli_test_result result = execute_app("minions counts -k 19 --spec minimiser:x=23", data("example1.fasta"));
+    std::string expected
+    {
+        "Error. Incorrect command line input for counts. Invalid spec minimiser:x=23: Unknown parameter x.\n"
+    };
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected);
+}
+
+TEST_F(cli_test, wrong_spec_kmer_size)
+{
+    cli_test_result result = execute_app("minions counts --spec kmer:k=300", data("example1.fasta"));
+    std::string expected
+    {
+        "Error. Incorrect command line input for counts. Invalid spec kmer:k=300: 300 is not in range [0,255].\n"
+    };
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected);
+}
+
 TEST_F(cli_test, wrong_method)
 {
     cli_test_result result = execute_app("minions counts --method submer -k 19", data("example1.fasta"));
@@ -99,3 +233,35 @@ TEST_F(cli_test, wrong_method)
     EXPECT_EQ(result.out, std::string{});
     EXPECT_EQ(result.err, expected);
 }
+
+TEST_F(cli_test, estimate)
+{
+    cli_test_result result = execute_app("minions counts --method kmer -k 19 --estimate", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{});
+    EXPECT_FALSE(std::filesystem::exists("kmer_hash_19_example1_counts.out"));
+
+    // The summary has the relative error and the estimate of all files as additional columns.
+    std::ifstream summary{"kmer_hash_19_counts.out"};
+    std::string line{};
+    std::getline(summary, line);
+    EXPECT_EQ(6, std::ranges::count(line, '\t'));
+
+    // example1.fasta has 159493 distinct 19-mers, the estimates lie within three standard errors.
+    std::istringstream columns{line};
+    std::string name{};
+    double min{}, mean{}, stdev{}, max{}, error{}, all_files{};
+    columns >> name >> min >> mean >> stdev >> max >> error >> all_files;
+    EXPECT_EQ("kmer_hash_19", name);
+    EXPECT_GT(error, 0.0);
+    EXPECT_LT(error, 0.05);
+    EXPECT_NEAR(159493.0, min, 3 * error * 159493.0);
+    EXPECT_EQ(min, all_files);
+
+    result = execute_app("minions counts --method kmer -k 19 --estimate --approximate", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, "Error. Incorrect command line input for counts. Option --estimate cannot be combined with "
+                          "--approximate.\n");
+}
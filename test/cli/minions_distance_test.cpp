@@ -1,4 +1,65 @@
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#include <seqan3/io/sequence_file/input.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+
 #include "cli_test.hpp"
+#include "modmer_hash.hpp"
+#include "syncmer_hash.hpp"
+
+struct dna4_traits : seqan3::sequence_file_input_default_traits_dna
+{
+    using sequence_alphabet = seqan3::dna4;
+};
+
+// The default seed of minions for a k-mer size of 19.
+static constexpr seqan3::seed seed{0x8F3F73B5CF1C9ADEULL >> (64u - 2u * 19u)};
+
+// The distances file, computed like the original implementation: the representatives of a record are walked in
+// lockstep with all k-mers of the record.
+template <typename view_t, typename compare_view_t>
+std::string expected_distances(std::filesystem::path const & sequence_file,
+                               view_t const & view,
+                               compare_view_t const & compare_view)
+{
+    std::map<uint64_t, uint64_t> distances{};
+    seqan3::sequence_file_input<dna4_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_file};
+    for (auto & [seq] : fin)
+    {
+        uint64_t distance{0};
+        auto representative = seq | view;
+        auto rep_it = representative.begin();
+        auto compare = seq | compare_view;
+        for (auto comp_it = compare.begin(); rep_it != representative.end() && comp_it != compare.end(); ++comp_it)
+        {
+            if (*rep_it == *comp_it)
+            {
+                if (comp_it != compare.begin())
+                {
+                    ++distances[distance];
+                    distance = 0;
+                }
+                ++rep_it;
+            }
+            ++distance;
+        }
+    }
+
+    std::ostringstream output{};
+    for (auto const & [distance, count] : distances)
+        output << distance << "\t" << count << "\n";
+    return output.str();
+}
+
+std::string file_content(std::filesystem::path const & path)
+{
+    std::ifstream file{path};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
 
 TEST_F(cli_test, no_options)
 {
@@ -59,3 +120,37 @@ TEST_F(cli_test, wrong_method)
     EXPECT_EQ(result.err, expected);
     EXPECT_EQ(result.out, std::string{});
 }
+
+// The distances files are the ones of the original implementation.
+TEST_F(cli_test, minimiser_distances)
+{
+    cli_test_result result = execute_app("minions distance --method minimiser -k 19 -w 23", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.err, std::string{});
+    EXPECT_EQ(file_content("minimiser_hash_19_23_example1_distances.out"),
+              expected_distances(data("example1.fasta"),
+                                 seqan3::views::minimiser_hash(seqan3::ungapped{19}, seqan3::window_size{23}, seed),
+                                 seqan3::views::minimiser_hash(seqan3::ungapped{19}, seqan3::window_size{19}, seed)));
+}
+
+TEST_F(cli_test, modmer_distances)
+{
+    cli_test_result result = execute_app("minions distance --method modmer -k 19 -w 2", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.err, std::string{});
+    EXPECT_EQ(file_content("modmer_hash_19_2_example1_distances.out"),
+              expected_distances(data("example1.fasta"),
+                                 modmer_hash(seqan3::ungapped{19}, 2, seed),
+                                 modmer_hash(seqan3::ungapped{19}, 1, seed)));
+}
+
+TEST_F(cli_test, syncmer_distances)
+{
+    cli_test_result result = execute_app("minions distance --method syncmer -k 19 -w 2 -p 0", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.err, std::string{});
+    EXPECT_EQ(file_content("syncmer_hash_19_2_0_0_example1_distances.out"),
+              expected_distances(data("example1.fasta"),
+                                 syncmer_hash(2, 19, std::vector<int>{0}, seed),
+                                 seqan3::views::minimiser_hash(seqan3::ungapped{19}, seqan3::window_size{19}, seed)));
+}
@@ -1,4 +1,130 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+#include <seqan3/io/sequence_file/input.hpp>
+#include <seqan3/search/views/kmer_hash.hpp>
+#include <seqan3/search/views/minimiser_hash.hpp>
+
 #include "cli_test.hpp"
+#include "modmer_hash.hpp"
+#include "syncmer_hash.hpp"
+
+struct dna4_traits : seqan3::sequence_file_input_default_traits_dna
+{
+    using sequence_alphabet = seqan3::dna4;
+};
+
+// The default seed of minions for a k-mer size of 19.
+static constexpr seqan3::seed seed{0x8F3F73B5CF1C9ADEULL >> (64u - 2u * 19u)};
+
+// The hash values of all records of a file, concatenated.
+template <typename view_t>
+std::vector<uint64_t> file_hashes(std::filesystem::path const & sequence_file, view_t const & view)
+{
+    std::vector<uint64_t> hashes{};
+    seqan3::sequence_file_input<dna4_traits, seqan3::fields<seqan3::field::seq>> fin{sequence_file};
+    for (auto & [seq] : fin)
+        std::ranges::copy(seq | view, std::back_inserter(hashes));
+    return hashes;
+}
+
+// The output of match, computed like the original implementation: the vectors of the representatives and of all
+// k-mers of both files are walked in lockstep.
+std::string expected_match_output(std::vector<uint64_t> const & seq1_vector,
+                                  std::vector<uint64_t> const & seq2_vector,
+                                  std::vector<uint64_t> const & all1_vector,
+                                  std::vector<uint64_t> const & all2_vector,
+                                  size_t const kmer_size,
+                                  bool const representatives)
+{
+    uint64_t matches{0};
+    uint64_t missed{0};
+    std::vector<bool> positions(all1_vector.size() + kmer_size - 1, false);
+    if (representatives)
+    {
+        for (size_t it_1 = 0, it_2 = 0, i = 0;
+             it_1 < seq1_vector.size() && it_2 < seq2_vector.size() && i < all1_vector.size(); ++i)
+        {
+            if (seq1_vector[it_1] == seq2_vector[it_2])
+            {
+                ++matches;
+                std::fill_n(positions.begin() + i, kmer_size, true);
+            }
+            if (seq1_vector[it_1] == all1_vector[i])
+                ++it_1;
+            if (seq2_vector[it_2] == all2_vector[i])
+                ++it_2;
+        }
+        missed = std::min(seq1_vector.size(), seq2_vector.size()) - matches;
+    }
+    else
+    {
+        for (size_t i = 0; i < seq1_vector.size(); ++i)
+        {
+            if (seq1_vector[i] == seq2_vector[i])
+            {
+                ++matches;
+                std::fill_n(positions.begin() + i, kmer_size, true);
+            }
+            else
+            {
+                ++missed;
+            }
+        }
+    }
+
+    std::vector<uint64_t> islands{};
+    uint64_t current_island{0};
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+        if (!positions[i])
+        {
+            ++current_island;
+        }
+        else if (i > 0)
+        {
+            islands.push_back(current_island);
+            current_island = 0;
+        }
+    }
+    islands.push_back(current_island);
+
+    double const mean = std::accumulate(islands.begin(), islands.end(), 0.0) / islands.size();
+    double squares{0.0};
+    double deviations{0.0};
+    for (uint64_t const island : islands)
+    {
+        squares += static_cast<double>(island * island);
+        deviations += (island - mean) * (island - mean);
+    }
+
+    std::ostringstream output{};
+    output << "Matches: " << matches << "\t" << "Missed: " << missed << "\n";
+    output << "Match Coverage: " << std::count(positions.begin(), positions.end(), true) * 100.0 / positions.size() << "\n";
+    output << "Islands: " << std::ranges::min(islands) << "\t" << mean << "\t" << std::sqrt(deviations / islands.size())
+           << "\t" << std::ranges::max(islands) << "\n";
+    output << "Expected Island Size: " << squares / islands.size() << "\n";
+    return output.str();
+}
+
+// The output of match for a representative method, whose positions are recovered from all k-mers.
+template <typename view_t, typename compare_view_t>
+std::string expected_match_output(std::filesystem::path const & sequence_file1,
+                                  std::filesystem::path const & sequence_file2,
+                                  view_t const & view,
+                                  compare_view_t const & compare_view)
+{
+    return expected_match_output(file_hashes(sequence_file1, view),
+                                 file_hashes(sequence_file2, view),
+                                 file_hashes(sequence_file1, compare_view),
+                                 file_hashes(sequence_file2, compare_view),
+                                 19,
+                                 true);
+}
 
 TEST_F(cli_test, no_options)
 {
@@ -82,3 +208,45 @@ TEST_F(cli_test, wrong_method)
     EXPECT_EQ(result.out, std::string{});
     EXPECT_EQ(result.err, expected);
 }
+
+// The output for two different files is the one of the original implementation.
+TEST_F(cli_test, kmer_different_files)
+{
+    cli_test_result result = execute_app("minions match --method kmer -k 19", data("search.fasta"), data("example1.fasta"));
+    auto const kmers = seqan3::views::kmer_hash(seqan3::ungapped{19});
+    std::vector<uint64_t> const all1_vector = file_hashes(data("search.fasta"), kmers);
+    std::vector<uint64_t> const all2_vector = file_hashes(data("example1.fasta"), kmers);
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, expected_match_output(all1_vector, all2_vector, all1_vector, all2_vector, 19, false));
+    EXPECT_EQ(result.err, std::string{});
+}
+
+TEST_F(cli_test, minimiser_different_files)
+{
+    cli_test_result result = execute_app("minions match --method minimiser -k 19 -w 23", data("search.fasta"), data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, expected_match_output(data("search.fasta"), data("example1.fasta"),
+                                                seqan3::views::minimiser_hash(seqan3::ungapped{19}, seqan3::window_size{23}, seed),
+                                                seqan3::views::minimiser_hash(seqan3::ungapped{19}, seqan3::window_size{19}, seed)));
+    EXPECT_EQ(result.err, std::string{});
+}
+
+TEST_F(cli_test, modmer_different_files)
+{
+    cli_test_result result = execute_app("minions match --method modmer -k 19 -w 2", data("search.fasta"), data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, expected_match_output(data("search.fasta"), data("example1.fasta"),
+                                                modmer_hash(seqan3::ungapped{19}, 2, seed),
+                                                modmer_hash(seqan3::ungapped{19}, 1, seed)));
+    EXPECT_EQ(result.err, std::string{});
+}
+
+TEST_F(cli_test, syncmer_different_files)
+{
+    cli_test_result result = execute_app("minions match --method syncmer -k 19 -w 2 -p 0", data("search.fasta"), data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, expected_match_output(data("search.fasta"), data("example1.fasta"),
+                                                syncmer_hash(2, 19, std::vector<int>{0}, seed),
+                                                seqan3::views::minimiser_hash(seqan3::ungapped{19}, seqan3::window_size{19}, seed)));
+    EXPECT_EQ(result.err, std::string{});
+}
@@ -1,3 +1,5 @@
+#include <fstream>
+
 #include "cli_test.hpp"
 
 TEST_F(cli_test, no_options)
@@ -62,6 +64,31 @@ TEST_F(cli_test, minstrobemer)
     EXPECT_EQ(result.err, std::string{});
 }
 
+TEST_F(cli_test, perf_counters)
+{
+    // Whether a warning is printed depends on the availability of the counters.
+    cli_test_result result = execute_app("minions speed --method minimiser -k 19 -w 23 --perf-counters --repetitions 2",
+                                         data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+}
+
+TEST_F(cli_test, sweep)
+{
+    cli_test_result result = execute_app("minions speed --method strobemer -k 15,19 --w-min 16 --w-max 30-40:10 "
+                                         "--order 2 --rand --repetitions 2", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, std::string{});
+
+    for (std::string const name : {"randstrobemers_15_2_16_30", "randstrobemers_15_2_16_40",
+                                   "randstrobemers_19_2_16_30", "randstrobemers_19_2_16_40"})
+    {
+        EXPECT_TRUE(std::filesystem::exists(name + "_speed.out"));
+        EXPECT_TRUE(std::filesystem::exists(name + "_speed.json"));
+    }
+}
+
 TEST_F(cli_test, wrong_method)
 {
     cli_test_result result = execute_app("minions speed --method submer -k 19", data("example1.fasta"));
@@ -74,3 +101,18 @@ TEST_F(cli_test, wrong_method)
     EXPECT_EQ(result.out, std::string{});
     EXPECT_EQ(result.err, expected);
 }
+
+TEST_F(cli_test, empty_file)
+{
+    // There is no time per sequence and per base without sequences.
+    std::ofstream{"empty.fasta"};
+    cli_test_result result = execute_app("minions speed --method kmer -k 19 empty.fasta");
+    std::string expected
+    {
+        "Error. Incorrect command line input for speed. The sequence files contain no bases.\n"
+    };
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, expected);
+    EXPECT_FALSE(std::filesystem::exists("kmer_hash_19_speed.out"));
+}
@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
 #include "cli_test.hpp"
+#include "count_file.hpp"
 
 TEST_F(cli_test, no_options)
 {
@@ -13,3 +18,94 @@ TEST_F(cli_test, no_options)
     EXPECT_EQ(result.out, expected);
     EXPECT_EQ(result.err, std::string{});
 }
+
+TEST_F(cli_test, approximate)
+{
+    cli_test_result result = execute_app("minions counts --method kmer -k 19 --approximate", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.err, std::string{});
+    EXPECT_TRUE(std::filesystem::exists("kmer_hash_19_example1_sample.out"));
+    EXPECT_FALSE(std::filesystem::exists("kmer_hash_19_example1_counts.out"));
+
+    // The summary of counts has the relative error as an additional column.
+    std::ifstream summary{"kmer_hash_19_counts.out"};
+    std::string line{};
+    std::getline(summary, line);
+    EXPECT_EQ(5, std::ranges::count(line, '\t'));
+
+    // Unique reports the percentage and its standard error.
+    result = execute_app("minions unique kmer_hash_19_example1_sample.out -o unique.out");
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.err, std::string{});
+    std::ifstream unique_file{"unique.out"};
+    std::getline(unique_file, line);
+    EXPECT_EQ(2, std::ranges::count(line, '\t'));
+}
+
+TEST_F(cli_test, cross_file)
+{
+    cli_test_result result = execute_app("minions counts --method kmer -k 19", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.err, std::string{});
+
+    result = execute_app("minions unique kmer_hash_19_example1_counts.out -o unique.out --cross-file -t 2");
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.err, std::string{});
+
+    // One row per file with the percentage of submers, that no other file has, and a row for all files.
+    std::ifstream unique_file{"unique.out"};
+    std::string line{};
+    std::getline(unique_file, line);
+    EXPECT_EQ(2, std::ranges::count(line, '\t'));
+    EXPECT_TRUE(line.ends_with("\t100"));
+    std::getline(unique_file, line);
+    EXPECT_TRUE(line.starts_with("all_files\t"));
+    EXPECT_FALSE(std::getline(unique_file, line));
+}
+
+TEST_F(cli_test, cross_file_overlap)
+{
+    minions::count_file_parameters parameters{};
+    parameters.kmer_size = 19;
+    minions::write_count_file("first.out", parameters, std::vector<uint64_t>{1, 2, 3, 4}, std::vector<uint16_t>{1, 2, 1, 3});
+    minions::write_count_file("second.out", parameters, std::vector<uint64_t>{3, 4, 5}, std::vector<uint16_t>{1, 1, 1});
+
+    cli_test_result result = execute_app("minions unique first.out second.out -o unique.out --cross-file -t 2");
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.err, std::string{});
+
+    // The hash values 1 and 5 occur once in total, the hash values 1, 2 and 5 occur in one file only.
+    std::ifstream unique_file{"unique.out"};
+    std::string const content{std::istreambuf_iterator<char>{unique_file}, std::istreambuf_iterator<char>{}};
+    EXPECT_EQ(content, "\"first\"\t50\t50\n\"second\"\t100\t33.3333\nall_files\t40\t60\n");
+}
+
+TEST_F(cli_test, cross_file_invalid_input)
+{
+    minions::count_file_parameters parameters{};
+    parameters.kmer_size = 19;
+    minions::write_count_file("first.out", parameters, std::vector<uint64_t>{1, 2}, std::vector<uint16_t>{1, 1});
+    minions::write_count_file("unsorted.out", parameters, std::vector<uint64_t>{2, 1}, std::vector<uint16_t>{1, 1});
+    parameters.kmer_size = 21;
+    minions::write_count_file("other.out", parameters, std::vector<uint64_t>{1, 2}, std::vector<uint16_t>{1, 1});
+
+    cli_test_result result = execute_app("minions unique first.out other.out -o unique.out --cross-file");
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, "Error. Incorrect command line input for unique. The count files first.out and other.out "
+                          "were counted with different methods.\n");
+
+    result = execute_app("minions unique first.out unsorted.out -o unique.out --cross-file");
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, "Error. Incorrect command line input for unique. The hash values of count file 2 are not "
+                          "sorted.\n");
+
+    result = execute_app("minions counts --method kmer -k 19 --approximate", data("example1.fasta"));
+    EXPECT_EQ(result.exit_code, 0);
+    result = execute_app("minions unique kmer_hash_19_example1_sample.out -o unique.out --cross-file");
+    EXPECT_EQ(result.exit_code, 0);
+    EXPECT_EQ(result.out, std::string{});
+    EXPECT_EQ(result.err, "Error. Incorrect command line input for unique. The sample file "
+                          "kmer_hash_19_example1_sample.out cannot be compared across files.\n");
+}
@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/search/views/kmer_hash.hpp>
+#include <seqan3/test/performance/sequence_generator.hpp>
+
+#include "batch.hpp"
+#include "minions_minimiser_hash.hpp"
+#include "randstrobe_hash.hpp"
+#include "syncmer_hash.hpp"
+
+static constexpr seqan3::seed seed{0x8F3F73B5CF1C9ADE};
+
+//!\brief Reports the number of bases per second.
+void set_base_counters(benchmark::State & state, size_t const bases_per_iteration)
+{
+    state.counters["bases/s"] = benchmark::Counter(bases_per_iteration, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Collects the hashes of the view in a vector, like read_seq_file() does.
+template <typename adaptor_t>
+void view_to_vector(benchmark::State & state, adaptor_t const & adaptor)
+{
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(state.range(0), 0, 0);
+    std::vector<uint64_t> hashes{};
+
+    for (auto _ : state)
+    {
+        hashes.clear();
+        for (uint64_t hash : sequence | adaptor)
+            hashes.push_back(hash);
+        benchmark::DoNotOptimize(hashes.data());
+    }
+
+    set_base_counters(state, sequence.size());
+}
+
+// Writes the hashes into a reused minions::batch_buffer.
+template <typename batch_t>
+void batch_to_buffer(benchmark::State & state, batch_t const & batch)
+{
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(state.range(0), 0, 0);
+    minions::batch_buffer buffer{};
+
+    for (auto _ : state)
+    {
+        buffer.clear();
+        batch(sequence, buffer);
+        benchmark::DoNotOptimize(buffer.hashes.data());
+    }
+
+    set_base_counters(state, sequence.size());
+}
+
+void minimiser_view(benchmark::State & state)
+{
+    view_to_vector(state, minions::views::minimiser_hash(seqan3::ungapped{19}, seqan3::window_size{25}, seed));
+}
+
+void minimiser_batch(benchmark::State & state)
+{
+    batch_to_buffer(state, [] (auto const & sequence, minions::batch_buffer & buffer)
+    {
+        minions::minimiser_batch(sequence, seqan3::ungapped{19}, seqan3::window_size{25}, seed, buffer);
+    });
+}
+
+void syncmer_view(benchmark::State & state)
+{
+    view_to_vector(state, syncmer_hash(5, 19, std::vector<int>{0}, seed));
+}
+
+void syncmer_batch(benchmark::State & state)
+{
+    batch_to_buffer(state, [] (auto const & sequence, minions::batch_buffer & buffer)
+    {
+        minions::syncmer_batch(sequence, 5, 19, {0}, seed, buffer);
+    });
+}
+
+void randstrobe_view(benchmark::State & state)
+{
+    view_to_vector(state, randstrobe2_hash(seqan3::ungapped{19}, 20, 50, seed));
+}
+
+void randstrobe_batch(benchmark::State & state)
+{
+    batch_to_buffer(state, [] (auto const & sequence, minions::batch_buffer & buffer)
+    {
+        minions::strobemer_batch<minions::strobemer_method::randstrobe, 2>(sequence,
+                                                                           seqan3::ungapped{19},
+                                                                           20,
+                                                                           50,
+                                                                           seed,
+                                                                           buffer);
+    });
+}
+
+// The minimiser kernel on canonical k-mer hashes, state.range(0) k-mers per window known at run time.
+void minimiser_kernel_generic(benchmark::State & state)
+{
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(1'000'000, 0, 0);
+    std::vector<uint64_t> values{};
+    std::ranges::copy(sequence | seqan3::views::kmer_hash(seqan3::ungapped{19}), std::back_inserter(values));
+    minions::batch_buffer buffer{};
+
+    for (auto _ : state)
+    {
+        buffer.clear();
+        minions::detail::batch_minimisers(values, state.range(0), buffer);
+        benchmark::DoNotOptimize(buffer.hashes.data());
+    }
+
+    set_base_counters(state, sequence.size());
+}
+
+// The same with the number of k-mers per window known at compile time.
+template <size_t values_per_window>
+void minimiser_kernel_specialised(benchmark::State & state)
+{
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(1'000'000, 0, 0);
+    std::vector<uint64_t> values{};
+    std::ranges::copy(sequence | seqan3::views::kmer_hash(seqan3::ungapped{19}), std::back_inserter(values));
+    minions::batch_buffer buffer{};
+
+    for (auto _ : state)
+    {
+        buffer.clear();
+        minions::detail::batch_minimisers(values, std::integral_constant<size_t, values_per_window>{}, buffer);
+        benchmark::DoNotOptimize(buffer.hashes.data());
+    }
+
+    set_base_counters(state, sequence.size());
+}
+
+// minimiser_batch for k = 19 and state.range(0) bases per window, up to 69 bases the specialised kernel is used.
+void minimiser_batch_window(benchmark::State & state)
+{
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(1'000'000, 0, 0);
+    minions::batch_buffer buffer{};
+    seqan3::window_size const window_size{static_cast<uint32_t>(state.range(0))};
+
+    for (auto _ : state)
+    {
+        buffer.clear();
+        minions::minimiser_batch(sequence, seqan3::ungapped{19}, window_size, seed, buffer);
+        benchmark::DoNotOptimize(buffer.hashes.data());
+    }
+
+    set_base_counters(state, sequence.size());
+}
+
+BENCHMARK(minimiser_view)->Arg(100'000);
+BENCHMARK(minimiser_batch)->Arg(100'000);
+BENCHMARK(syncmer_view)->Arg(100'000);
+BENCHMARK(syncmer_batch)->Arg(100'000);
+BENCHMARK(randstrobe_view)->Arg(100'000);
+BENCHMARK(randstrobe_batch)->Arg(100'000);
+BENCHMARK(minimiser_kernel_generic)->Arg(7)->Arg(32)->Arg(51);
+BENCHMARK_TEMPLATE(minimiser_kernel_specialised, 7);
+BENCHMARK_TEMPLATE(minimiser_kernel_specialised, 32);
+BENCHMARK_TEMPLATE(minimiser_kernel_specialised, 51);
+BENCHMARK(minimiser_batch_window)->Arg(25)->Arg(69)->Arg(70)->Arg(100);
+
+BENCHMARK_MAIN();
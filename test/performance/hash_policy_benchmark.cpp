@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <iterator>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/search/views/kmer_hash.hpp>
+#include <seqan3/test/performance/sequence_generator.hpp>
+
+#include "hash_policy.hpp"
+#include "modmer_hash.hpp"
+
+static constexpr uint64_t seed{0x8F3F73B5CF1C9ADE};
+
+//!\brief Reports the time per k-mer and the number of k-mers per second.
+void set_kmer_counters(benchmark::State & state, size_t const kmers_per_iteration)
+{
+    state.counters["time/k-mer"] = benchmark::Counter(kmers_per_iteration,
+                                                      benchmark::Counter::kIsIterationInvariantRate |
+                                                      benchmark::Counter::kInvert);
+    state.counters["k-mers/s"] = benchmark::Counter(kmers_per_iteration,
+                                                    benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Applies the policy to precomputed k-mer hashes, i.e. measures the hash function alone.
+template <typename hash_policy_t>
+void hash_only(benchmark::State & state)
+{
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(state.range(0), 0, 0);
+    std::vector<uint64_t> kmers{};
+    std::ranges::copy(sequence | seqan3::views::kmer_hash(seqan3::ungapped{19}), std::back_inserter(kmers));
+
+    for (auto _ : state)
+    {
+        uint64_t sum{0};
+        for (uint64_t kmer : kmers)
+            sum += hash_policy_t{}(kmer, seed);
+        benchmark::DoNotOptimize(sum);
+    }
+
+    set_kmer_counters(state, kmers.size());
+}
+
+// Computes canonical modmers with the policy, i.e. measures the hash function inside the view.
+template <typename hash_policy_t>
+void modmer_hash_policy(benchmark::State & state)
+{
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(state.range(0), 0, 0);
+    auto view = modmer_hash(seqan3::ungapped{19}, 5u, seqan3::seed{seed}, hash_policy_t{});
+
+    for (auto _ : state)
+    {
+        uint64_t sum{0};
+        for (uint64_t hash : sequence | view)
+            sum += hash;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    set_kmer_counters(state, sequence.size() - 19 + 1);
+}
+
+BENCHMARK_TEMPLATE(hash_only, minions::xor_hash_policy)->Arg(100'000);
+BENCHMARK_TEMPLATE(hash_only, minions::fnv_hash_policy)->Arg(100'000);
+BENCHMARK_TEMPLATE(hash_only, minions::splitmix_hash_policy)->Arg(100'000);
+BENCHMARK_TEMPLATE(hash_only, minions::murmur_hash_policy)->Arg(100'000);
+BENCHMARK_TEMPLATE(hash_only, minions::wyhash_hash_policy)->Arg(100'000);
+
+BENCHMARK_TEMPLATE(modmer_hash_policy, minions::fnv_hash_policy)->Arg(100'000);
+BENCHMARK_TEMPLATE(modmer_hash_policy, minions::splitmix_hash_policy)->Arg(100'000);
+BENCHMARK_TEMPLATE(modmer_hash_policy, minions::murmur_hash_policy)->Arg(100'000);
+BENCHMARK_TEMPLATE(modmer_hash_policy, minions::wyhash_hash_policy)->Arg(100'000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,171 @@
+#include <benchmark/benchmark.h>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/search/views/kmer_hash.hpp>
+#include <seqan3/test/performance/sequence_generator.hpp>
+
+#include "hybridstrobe.hpp"
+#include "hybridstrobe_hash.hpp"
+#include "minions_minimiser_hash.hpp"
+#include "minstrobe.hpp"
+#include "minstrobe_hash.hpp"
+#include "modmer_hash.hpp"
+#include "randstrobe.hpp"
+#include "randstrobe_hash.hpp"
+#include "syncmer_hash.hpp"
+
+// Every view is run on the same deterministic sequences, the first argument of a benchmark is the sequence length, the
+// others are the parameters of the view.
+
+static constexpr seqan3::seed seed{0x8F3F73B5CF1C9ADE};
+
+//!\brief Reports the time per base and the number of bases per second.
+void set_base_counters(benchmark::State & state, size_t const bases_per_iteration)
+{
+    state.counters["time/base"] = benchmark::Counter(bases_per_iteration,
+                                                     benchmark::Counter::kIsIterationInvariantRate |
+                                                     benchmark::Counter::kInvert);
+    state.counters["bases/s"] = benchmark::Counter(bases_per_iteration, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Consumes all values of the view applied to a random sequence of length state.range(0).
+template <typename adaptor_t>
+void consume_view(benchmark::State & state, adaptor_t const & adaptor)
+{
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(state.range(0), 0, 0);
+
+    for (auto _ : state)
+    {
+        uint64_t sum{0};
+        for (auto && value : sequence | adaptor)
+            sum += value;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    set_base_counters(state, sequence.size());
+}
+
+// The k-mer size.
+seqan3::ungapped kmer_shape(benchmark::State const & state)
+{
+    return seqan3::ungapped{static_cast<uint8_t>(state.range(1))};
+}
+
+// Arguments: length, k.
+void kmer_hash_view(benchmark::State & state)
+{
+    consume_view(state, seqan3::views::kmer_hash(kmer_shape(state)));
+}
+
+// Arguments: length, k, window size in bases.
+void minimiser_hash_view(benchmark::State & state)
+{
+    consume_view(state, minions::views::minimiser_hash(kmer_shape(state),
+                                                       seqan3::window_size{static_cast<uint32_t>(state.range(2))},
+                                                       seed));
+}
+
+// Arguments: length, k, modulus.
+void modmer_hash_view(benchmark::State & state)
+{
+    consume_view(state, modmer_hash(kmer_shape(state), static_cast<uint32_t>(state.range(2)), seed));
+}
+
+// Arguments: length, k, s-mer size.
+void syncmer_hash_view(benchmark::State & state)
+{
+    consume_view(state, syncmer_hash(state.range(2), state.range(1), std::vector<int>{0}, seed));
+}
+
+// Arguments: length, k, s-mer size.
+void syncmer_hash_no_reverse_view(benchmark::State & state)
+{
+    consume_view(state, syncmer_hash_no_reverse(state.range(2), state.range(1), std::vector<int>{0}));
+}
+
+// Arguments: length, k, minimal and maximal strobe offset.
+template <typename adaptor_t>
+void strobemer_hash_view(benchmark::State & state, adaptor_t const & adaptor)
+{
+    consume_view(state, adaptor(kmer_shape(state),
+                                static_cast<uint32_t>(state.range(2)),
+                                static_cast<uint32_t>(state.range(3)),
+                                seed));
+}
+
+// The strobemer views applied to k-mer hashes, as `minions speed` runs them.
+// Arguments: length, k, minimal and maximal strobe offset.
+template <typename adaptor_t>
+void strobemer_pipeline(benchmark::State & state, adaptor_t const & adaptor, bool const order3)
+{
+    seqan3::shape const shape{kmer_shape(state)};
+    size_t const window_dist = state.range(2) + shape.size() - 1;
+    size_t const window_size = state.range(3) - shape.size() + 1;
+
+    if (order3)
+        consume_view(state, seqan3::views::kmer_hash(shape) | adaptor(true, window_dist, window_size, shape.count()));
+    else
+        consume_view(state, seqan3::views::kmer_hash(shape) | adaptor(window_dist, window_size, shape.count()));
+}
+
+// The sequence lengths, a short read and a bacterial genome.
+static std::vector<int64_t> const lengths{10'000, 1'000'000};
+
+static void kmer_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    for (int64_t length : lengths)
+        for (int64_t k : {15, 19, 31})
+            benchmark->Args({length, k});
+}
+
+static void minimiser_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    for (int64_t length : lengths)
+        for (auto [k, w] : std::vector<std::pair<int64_t, int64_t>>{{15, 19}, {19, 25}, {19, 50}, {31, 100}})
+            benchmark->Args({length, k, w});
+}
+
+static void modmer_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    for (int64_t length : lengths)
+        for (int64_t k : {15, 19, 31})
+            for (int64_t modulus : {2, 5, 10})
+                benchmark->Args({length, k, modulus});
+}
+
+static void syncmer_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    for (int64_t length : lengths)
+        for (auto [k, s] : std::vector<std::pair<int64_t, int64_t>>{{15, 5}, {19, 5}, {19, 9}, {31, 11}})
+            benchmark->Args({length, k, s});
+}
+
+static void strobemer_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    for (int64_t length : lengths)
+        for (int64_t k : {15, 19})
+            for (auto [w_min, w_max] : std::vector<std::pair<int64_t, int64_t>>{{20, 50}, {25, 100}})
+                benchmark->Args({length, k, w_min, w_max});
+}
+
+BENCHMARK(kmer_hash_view)->Apply(kmer_arguments);
+BENCHMARK(minimiser_hash_view)->Apply(minimiser_arguments);
+BENCHMARK(modmer_hash_view)->Apply(modmer_arguments);
+BENCHMARK(syncmer_hash_view)->Apply(syncmer_arguments);
+BENCHMARK(syncmer_hash_no_reverse_view)->Apply(syncmer_arguments);
+
+BENCHMARK_CAPTURE(strobemer_hash_view, randstrobe2_hash, randstrobe2_hash)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_hash_view, randstrobe3_hash, randstrobe3_hash)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_hash_view, minstrobe2_hash, minstrobe2_hash)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_hash_view, minstrobe3_hash, minstrobe3_hash)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_hash_view, hybridstrobe2_hash, hybridstrobe2_hash)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_hash_view, hybridstrobe3_hash, hybridstrobe3_hash)->Apply(strobemer_arguments);
+
+BENCHMARK_CAPTURE(strobemer_pipeline, randstrobe2, seqan3::views::randstrobe, false)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_pipeline, randstrobe3, seqan3::views::randstrobe, true)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_pipeline, minstrobe2, seqan3::views::minstrobe, false)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_pipeline, minstrobe3, seqan3::views::minstrobe, true)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_pipeline, hybridstrobe2, seqan3::views::hybridstrobe, false)->Apply(strobemer_arguments);
+BENCHMARK_CAPTURE(strobemer_pipeline, hybridstrobe3, seqan3::views::hybridstrobe, true)->Apply(strobemer_arguments);
+
+BENCHMARK_MAIN();
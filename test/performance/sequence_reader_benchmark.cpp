@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/io/sequence_file/input.hpp>
+#include <seqan3/test/performance/sequence_generator.hpp>
+
+#include "sequence_reader.hpp"
+
+// The traits of the subcommands, see compare.h.
+struct dna4_traits : seqan3::sequence_file_input_default_traits_dna
+{
+    using sequence_alphabet = seqan3::dna4;
+};
+
+struct text_traits : seqan3::sequence_file_input_default_traits_dna
+{
+    using sequence_legal_alphabet = char;
+    using sequence_alphabet = char;
+    template <typename alph>
+    using sequence_container = std::string;
+};
+
+static constexpr size_t record_count{100};
+static constexpr size_t record_size{100'000};
+
+//!\brief Reports the number of bases per second.
+void set_base_counters(benchmark::State & state, size_t const bases_per_iteration)
+{
+    state.counters["bases/s"] = benchmark::Counter(bases_per_iteration, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Writes random records with state.range(0) bases per line, 0 for one line per sequence, once per line length.
+std::filesystem::path sequence_file(benchmark::State & state)
+{
+    size_t const line_size = state.range(0) == 0 ? record_size : state.range(0);
+    std::filesystem::path const path = std::filesystem::temp_directory_path() /
+                                       ("sequence_reader_benchmark_" + std::to_string(line_size) + ".fasta");
+    if (std::filesystem::exists(path))
+        return path;
+
+    std::ofstream outfile{path};
+    for (size_t record = 0; record < record_count; ++record)
+    {
+        auto const sequence = seqan3::test::generate_sequence<seqan3::dna4>(record_size, 0, record);
+        outfile << ">record" << record << '\n';
+        for (size_t i = 0; i < sequence.size(); ++i)
+            outfile << sequence[i].to_char() << (((i + 1) % line_size == 0 || i + 1 == sequence.size()) ? "\n" : "");
+    }
+    return path;
+}
+
+// Reads all records with seqan3::sequence_file_input, like the subcommands did.
+template <typename traits_t>
+void seqan3_input(benchmark::State & state)
+{
+    std::filesystem::path const path = sequence_file(state);
+
+    for (auto _ : state)
+    {
+        size_t bases{0};
+        seqan3::sequence_file_input<traits_t, seqan3::fields<seqan3::field::seq>> fin{path};
+        for (auto & [seq] : fin)
+        {
+            benchmark::DoNotOptimize(seq.data());
+            bases += seq.size();
+        }
+        benchmark::DoNotOptimize(bases);
+    }
+
+    set_base_counters(state, record_count * record_size);
+}
+
+// Reads all records with minions::sequence_reader.
+template <bool text>
+void sequence_reader(benchmark::State & state)
+{
+    std::filesystem::path const path = sequence_file(state);
+
+    for (auto _ : state)
+    {
+        size_t bases{0};
+        minions::sequence_reader reader{path};
+        while (reader.next())
+        {
+            if constexpr (text)
+            {
+                benchmark::DoNotOptimize(reader.text().data());
+                bases += reader.text().size();
+            }
+            else
+            {
+                benchmark::DoNotOptimize(reader.sequence().data());
+                bases += reader.sequence().size();
+            }
+        }
+        benchmark::DoNotOptimize(bases);
+    }
+
+    set_base_counters(state, record_count * record_size);
+}
+
+// Converts characters to ranks with the given instruction set.
+template <minions::detail::simd_level level>
+void ascii_to_rank(benchmark::State & state)
+{
+    if (level > minions::detail::supported_simd_level())
+    {
+        state.SkipWithError("The instruction set is not supported.");
+        return;
+    }
+
+    std::string characters{};
+    for (seqan3::dna4 const symbol : seqan3::test::generate_sequence<seqan3::dna4>(state.range(0), 0, 0))
+        characters.push_back(symbol.to_char());
+    std::vector<uint8_t> ranks(characters.size());
+
+    for (auto _ : state)
+    {
+        minions::detail::ascii_to_rank(characters.data(), characters.size(), ranks.data(), level);
+        benchmark::DoNotOptimize(ranks.data());
+    }
+
+    set_base_counters(state, characters.size());
+}
+
+// Finds the first character, that is no base, with the given instruction set.
+template <minions::detail::simd_level level>
+void find_non_base(benchmark::State & state)
+{
+    if (level > minions::detail::supported_simd_level())
+    {
+        state.SkipWithError("The instruction set is not supported.");
+        return;
+    }
+
+    std::string characters{};
+    for (seqan3::dna4 const symbol : seqan3::test::generate_sequence<seqan3::dna4>(state.range(0), 0, 0))
+        characters.push_back(symbol.to_char());
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(minions::detail::find_non_base(characters.data(), characters.size(), level));
+
+    set_base_counters(state, characters.size());
+}
+
+BENCHMARK_TEMPLATE(seqan3_input, dna4_traits)->Arg(0)->Arg(80);
+BENCHMARK_TEMPLATE(sequence_reader, false)->Arg(0)->Arg(80);
+BENCHMARK_TEMPLATE(seqan3_input, text_traits)->Arg(0)->Arg(80);
+BENCHMARK_TEMPLATE(sequence_reader, true)->Arg(0)->Arg(80);
+BENCHMARK_TEMPLATE(ascii_to_rank, minions::detail::simd_level::scalar)->Arg(100'000);
+BENCHMARK_TEMPLATE(ascii_to_rank, minions::detail::simd_level::sse4_2)->Arg(100'000);
+BENCHMARK_TEMPLATE(ascii_to_rank, minions::detail::simd_level::avx2)->Arg(100'000);
+BENCHMARK_TEMPLATE(find_non_base, minions::detail::simd_level::scalar)->Arg(100'000);
+BENCHMARK_TEMPLATE(find_non_base, minions::detail::simd_level::sse4_2)->Arg(100'000);
+BENCHMARK_TEMPLATE(find_non_base, minions::detail::simd_level::avx2)->Arg(100'000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <deque>
+#include <iterator>
+
+#include <seqan3/alphabet/nucleotide/dna4.hpp>
+#include <seqan3/search/views/kmer_hash.hpp>
+#include <seqan3/test/performance/sequence_generator.hpp>
+
+#include "minions_minimiser_hash.hpp"
+#include "window_minimum.hpp"
+
+static constexpr size_t sequence_length{1'000'000};
+static constexpr uint8_t k{19};
+
+//!\brief Reports the time per base and the number of bases per second.
+void set_base_counters(benchmark::State & state)
+{
+    state.counters["time/base"] = benchmark::Counter(sequence_length,
+                                                     benchmark::Counter::kIsIterationInvariantRate |
+                                                     benchmark::Counter::kInvert);
+    state.counters["bases/s"] = benchmark::Counter(sequence_length, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// The minimum of all windows of k-mer hashes, like it was calculated before minions::window_minimum: the window is
+// rescanned whenever the minimum leaves it.
+void rescanning_deque(benchmark::State & state)
+{
+    size_t const window_size = state.range(0) - k + 1;
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(sequence_length, 0, 0);
+    std::vector<uint64_t> hashes{};
+    std::ranges::copy(sequence | seqan3::views::kmer_hash(seqan3::ungapped{k}), std::back_inserter(hashes));
+
+    for (auto _ : state)
+    {
+        std::deque<uint64_t> window_values(hashes.begin(), hashes.begin() + window_size);
+        auto minimum = std::ranges::min_element(window_values, std::less_equal<uint64_t>{});
+        size_t offset = std::distance(window_values.begin(), minimum);
+        uint64_t sum{*minimum};
+        for (size_t i = window_size; i < hashes.size(); ++i)
+        {
+            window_values.pop_front();
+            window_values.push_back(hashes[i]);
+            if (offset == 0)
+            {
+                minimum = std::ranges::min_element(window_values, std::less_equal<uint64_t>{});
+                offset = std::distance(window_values.begin(), minimum);
+            }
+            else
+            {
+                --offset;
+                if (hashes[i] < window_values[offset])
+                    offset = window_size - 1;
+            }
+            sum += window_values[offset];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    set_base_counters(state);
+}
+
+// The same with minions::window_minimum.
+void monotone_queue(benchmark::State & state)
+{
+    size_t const window_size = state.range(0) - k + 1;
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(sequence_length, 0, 0);
+    std::vector<uint64_t> hashes{};
+    std::ranges::copy(sequence | seqan3::views::kmer_hash(seqan3::ungapped{k}), std::back_inserter(hashes));
+
+    minions::window_minimum<uint64_t> window{window_size};
+    for (auto _ : state)
+    {
+        window.clear();
+        uint64_t sum{0};
+        for (size_t i = 0; i < window_size - 1; ++i)
+            window.push(hashes[i]);
+        for (size_t i = window_size - 1; i < hashes.size(); ++i)
+        {
+            window.push(hashes[i]);
+            sum += window.min();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    set_base_counters(state);
+}
+
+// Canonical minimisers with minions::views::minimiser_hash, which uses minions::window_minimum.
+void minimiser_hash(benchmark::State & state)
+{
+    auto sequence = seqan3::test::generate_sequence<seqan3::dna4>(sequence_length, 0, 0);
+    auto view = minions::views::minimiser_hash(seqan3::ungapped{k},
+                                               seqan3::window_size{static_cast<uint32_t>(state.range(0))},
+                                               seqan3::seed{0x8F3F73B5CF1C9ADE});
+
+    for (auto _ : state)
+    {
+        uint64_t sum{0};
+        for (uint64_t hash : sequence | view)
+            sum += hash;
+        benchmark::DoNotOptimize(sum);
+    }
+
+    set_base_counters(state);
+}
+
+// Window sizes in bases, from short-read to long-read bins.
+static void window_sizes(benchmark::internal::Benchmark * benchmark)
+{
+    for (int64_t w : {20, 30, 50, 100, 250, 500, 1000, 2500, 5000})
+        benchmark->Arg(w);
+}
+
+BENCHMARK(rescanning_deque)->Apply(window_sizes);
+BENCHMARK(monotone_queue)->Apply(window_sizes);
+BENCHMARK(minimiser_hash)->Apply(window_sizes);
+
+BENCHMARK_MAIN();